@@ -0,0 +1,141 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "interface/include/tecoal.h"
+
+namespace tecoal {
+namespace bench {
+
+// One problem of a sweep: the op and its key=value parameters after list expansion, e.g.
+// op "gemm" with {m: 512, n: 4096, k: 4096, dtype: half}. The algo is kept apart so results of
+// one problem under several algos share the label.
+struct Case {
+    std::string op;
+    std::map<std::string, std::string> params;
+    std::string algo;  // empty: the default algo of the op
+
+    std::string label() const;
+    std::string get(const char *key, const char *def) const;
+    int getInt(const char *key, int def) const;
+    double getDouble(const char *key, double def) const;
+    // "32x64x56x56" -> {32, 64, 56, 56}; def when the key is absent
+    std::vector<int> getDims(const char *key, const std::vector<int> &def) const;
+};
+
+// Parses a shape list, one problem per line: an op name then key=value pairs, '#' starts a
+// comment. A value may list alternatives, "m=256,512" or the ranges "lo:hi" (doubling) and
+// "lo:hi:step"; a line expands to the cross product of its lists.
+bool parseCases(const std::string &text, const std::string &origin, std::vector<Case> *cases,
+                std::string *error);
+bool loadCases(const char *path, std::vector<Case> *cases, std::string *error);
+
+// Operand memory of the backend under test: device memory for TECOAL_BACKEND_DEVICE, host
+// memory otherwise. Everything allocated is freed with the Memory.
+class Memory {
+ public:
+    explicit Memory(tecoalBackend_t backend) : backend_(backend) {}
+    ~Memory();
+
+    // a copy of the bytes of host, which must hold size bytes
+    void *upload(const void *host, size_t size);
+    void *alloc(size_t size);
+
+ private:
+    tecoalBackend_t backend_;
+    std::vector<void *> blocks_;
+};
+
+// A problem made ready to run: descriptors built and operands filled once, so run() is only
+// the tecoal* call. bytes and flops cover ops that do not report their own cost.
+class Runner {
+ public:
+    virtual ~Runner() {}
+    virtual tecoalStatus_t run(tecoalHandle_t handle, tecoalAlgo_t algo) = 0;
+
+    uint64_t bytes = 0;
+    uint64_t flops = 0;
+};
+
+typedef Runner *(*RunnerFactory)(const Case &c, Memory *memory, std::string *error);
+
+typedef struct OpEntry {
+    const char *name;  // op of the shape list
+    const char *api;   // the tecoal* entry point it calls
+    RunnerFactory create;
+    const char *defaults;  // a small case of the built-in sweep
+    const char *algo;      // algo of the cases that name none
+} OpEntry;
+
+const std::vector<OpEntry> &opTable();
+const OpEntry *findOp(const std::string &name);
+
+// Timing of one (case, algo). Latencies are per call in microseconds: wall covers the call
+// and the stream wait, kernel is what the op statistics measured, dispatch the difference.
+struct Result {
+    std::string label;
+    std::string op;
+    std::string algo;
+    std::string status;
+    std::string kernel;
+    int iters = 0;
+    double median_us = 0;
+    double p99_us = 0;
+    double kernel_us = 0;
+    double dispatch_us = 0;
+    double gbps = 0;
+    double gflops = 0;
+    uint64_t bytes = 0;
+    uint64_t flops = 0;
+
+    std::string key() const { return label + " algo=" + algo; }
+};
+
+struct RunInfo {
+    std::string backend;
+    int threads = 0;
+    int warmup = 0;
+    int iters = 0;
+};
+
+bool writeJson(const char *path, const RunInfo &info, const std::vector<Result> &results);
+bool readJson(const char *path, std::vector<Result> *results, std::string *error);
+
+// Prints every case of both runs and returns how many regressed: slower by more than
+// threshold percent, or failing where the base run succeeded.
+int compareResults(const std::vector<Result> &base, const std::vector<Result> &current,
+                   double threshold);
+
+}  // namespace bench
+}  // namespace tecoal
+
+#endif  // BENCH_BENCH_H_
@@ -0,0 +1,192 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "bench/bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+
+namespace tecoal {
+namespace bench {
+
+std::string Case::label() const {
+    std::string text = op;
+    for (auto &param : params) text += " " + param.first + "=" + param.second;
+    return text;
+}
+
+std::string Case::get(const char *key, const char *def) const {
+    auto it = params.find(key);
+    return it == params.end() ? def : it->second;
+}
+
+int Case::getInt(const char *key, int def) const {
+    auto it = params.find(key);
+    return it == params.end() ? def : atoi(it->second.c_str());
+}
+
+double Case::getDouble(const char *key, double def) const {
+    auto it = params.find(key);
+    return it == params.end() ? def : atof(it->second.c_str());
+}
+
+std::vector<int> Case::getDims(const char *key, const std::vector<int> &def) const {
+    auto it = params.find(key);
+    if (it == params.end()) return def;
+    std::vector<int> dims;
+    const char *p = it->second.c_str();
+    while (*p) {
+        dims.push_back((int)strtol(p, const_cast<char **>(&p), 10));
+        if (*p == 'x') p++;
+    }
+    return dims;
+}
+
+static bool isNumber(const std::string &text) {
+    char *end = nullptr;
+    strtol(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0';
+}
+
+// "256,512" -> {256, 512}; "64:512" -> {64, 128, 256, 512}; "0:6:2" -> {0, 2, 4, 6}
+static bool expandValue(const std::string &value, std::vector<std::string> *out) {
+    std::stringstream items(value);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t colon = item.find(':');
+        if (colon == std::string::npos) {
+            out->push_back(item);
+            continue;
+        }
+        std::string lo = item.substr(0, colon), rest = item.substr(colon + 1), step;
+        size_t colon2 = rest.find(':');
+        if (colon2 != std::string::npos) {
+            step = rest.substr(colon2 + 1);
+            rest = rest.substr(0, colon2);
+        }
+        if (!isNumber(lo) || !isNumber(rest) || (!step.empty() && !isNumber(step))) return false;
+        long a = atol(lo.c_str()), b = atol(rest.c_str());
+        long s = step.empty() ? 0 : atol(step.c_str());
+        if (a > b || (step.empty() ? a <= 0 : s <= 0)) return false;
+        for (long v = a; v <= b; v = step.empty() ? v * 2 : v + s) {
+            out->push_back(std::to_string(v));
+        }
+    }
+    return !out->empty();
+}
+
+bool parseCases(const std::string &text, const std::string &origin, std::vector<Case> *cases,
+                std::string *error) {
+    std::stringstream lines(text);
+    std::string line;
+    for (int number = 1; std::getline(lines, line); number++) {
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.resize(hash);
+        std::stringstream tokens(line);
+        std::string op, token;
+        if (!(tokens >> op)) continue;
+
+        std::vector<std::pair<std::string, std::vector<std::string>>> lists;
+        while (tokens >> token) {
+            size_t eq = token.find('=');
+            std::vector<std::string> values;
+            if (eq == std::string::npos || !expandValue(token.substr(eq + 1), &values)) {
+                *error = origin + ":" + std::to_string(number) + ": bad parameter '" + token + "'";
+                return false;
+            }
+            lists.push_back(std::make_pair(token.substr(0, eq), values));
+        }
+
+        // odometer over the lists, the last one turning fastest
+        std::vector<size_t> pos(lists.size(), 0);
+        while (true) {
+            Case c;
+            c.op = op;
+            for (size_t i = 0; i < lists.size(); i++) {
+                if (lists[i].first == "algo") {
+                    c.algo = lists[i].second[pos[i]];
+                } else {
+                    c.params[lists[i].first] = lists[i].second[pos[i]];
+                }
+            }
+            cases->push_back(c);
+            size_t i = lists.size();
+            while (i > 0 && ++pos[i - 1] == lists[i - 1].second.size()) pos[--i] = 0;
+            if (i == 0) break;
+        }
+    }
+    return true;
+}
+
+bool loadCases(const char *path, std::vector<Case> *cases, std::string *error) {
+    std::ifstream file(path);
+    if (!file) {
+        *error = std::string("cannot read ") + path;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return parseCases(text.str(), path, cases, error);
+}
+
+Memory::~Memory() {
+    for (void *block : blocks_) {
+        if (backend_ == TECOAL_BACKEND_DEVICE) {
+            sdaaFree(block);
+        } else {
+            free(block);
+        }
+    }
+}
+
+void *Memory::alloc(size_t size) {
+    void *block = nullptr;
+    size = size == 0 ? 64 : size;
+    if (backend_ == TECOAL_BACKEND_DEVICE) {
+        if (sdaaMalloc(&block, size) != sdaaSuccess) return nullptr;
+        sdaaMemset(block, 0, size);
+    } else {
+        if (posix_memalign(&block, 64, size) != 0) return nullptr;
+        memset(block, 0, size);
+    }
+    blocks_.push_back(block);
+    return block;
+}
+
+void *Memory::upload(const void *host, size_t size) {
+    void *block = alloc(size);
+    if (block == nullptr || size == 0) return block;
+    if (backend_ == TECOAL_BACKEND_DEVICE) {
+        sdaaMemcpy(block, host, size, sdaaMemcpyHostToDevice);
+    } else {
+        memcpy(block, host, size);
+    }
+    return block;
+}
+
+}  // namespace bench
+}  // namespace tecoal
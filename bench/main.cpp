@@ -0,0 +1,327 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "bench/bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+using tecoal::bench::Case;
+using tecoal::bench::Memory;
+using tecoal::bench::OpEntry;
+using tecoal::bench::Result;
+using tecoal::bench::Runner;
+
+static void usage() {
+    printf(
+        "usage: tecoal-bench [options] [case ...]\n"
+        "       tecoal-bench --compare BASE.json NEW.json [--threshold PCT]\n"
+        "\n"
+        "A case is a shape-list line, e.g. \"gemm m=512:4096 n=4096 k=4096 algo=best,0\".\n"
+        "Without cases or --shapes every op runs its built-in default. A case without algo\n"
+        "runs best for gemm, gemm_grouped and conv_forward and 0 for the other ops.\n"
+        "\n"
+        "  --backend host|device   backend under test (default host)\n"
+        "  --threads N             host threads of the handle\n"
+        "  --shapes FILE           run the cases of a shape list, repeatable\n"
+        "  --op NAME               only cases of op NAME, repeatable\n"
+        "  --algo LIST             algos to run, e.g. best,0,3, overriding the cases\n"
+        "  --warmup N              untimed calls per case (default 3)\n"
+        "  --iters N               timed calls per case (default 20)\n"
+        "  --json FILE             write the results as JSON\n"
+        "  --list                  list the ops and their parameters' defaults\n");
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[std::min(i, v.size() - 1)];
+}
+
+static std::vector<std::string> split(const std::string &s, char sep) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(sep, start);
+        if (end == std::string::npos) end = s.size();
+        if (end > start) parts.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return parts;
+}
+
+// Summed counters of every kernel launched since the last reset.
+struct KernelTotals {
+    double ms = 0;
+    uint64_t bytes = 0;
+    uint64_t flops = 0;
+    std::string kernel;
+};
+
+static KernelTotals collectStats(tecoalHandle_t handle) {
+    KernelTotals totals;
+    tecoalOpStats_t stats[64];
+    int count = 0;
+    if (tecoalGetOpStats(handle, 64, &count, stats) != TECOAL_STATUS_SUCCESS) return totals;
+    for (int i = 0; i < count; i++) {
+        totals.ms += stats[i].totalTimeMs;
+        totals.bytes += stats[i].bytesRead + stats[i].bytesWritten;
+        totals.flops += stats[i].flops;
+        if (!totals.kernel.empty()) totals.kernel += "+";
+        totals.kernel += stats[i].kernelName;
+    }
+    return totals;
+}
+
+static Result runCase(tecoalHandle_t handle, sdaaStream_t stream, bool device, Runner *runner,
+                      tecoalAlgo_t algo, int warmup, int iters) {
+    Result result;
+    tecoalStatus_t status = TECOAL_STATUS_SUCCESS;
+    for (int i = 0; i < warmup && status == TECOAL_STATUS_SUCCESS; i++) {
+        status = runner->run(handle, algo);
+    }
+    if (device) sdaaStreamSynchronize(stream);
+
+    std::vector<double> wall_us, kernel_us, dispatch_us;
+    KernelTotals last;
+    for (int i = 0; i < iters && status == TECOAL_STATUS_SUCCESS; i++) {
+        tecoalResetOpStats(handle);
+        auto t0 = std::chrono::steady_clock::now();
+        status = runner->run(handle, algo);
+        if (device) sdaaStreamSynchronize(stream);
+        auto t1 = std::chrono::steady_clock::now();
+        last = collectStats(handle);
+        double wall = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        wall_us.push_back(wall);
+        kernel_us.push_back(last.ms * 1000);
+        dispatch_us.push_back(std::max(0.0, wall - last.ms * 1000));
+    }
+    if (status != TECOAL_STATUS_SUCCESS) {
+        result.status = tecoalGetErrorString(status);
+        return result;
+    }
+    result.status = "success";
+
+    result.iters = iters;
+    result.kernel = last.kernel;
+    result.median_us = percentile(wall_us, 0.5);
+    result.p99_us = percentile(wall_us, 0.99);
+    result.kernel_us = percentile(kernel_us, 0.5);
+    result.dispatch_us = percentile(dispatch_us, 0.5);
+    // ops without a cost model report zero; fall back to what the runner counted
+    result.bytes = last.bytes ? last.bytes : runner->bytes;
+    result.flops = last.flops ? last.flops : runner->flops;
+    double us = result.kernel_us > 0 ? result.kernel_us : result.median_us;
+    if (us > 0) {
+        result.gbps = result.bytes / us / 1e3;
+        result.gflops = result.flops / us / 1e3;
+    }
+    return result;
+}
+
+static bool parseAlgo(const std::string &name, tecoalAlgo_t *algo) {
+    if (name == "best") {
+        *algo = TECOAL_ALGO_BEST;
+        return true;
+    }
+    char *end = nullptr;
+    long value = strtol(name.c_str(), &end, 10);
+    if (name.empty() || *end != '\0' || value < 0) return false;
+    *algo = (tecoalAlgo_t)value;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::string backend_name = "host", json_path;
+    std::vector<std::string> shape_files, op_filter, inline_cases, algo_override;
+    int threads = -1, warmup = 3, iters = 20;
+    double threshold = 5;
+    const char *compare_base = nullptr, *compare_new = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (arg == "--list") {
+            for (auto &entry : tecoal::bench::opTable()) {
+                printf("%-20s %-28s %-6s %s\n", entry.name, entry.api, entry.algo, entry.defaults);
+            }
+            return 0;
+        } else if (arg == "--compare" && i + 2 < argc) {
+            compare_base = argv[++i];
+            compare_new = argv[++i];
+        } else if (!has_value && arg.compare(0, 2, "--") == 0) {
+            fprintf(stderr, "%s needs a value\n", arg.c_str());
+            return 2;
+        } else if (arg == "--backend") {
+            backend_name = argv[++i];
+        } else if (arg == "--threads") {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--shapes") {
+            shape_files.push_back(argv[++i]);
+        } else if (arg == "--op") {
+            op_filter.push_back(argv[++i]);
+        } else if (arg == "--algo") {
+            algo_override = split(argv[++i], ',');
+        } else if (arg == "--warmup") {
+            warmup = atoi(argv[++i]);
+        } else if (arg == "--iters") {
+            iters = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--json") {
+            json_path = argv[++i];
+        } else if (arg == "--threshold") {
+            threshold = atof(argv[++i]);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            fprintf(stderr, "unknown option %s\n", arg.c_str());
+            usage();
+            return 2;
+        } else {
+            inline_cases.push_back(arg);
+        }
+    }
+
+    std::string error;
+    if (compare_base != nullptr) {
+        std::vector<Result> base, current;
+        if (!tecoal::bench::readJson(compare_base, &base, &error) ||
+            !tecoal::bench::readJson(compare_new, &current, &error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+        return tecoal::bench::compareResults(base, current, threshold) > 0 ? 1 : 0;
+    }
+
+    if (backend_name != "host" && backend_name != "device") {
+        fprintf(stderr, "backend is host or device\n");
+        return 2;
+    }
+    const bool device = backend_name == "device";
+
+    std::vector<Case> cases;
+    for (auto &path : shape_files) {
+        if (!tecoal::bench::loadCases(path.c_str(), &cases, &error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+    }
+    for (auto &text : inline_cases) {
+        if (!tecoal::bench::parseCases(text, "argument", &cases, &error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+    }
+    if (cases.empty()) {
+        for (auto &entry : tecoal::bench::opTable()) {
+            std::string line = std::string(entry.name) + " " + entry.defaults;
+            tecoal::bench::parseCases(line, "defaults", &cases, &error);
+        }
+    }
+    if (!op_filter.empty()) {
+        cases.erase(std::remove_if(cases.begin(), cases.end(),
+                                   [&](const Case &c) {
+                                       return std::find(op_filter.begin(), op_filter.end(),
+                                                        c.op) == op_filter.end();
+                                   }),
+                    cases.end());
+    }
+
+    tecoalHandle_t handle;
+    if (tecoalCreate(&handle) != TECOAL_STATUS_SUCCESS) {
+        fprintf(stderr, "tecoalCreate failed\n");
+        return 2;
+    }
+    const tecoalBackend_t backend = device ? TECOAL_BACKEND_DEVICE : TECOAL_BACKEND_CPU;
+    tecoalSetBackend(handle, backend);
+    if (threads >= 0) tecoalSetHostThreads(handle, threads, nullptr, 0);
+    sdaaStream_t stream;
+    tecoalGetStream(handle, &stream);
+    // kernel time comes from the op statistics, which also make every kernel synchronous
+    tecoalSetOpStats(true);
+
+    printf("%-60s %-5s %10s %10s %10s %10s %9s %9s  %s\n", "case", "algo", "median us", "p99 us",
+           "kernel us", "dispatch", "GB/s", "GFLOP/s", "kernel");
+    std::vector<Result> results;
+    for (auto &c : cases) {
+        const OpEntry *entry = tecoal::bench::findOp(c.op);
+        Memory memory(backend);
+        std::unique_ptr<Runner> runner;
+        if (entry == nullptr) {
+            error = "unknown op " + c.op;
+        } else {
+            runner.reset(entry->create(c, &memory, &error));
+        }
+        std::string case_algo = !c.algo.empty() ? c.algo : entry ? entry->algo : "0";
+        std::vector<std::string> algos = algo_override.empty()
+                                             ? std::vector<std::string>{case_algo}
+                                             : algo_override;
+        for (auto &algo_name : algos) {
+            Result result;
+            tecoalAlgo_t algo;
+            if (!runner) {
+                result.status = error;
+            } else if (!parseAlgo(algo_name, &algo)) {
+                result.status = "bad algo";
+            } else {
+                result = runCase(handle, stream, device, runner.get(), algo, warmup, iters);
+            }
+            result.label = c.label();
+            result.op = c.op;
+            result.algo = algo_name;
+            if (result.status != "success") {
+                printf("%-60s %-5s %s\n", result.label.c_str(), algo_name.c_str(),
+                       result.status.c_str());
+            } else {
+                printf("%-60s %-5s %10.2f %10.2f %10.2f %10.2f %9.2f %9.2f  %s\n",
+                       result.label.c_str(), algo_name.c_str(), result.median_us, result.p99_us,
+                       result.kernel_us, result.dispatch_us, result.gbps, result.gflops,
+                       result.kernel.c_str());
+            }
+            fflush(stdout);
+            results.push_back(result);
+        }
+    }
+    tecoalSetOpStats(false);
+    tecoalDestroy(handle);
+
+    if (!json_path.empty()) {
+        tecoal::bench::RunInfo info;
+        info.backend = backend_name;
+        info.threads = threads;
+        info.warmup = warmup;
+        info.iters = iters;
+        if (!tecoal::bench::writeJson(json_path.c_str(), info, results)) {
+            fprintf(stderr, "cannot write %s\n", json_path.c_str());
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,718 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "bench/bench.h"
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+#include <random>
+
+namespace tecoal {
+namespace bench {
+
+static bool parseDataType(const std::string &name, tecoalDataType_t *type) {
+    static const struct {
+        const char *name;
+        tecoalDataType_t type;
+    } types[] = {{"float", TECOAL_DATA_FLOAT},  {"half", TECOAL_DATA_HALF},
+                 {"bfloat16", TECOAL_DATA_BFLOAT16}, {"int32", TECOAL_DATA_INT32},
+                 {"int64", TECOAL_DATA_INT64},  {"double", TECOAL_DATA_DOUBLE},
+                 {"bool", TECOAL_DATA_BOOL}};
+    for (auto &entry : types) {
+        if (name == entry.name) {
+            *type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t dataTypeSize(tecoalDataType_t type) {
+    switch (type) {
+        case TECOAL_DATA_HALF:
+        case TECOAL_DATA_BFLOAT16: return 2;
+        case TECOAL_DATA_INT64:
+        case TECOAL_DATA_DOUBLE: return 8;
+        case TECOAL_DATA_BOOL:
+        case TECOAL_DATA_UINT8:
+        case TECOAL_DATA_INT8: return 1;
+        default: return 4;
+    }
+}
+
+static size_t elemCount(const std::vector<int> &dims) {
+    size_t count = 1;
+    for (int dim : dims) count *= dim;
+    return count;
+}
+
+// Host data of count elements drawn uniformly from [lo, hi], integers for integer types.
+// Every run of the bench sees the same values.
+static std::vector<uint8_t> randomData(tecoalDataType_t type, size_t count, double lo, double hi) {
+    static std::mt19937_64 engine(20240601);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<uint8_t> data(count * dataTypeSize(type));
+    if (type == TECOAL_DATA_HALF || type == TECOAL_DATA_BFLOAT16) {
+        std::vector<float> values(count);
+        for (float &v : values) v = (float)dist(engine);
+        if (type == TECOAL_DATA_HALF) {
+            half_float::convert(values.data(), (half_float::half *)data.data(), count);
+        } else {
+            ual::common::convert(values.data(), (ual::common::bfloat16 *)data.data(), count);
+        }
+        return data;
+    }
+    for (size_t i = 0; i < count; i++) {
+        double v = dist(engine);
+        switch (type) {
+            case TECOAL_DATA_FLOAT: ((float *)data.data())[i] = (float)v; break;
+            case TECOAL_DATA_DOUBLE: ((double *)data.data())[i] = v; break;
+            case TECOAL_DATA_INT32: ((int32_t *)data.data())[i] = (int32_t)v; break;
+            case TECOAL_DATA_INT64: ((int64_t *)data.data())[i] = (int64_t)v; break;
+            default: data[i] = v >= 0.5; break;
+        }
+    }
+    return data;
+}
+
+// Owns the descriptors of one problem; call is the tecoal* call with every operand bound.
+class CallRunner : public Runner {
+ public:
+    CallRunner(Memory *memory) : memory_(memory) {}
+    ~CallRunner() {
+        for (auto desc : tensors_) tecoalDestroyTensorDescriptor(desc);
+        for (auto desc : filters_) tecoalDestroyFilterDescriptor(desc);
+        for (auto desc : convs_) tecoalDestroyConvolutionDescriptor(desc);
+        for (auto desc : activations_) tecoalDestroyActivationDescriptor(desc);
+    }
+
+    tecoalStatus_t run(tecoalHandle_t handle, tecoalAlgo_t algo) override {
+        return call(handle, algo);
+    }
+
+    tecoalTensorDescriptor_t tensor(tecoalDataType_t type, const std::vector<int> &dims) {
+        std::vector<int> strides(dims.size(), 1);
+        for (int i = (int)dims.size() - 2; i >= 0; i--) strides[i] = strides[i + 1] * dims[i + 1];
+        tecoalTensorDescriptor_t desc;
+        tecoalCreateTensorDescriptor(&desc);
+        tecoalSetTensorNdDescriptor(desc, type, (int)dims.size(), dims.data(), strides.data());
+        tensors_.push_back(desc);
+        return desc;
+    }
+
+    tecoalTensorDescriptor_t tensor4d(tecoalDataType_t type, int n, int c, int h, int w) {
+        tecoalTensorDescriptor_t desc;
+        tecoalCreateTensorDescriptor(&desc);
+        tecoalSetTensor4dDescriptor(desc, TECOAL_TENSOR_NHWC, type, n, c, h, w);
+        tensors_.push_back(desc);
+        return desc;
+    }
+
+    tecoalFilterDescriptor_t filter(tecoalDataType_t type, int k, int c, int r, int s) {
+        tecoalFilterDescriptor_t desc;
+        tecoalCreateFilterDescriptor(&desc);
+        tecoalSetFilter4dDescriptor(desc, type, TECOAL_TENSOR_NHWC, k, c, r, s);
+        filters_.push_back(desc);
+        return desc;
+    }
+
+    tecoalConvolutionDescriptor_t convolution(int pad, int stride, int dilation,
+                                              tecoalDataType_t type) {
+        tecoalConvolutionDescriptor_t desc;
+        tecoalCreateConvolutionDescriptor(&desc);
+        tecoalSetConvolution2dDescriptor(desc, pad, pad, stride, stride, dilation, dilation,
+                                         TECOAL_CROSS_CORRELATION, type);
+        convs_.push_back(desc);
+        return desc;
+    }
+
+    tecoalActivationDescriptor_t activation(tecoalActivationMode_t mode) {
+        tecoalActivationDescriptor_t desc;
+        tecoalCreateActivationDescriptor(&desc);
+        tecoalSetActivationDescriptor(desc, mode, TECOAL_NOT_PROPAGATE_NAN, 0.0);
+        activations_.push_back(desc);
+        return desc;
+    }
+
+    // random operand, counted in bytes
+    void *input(tecoalDataType_t type, size_t count, double lo, double hi) {
+        bytes += count * dataTypeSize(type);
+        std::vector<uint8_t> data = randomData(type, count, lo, hi);
+        return memory_->upload(data.data(), data.size());
+    }
+
+    // entry i at base + i * step bytes, uploaded as a pointer array
+    const void *pointerArray(const void *base, size_t step, int count) {
+        std::vector<const void *> ptrs(count);
+        for (int i = 0; i < count; i++) ptrs[i] = (const char *)base + i * step;
+        return pointerArray(ptrs);
+    }
+
+    const void *pointerArray(const std::vector<const void *> &ptrs) {
+        return memory_->upload(ptrs.data(), ptrs.size() * sizeof(ptrs[0]));
+    }
+
+    void *output(tecoalDataType_t type, size_t count) {
+        bytes += count * dataTypeSize(type);
+        return memory_->alloc(count * dataTypeSize(type));
+    }
+
+    std::function<tecoalStatus_t(tecoalHandle_t, tecoalAlgo_t)> call;
+
+ private:
+    Memory *memory_;
+    std::vector<tecoalTensorDescriptor_t> tensors_;
+    std::vector<tecoalFilterDescriptor_t> filters_;
+    std::vector<tecoalConvolutionDescriptor_t> convs_;
+    std::vector<tecoalActivationDescriptor_t> activations_;
+};
+
+// dtype of the case, def when absent; false with an error for unknown names or a type the
+// op does not take
+static bool caseType(const Case &c, const char *def, const std::vector<tecoalDataType_t> &allowed,
+                     tecoalDataType_t *type, std::string *error, const char *key = "dtype") {
+    std::string name = c.get(key, def);
+    if (!parseDataType(name, type)) {
+        *error = std::string("unknown ") + key + " " + name;
+        return false;
+    }
+    for (auto t : allowed) {
+        if (t == *type) return true;
+    }
+    *error = c.op + " does not take " + key + " " + name;
+    return false;
+}
+
+static Runner *createGemm(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type, ctype;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_BFLOAT16, TECOAL_DATA_FLOAT}, &type,
+                  error)) {
+        return nullptr;
+    }
+    // a ctype other than dtype, or float dtype, runs tecoalGemmEx
+    if (!caseType(c, c.get("dtype", "half").c_str(), {type, TECOAL_DATA_FLOAT}, &ctype, error,
+                  "ctype")) {
+        return nullptr;
+    }
+    const bool ex = ctype != type || type == TECOAL_DATA_FLOAT;
+    const int m = c.getInt("m", 256), n = c.getInt("n", 256), k = c.getInt("k", 256);
+    const tecoalOperation_t ta = c.get("transa", "n") == "t" ? TECOAL_OP_T : TECOAL_OP_N;
+    const tecoalOperation_t tb = c.get("transb", "n") == "t" ? TECOAL_OP_T : TECOAL_OP_N;
+    const int lda = ta == TECOAL_OP_N ? k : m, ldb = tb == TECOAL_OP_N ? n : k, ldc = n;
+    const float alpha = (float)c.getDouble("alpha", 1), beta = (float)c.getDouble("beta", 0);
+    // batch > 1 runs tecoalHgemmStridedBatched, or tecoalHgemmBatched with batched=array
+    const int batch = c.getInt("batch", 1);
+    const bool by_array = c.get("batched", "strided") == "array";
+    if (batch < 1 || (batch > 1 && (type != TECOAL_DATA_HALF || ex))) {
+        *error = "batched gemm takes half and batch >= 1";
+        return nullptr;
+    }
+
+    CallRunner *runner = new CallRunner(memory);
+    const long long sa = (long long)m * k, sb = (long long)k * n, sc = (long long)m * n;
+    const void *A = runner->input(type, sa * batch, -1, 1);
+    const void *B = runner->input(type, sb * batch, -1, 1);
+    void *C = runner->output(ctype, sc * batch);
+    runner->flops = 2ull * m * n * k * batch;
+    if (batch > 1 && by_array) {
+        const size_t size = dataTypeSize(type);
+        auto Aarray = (const void *const *)runner->pointerArray(A, sa * size, batch);
+        auto Barray = (const void *const *)runner->pointerArray(B, sb * size, batch);
+        auto Carray = (void *const *)runner->pointerArray(C, sc * size, batch);
+        runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+            return tecoalHgemmBatched(handle, ta, tb, m, n, k, alpha, Aarray, lda, Barray, ldb,
+                                      beta, Carray, ldc, batch, algo);
+        };
+        return runner;
+    }
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        if (batch > 1) {
+            return tecoalHgemmStridedBatched(handle, ta, tb, m, n, k, alpha, A, lda, sa, B, ldb,
+                                             sb, beta, C, ldc, sc, batch, algo);
+        }
+        if (ex) {
+            return tecoalGemmEx(handle, ta, tb, m, n, k, alpha, A, type, lda, B, type, ldb, beta,
+                                C, ctype, ldc, TECOAL_DATA_FLOAT, algo);
+        }
+        if (type == TECOAL_DATA_BFLOAT16) {
+            return tecoalBgemm(handle, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, algo);
+        }
+        return tecoalHgemm(handle, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, algo);
+    };
+    return runner;
+}
+
+// groups experts share tokens rows between them on a linear ramp, expert i getting about
+// i + 1 shares, so the groups differ in m the way routed tokens do
+static Runner *createGemmGrouped(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF}, &type, error)) return nullptr;
+    const int groups = c.getInt("groups", 8), tokens = c.getInt("tokens", 512);
+    const int n = c.getInt("n", 1024), k = c.getInt("k", 1024);
+    const tecoalOperation_t tb = c.get("transb", "n") == "t" ? TECOAL_OP_T : TECOAL_OP_N;
+    if (groups < 1 || tokens < 0) {
+        *error = "gemm_grouped takes groups >= 1 and tokens >= 0";
+        return nullptr;
+    }
+
+    std::vector<int> m(groups), ns(groups, n), ks(groups, k), lda(groups, k), ldc(groups, n);
+    std::vector<int> ldb(groups, tb == TECOAL_OP_N ? n : k);
+    long long rows = 0;
+    for (int g = 0; g < groups; g++) {
+        m[g] = (int)((long long)tokens * 2 * (g + 1) / ((long long)groups * (groups + 1)));
+        rows += m[g];
+    }
+
+    CallRunner *runner = new CallRunner(memory);
+    const size_t size = dataTypeSize(type);
+    const char *A = (const char *)runner->input(type, rows * k, -1, 1);
+    const char *B = (const char *)runner->input(type, (size_t)groups * k * n, -1, 1);
+    char *C = (char *)runner->output(type, rows * n);
+    std::vector<const void *> a(groups), b(groups), cs(groups);
+    long long row = 0;
+    for (int g = 0; g < groups; g++) {
+        a[g] = A + row * k * size;
+        b[g] = B + (size_t)g * k * n * size;
+        cs[g] = C + row * n * size;
+        row += m[g];
+    }
+    runner->flops = 2ull * rows * n * k;
+    auto Aarray = (const void *const *)runner->pointerArray(a);
+    auto Barray = (const void *const *)runner->pointerArray(b);
+    auto Carray = (void *const *)runner->pointerArray(cs);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalHgemmGrouped(handle, TECOAL_OP_N, tb, groups, m.data(), ns.data(), ks.data(),
+                                  1.0f, Aarray, lda.data(), Barray, ldb.data(), 0.0f, Carray,
+                                  ldc.data(), algo);
+    };
+    return runner;
+}
+
+static Runner *createConvForward(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF}, &type, error)) return nullptr;
+    const int N = c.getInt("n", 1), C = c.getInt("c", 64), H = c.getInt("h", 56),
+              W = c.getInt("w", 56), K = c.getInt("k", 64), R = c.getInt("r", 1),
+              S = c.getInt("s", R), pad = c.getInt("pad", 0), stride = c.getInt("stride", 1),
+              dilation = c.getInt("dilation", 1);
+    const int E = (H + 2 * pad - dilation * (R - 1) - 1) / stride + 1;
+    const int F = (W + 2 * pad - dilation * (S - 1) - 1) / stride + 1;
+    if (E <= 0 || F <= 0) {
+        *error = "empty convolution output";
+        return nullptr;
+    }
+
+    CallRunner *runner = new CallRunner(memory);
+    auto xDesc = runner->tensor4d(type, N, C, H, W);
+    auto wDesc = runner->filter(type, K, C, R, S);
+    auto yDesc = runner->tensor4d(type, N, K, E, F);
+    auto convDesc = runner->convolution(pad, stride, dilation, type);
+    const void *x = runner->input(type, (size_t)N * C * H * W, -1, 1);
+    const void *w = runner->input(type, (size_t)K * C * R * S, -1, 1);
+    void *y = runner->output(type, (size_t)N * K * E * F);
+    runner->flops = 2ull * N * K * E * F * C * R * S;
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        size_t size = 0;
+        tecoalStatus_t status = tecoalGetConvolutionForwardWorkspaceSize(handle, xDesc, wDesc,
+                                                                         convDesc, yDesc, algo,
+                                                                         &size);
+        if (status != TECOAL_STATUS_SUCCESS) return status;
+        // without a workspace the op takes its temporaries from the handle's arena
+        const float alpha = 1, beta = 0;
+        return tecoalConvolutionForward(handle, &alpha, xDesc, x, wDesc, w, convDesc, algo,
+                                        nullptr, 0, &beta, yDesc, y);
+    };
+    return runner;
+}
+
+static const std::vector<int> default_shape = {1024, 1024};
+
+static Runner *createAddTensor(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_BFLOAT16, TECOAL_DATA_FLOAT}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    std::vector<int> a_shape = c.getDims("a", shape);  // broadcast to shape
+
+    CallRunner *runner = new CallRunner(memory);
+    auto aDesc = runner->tensor(type, a_shape), cDesc = runner->tensor(type, shape);
+    const void *A = runner->input(type, elemCount(a_shape), -1, 1);
+    void *C = runner->input(type, elemCount(shape), -1, 1);
+    runner->bytes += elemCount(shape) * dataTypeSize(type);  // C is read and written
+    runner->flops = 3 * elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        const float alpha = 1, beta = 1;
+        return tecoalAddTensor(handle, &alpha, aDesc, A, &beta, cDesc, C, algo);
+    };
+    return runner;
+}
+
+static Runner *createScaleTensor(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float", {TECOAL_DATA_FLOAT, TECOAL_DATA_BFLOAT16, TECOAL_DATA_HALF}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto yDesc = runner->tensor(type, shape);
+    void *y = runner->input(type, elemCount(shape), -1, 1);
+    runner->bytes *= 2;
+    runner->flops = elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        const float alpha = 1;  // keeps the values stable over the iterations
+        return tecoalScaleTensor(handle, yDesc, y, &alpha, algo);
+    };
+    return runner;
+}
+
+static Runner *createUnaryOps(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float", {TECOAL_DATA_FLOAT, TECOAL_DATA_INT32}, &type, error)) {
+        return nullptr;
+    }
+    std::string mode_name = c.get("mode", "add");
+    if (mode_name != "add" && mode_name != "mul") {
+        *error = "unary_ops mode is add or mul";
+        return nullptr;
+    }
+    const tecoalUnaryOpsMode_t mode = mode_name == "add" ? TECOAL_BATCH_ADD_A : TECOAL_BATCH_MUL_A;
+    std::vector<int> shape = c.getDims("shape", default_shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto xDesc = runner->tensor(type, shape), yDesc = runner->tensor(type, shape);
+    const void *x = runner->input(type, elemCount(shape), -100, 100);
+    void *y = runner->output(type, elemCount(shape));
+    runner->flops = elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        const float alpha_f = 2;
+        const int alpha_i = 2;
+        const void *alpha = type == TECOAL_DATA_FLOAT ? (const void *)&alpha_f : &alpha_i;
+        return tecoalUnaryOps(handle, mode, alpha, xDesc, x, yDesc, y, algo);
+    };
+    return runner;
+}
+
+static Runner *createActivationForward(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_BFLOAT16, TECOAL_DATA_FLOAT}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto act = runner->activation(TECOAL_ACTIVATION_SILU);
+    auto xDesc = runner->tensor(type, shape), yDesc = runner->tensor(type, shape);
+    const void *x = runner->input(type, elemCount(shape), -4, 4);
+    void *y = runner->output(type, elemCount(shape));
+    runner->flops = 4 * elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        const float alpha = 1, beta = 0;
+        return tecoalActivationForward(handle, act, &alpha, xDesc, x, &beta, yDesc, y, algo);
+    };
+    return runner;
+}
+
+static Runner *createActivationBackward(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_BFLOAT16, TECOAL_DATA_FLOAT}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    const size_t count = elemCount(shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto act = runner->activation(TECOAL_ACTIVATION_SILU);
+    auto desc = runner->tensor(type, shape);
+    const void *y = runner->input(type, count, -4, 4);
+    const void *dy = runner->input(type, count, -1, 1);
+    const void *x = runner->input(type, count, -4, 4);
+    void *dx = runner->output(type, count);
+    runner->flops = 8 * count;
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        const float alpha = 1, beta = 0;
+        return tecoalActivationBackward(handle, act, &alpha, desc, y, desc, dy, desc, x, &beta,
+                                        desc, dx, algo);
+    };
+    return runner;
+}
+
+static Runner *createLogicalNot(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "bool", {TECOAL_DATA_BOOL}, &type, error)) return nullptr;
+    std::vector<int> shape = c.getDims("shape", default_shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto aDesc = runner->tensor(type, shape), cDesc = runner->tensor(type, shape);
+    const void *A = runner->input(type, elemCount(shape), 0, 1);
+    void *C = runner->output(type, elemCount(shape));
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalLogicalNotTensor(handle, aDesc, A, cDesc, C, algo);
+    };
+    return runner;
+}
+
+static Runner *createCastTensor(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t x_type, y_type;
+    const std::vector<tecoalDataType_t> types = {TECOAL_DATA_FLOAT, TECOAL_DATA_HALF,
+                                                 TECOAL_DATA_BFLOAT16};
+    if (!caseType(c, "float", types, &x_type, error)) return nullptr;
+    if (!caseType(c, "bfloat16", types, &y_type, error, "to")) return nullptr;
+    std::vector<int> shape = c.getDims("shape", default_shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto xDesc = runner->tensor(x_type, shape), yDesc = runner->tensor(y_type, shape);
+    const void *x = runner->input(x_type, elemCount(shape), -4, 4);
+    void *y = runner->output(y_type, elemCount(shape));
+    runner->flops = elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalCastTensor(handle, xDesc, x, yDesc, y, algo);
+    };
+    return runner;
+}
+
+static Runner *createMaskedFill(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float", {TECOAL_DATA_FLOAT, TECOAL_DATA_BFLOAT16, TECOAL_DATA_HALF}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    std::vector<int> mask_shape = c.getDims("mask", shape);  // broadcast to shape
+
+    CallRunner *runner = new CallRunner(memory);
+    auto inDesc = runner->tensor(type, shape), outDesc = runner->tensor(type, shape);
+    auto maskDesc = runner->tensor(TECOAL_DATA_BOOL, mask_shape);
+    const void *input = runner->input(type, elemCount(shape), -1, 1);
+    const void *mask = runner->input(TECOAL_DATA_BOOL, elemCount(mask_shape), 0, 1);
+    void *output = runner->output(type, elemCount(shape));
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalMaskedFill(handle, 0.5f, inDesc, input, maskDesc, mask, outDesc, output,
+                                algo);
+    };
+    return runner;
+}
+
+static Runner *createMaskedSelect(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float", {TECOAL_DATA_FLOAT, TECOAL_DATA_INT32, TECOAL_DATA_HALF}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    const int count = (int)elemCount(shape);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto inDesc = runner->tensor(type, shape), maskDesc = runner->tensor(TECOAL_DATA_BOOL, shape);
+    auto outDesc = runner->tensor(type, {count});
+    const void *input = runner->input(type, count, -1, 1);
+    const void *mask = runner->input(TECOAL_DATA_BOOL, count, 0, 1);
+    void *out = runner->output(type, count);  // room for a mask of all ones, as outDesc
+    void *selected = memory->alloc(sizeof(int64_t));
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalMaskedSelect(handle, inDesc, input, maskDesc, mask, outDesc, out, selected,
+                                  algo);
+    };
+    return runner;
+}
+
+static Runner *createArgmax(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_BFLOAT16, TECOAL_DATA_FLOAT}, &type,
+                  error)) {
+        return nullptr;
+    }
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    const int axis = c.getInt("axis", (int)shape.size() - 1);
+    if (axis < 0 || axis >= (int)shape.size()) {
+        *error = "axis out of range";
+        return nullptr;
+    }
+    std::vector<int> y_shape = shape;
+    y_shape[axis] = 1;
+
+    CallRunner *runner = new CallRunner(memory);
+    auto xDesc = runner->tensor(type, shape), yDesc = runner->tensor(TECOAL_DATA_INT64, y_shape);
+    const void *x = runner->input(type, elemCount(shape), -1, 1);
+    void *y = runner->output(TECOAL_DATA_INT64, elemCount(y_shape));
+    runner->flops = elemCount(shape);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalArgmax(handle, axis, xDesc, x, yDesc, y, algo);
+    };
+    return runner;
+}
+
+static Runner *createUnique(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "int64", {TECOAL_DATA_INT64}, &type, error)) return nullptr;
+    const int len = c.getInt("len", 1 << 16);
+    const int range = c.getInt("range", len / 16 > 0 ? len / 16 : 1);  // distinct values
+
+    CallRunner *runner = new CallRunner(memory);
+    auto desc = runner->tensor(type, {len});
+    const void *input = runner->input(type, len, 0, range);
+    void *output = runner->output(type, len);
+    void *inverse = runner->output(type, len);
+    void *counts = runner->output(type, len);
+    void *size = memory->alloc(sizeof(int64_t));
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalUnique(handle, TECOAL_UNIQUE_NONE, 0, true, true, true, desc, input, desc,
+                            output, desc, inverse, desc, counts, size, algo);
+    };
+    return runner;
+}
+
+static Runner *createScatterOut(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float", {TECOAL_DATA_FLOAT, TECOAL_DATA_HALF}, &type, error)) return nullptr;
+    std::vector<int> shape = c.getDims("shape", default_shape);
+    const int axis = c.getInt("axis", 0);
+    if (axis < 0 || axis >= (int)shape.size()) {
+        *error = "axis out of range";
+        return nullptr;
+    }
+    std::vector<int> index_shape = shape;
+    index_shape[axis] = (shape[axis] + 1) / 2;
+    index_shape = c.getDims("index", index_shape);
+    std::string reduce_name = c.get("reduce", "add");
+    const tecoalScatterOutReductionMode_t reduce =
+        reduce_name == "none" ? TECOAL_SCATTEROUT_REDUCTION_NONE :
+        reduce_name == "mul" ? TECOAL_SCATTEROUT_REDUCTION_MULTIPLY :
+                               TECOAL_SCATTEROUT_REDUCTION_ADD;
+
+    CallRunner *runner = new CallRunner(memory);
+    auto srcDesc = runner->tensor(type, index_shape);
+    auto indexDesc = runner->tensor(TECOAL_DATA_INT64, index_shape);
+    auto outDesc = runner->tensor(type, shape);
+    const void *src = runner->input(type, elemCount(index_shape), -1, 1);
+    const void *index = runner->input(TECOAL_DATA_INT64, elemCount(index_shape), 0,
+                                      shape[axis] - 0.5);
+    void *out = runner->output(type, elemCount(shape));
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalScatterOut(handle, axis, 1.0f, TECOAL_SCATTEROUT_INPUT_ARRAY, reduce, srcDesc,
+                                src, indexDesc, index, outDesc, out, algo);
+    };
+    return runner;
+}
+
+// output[index[i], :] += values[i, :] over a rows x cols output
+static Runner *createIndexPut(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "half", {TECOAL_DATA_HALF, TECOAL_DATA_FLOAT}, &type, error)) return nullptr;
+    const int rows = c.getInt("rows", 4096), cols = c.getInt("cols", 256);
+    const int k = c.getInt("k", rows / 4 > 0 ? rows / 4 : 1);
+    const bool accumulate = c.getInt("accumulate", 1) != 0;
+
+    CallRunner *runner = new CallRunner(memory);
+    auto indexDesc = runner->tensor(TECOAL_DATA_INT64, {k});
+    auto valuesDesc = runner->tensor(type, {k, cols});
+    auto dataDesc = runner->tensor(type, {rows, cols});
+    void *index = runner->input(TECOAL_DATA_INT64, k, 0, rows - 0.5);
+    const void *values = runner->input(type, (size_t)k * cols, -1, 1);
+    const void *input = runner->input(type, (size_t)rows * cols, -1, 1);
+    void *output = runner->output(type, (size_t)rows * cols);
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        tecoalTensorDescriptor_t indicesDesc[] = {indexDesc};
+        void *indices[] = {index};
+        return tecoalIndexPut(handle, 1, accumulate, indicesDesc, indices, valuesDesc, values,
+                              dataDesc, input, dataDesc, output, algo);
+    };
+    return runner;
+}
+
+// out = x, then out[index[i], :] += updates[i, :]: the embedding gradient pattern
+static Runner *createScatterNdAdd(const Case &c, Memory *memory, std::string *error) {
+    tecoalDataType_t type;
+    if (!caseType(c, "float",
+                  {TECOAL_DATA_FLOAT, TECOAL_DATA_HALF, TECOAL_DATA_INT32, TECOAL_DATA_DOUBLE,
+                   TECOAL_DATA_INT64},
+                  &type, error)) {
+        return nullptr;
+    }
+    const int rows = c.getInt("rows", 4096), cols = c.getInt("cols", 256);
+    const int k = c.getInt("k", rows / 4 > 0 ? rows / 4 : 1);
+
+    CallRunner *runner = new CallRunner(memory);
+    auto xDesc = runner->tensor(type, {rows, cols});
+    auto indexDesc = runner->tensor(TECOAL_DATA_INT32, {k, 1});
+    auto updatesDesc = runner->tensor(type, {k, cols});
+    const void *x = runner->input(type, (size_t)rows * cols, -1, 1);
+    const void *index = runner->input(TECOAL_DATA_INT32, k, 0, rows - 0.5);
+    const void *updates = runner->input(type, (size_t)k * cols, -1, 1);
+    void *out = runner->output(type, (size_t)rows * cols);
+    runner->flops = (uint64_t)k * cols;
+    runner->call = [=](tecoalHandle_t handle, tecoalAlgo_t algo) {
+        return tecoalScatterNdAdd(handle, xDesc, x, indexDesc, index, updatesDesc, updates, xDesc,
+                                  out, algo);
+    };
+    return runner;
+}
+
+const std::vector<OpEntry> &opTable() {
+    static const std::vector<OpEntry> table = {
+        {"gemm", "tecoalHgemm", createGemm, "m=256 n=256 k=256", "best"},
+        {"gemm_grouped", "tecoalHgemmGrouped", createGemmGrouped,
+         "groups=8 tokens=512 n=1024 k=1024", "best"},
+        {"conv_forward", "tecoalConvolutionForward", createConvForward,
+         "n=2 c=64 h=28 w=28 k=64 r=1", "best"},
+        {"add_tensor", "tecoalAddTensor", createAddTensor, "shape=256x1024", "0"},
+        {"scale_tensor", "tecoalScaleTensor", createScaleTensor, "shape=256x1024", "0"},
+        {"unary_ops", "tecoalUnaryOps", createUnaryOps, "shape=256x1024 mode=add", "0"},
+        {"activation_forward", "tecoalActivationForward", createActivationForward,
+         "shape=256x1024", "0"},
+        {"activation_backward", "tecoalActivationBackward", createActivationBackward,
+         "shape=256x1024", "0"},
+        {"logical_not", "tecoalLogicalNotTensor", createLogicalNot, "shape=256x1024", "0"},
+        {"cast_tensor", "tecoalCastTensor", createCastTensor, "shape=256x1024 to=bfloat16",
+         "0"},
+        {"masked_fill", "tecoalMaskedFill", createMaskedFill, "shape=256x1024", "0"},
+        {"masked_select", "tecoalMaskedSelect", createMaskedSelect, "shape=256x1024", "0"},
+        {"argmax", "tecoalArgmax", createArgmax, "shape=256x1024", "0"},
+        {"unique", "tecoalUnique", createUnique, "len=65536", "0"},
+        {"scatter_out", "tecoalScatterOut", createScatterOut, "shape=256x1024", "0"},
+        {"index_put", "tecoalIndexPut", createIndexPut, "rows=4096 cols=256", "0"},
+        {"scatter_nd_add", "tecoalScatterNdAdd", createScatterNdAdd, "rows=4096 cols=256",
+         "0"},
+    };
+    return table;
+}
+
+const OpEntry *findOp(const std::string &name) {
+    for (auto &entry : opTable()) {
+        if (name == entry.name) return &entry;
+    }
+    return nullptr;
+}
+
+}  // namespace bench
+}  // namespace tecoal
@@ -0,0 +1,232 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "bench/bench.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+
+namespace tecoal {
+namespace bench {
+
+static std::string quote(const std::string &s) {
+    std::string out = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') out += '\\';
+        out += ch;
+    }
+    return out + "\"";
+}
+
+bool writeJson(const char *path, const RunInfo &info, const std::vector<Result> &results) {
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return false;
+    fprintf(file, "{\n  \"backend\": %s,\n  \"threads\": %d,\n", quote(info.backend).c_str(),
+            info.threads);
+    fprintf(file, "  \"warmup\": %d,\n  \"iters\": %d,\n", info.warmup, info.iters);
+    fprintf(file, "  \"results\": [");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        fprintf(file, "%s\n    {\"label\": %s, \"op\": %s, \"algo\": %s, \"status\": %s, ",
+                i ? "," : "", quote(r.label).c_str(), quote(r.op).c_str(), quote(r.algo).c_str(),
+                quote(r.status).c_str());
+        fprintf(file, "\"kernel\": %s, \"iters\": %d, \"median_us\": %.3f, \"p99_us\": %.3f, ",
+                quote(r.kernel).c_str(), r.iters, r.median_us, r.p99_us);
+        fprintf(file, "\"kernel_us\": %.3f, \"dispatch_us\": %.3f, \"gbps\": %.3f, ", r.kernel_us,
+                r.dispatch_us, r.gbps);
+        fprintf(file, "\"gflops\": %.3f, \"bytes\": %llu, \"flops\": %llu}", r.gflops,
+                (unsigned long long)r.bytes, (unsigned long long)r.flops);
+    }
+    fprintf(file, "\n  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+// Just enough JSON for the files writeJson emits: objects, arrays, strings, numbers and
+// literals. Values are kept as text; the result objects are flattened to key -> value.
+class JsonReader {
+ public:
+    explicit JsonReader(const std::string &text) : text_(text) {}
+
+    bool readResults(std::vector<Result> *results, std::string *error) {
+        results_ = results;
+        bool ok = value(0, "") && (skip(), pos_ == text_.size());
+        if (!ok) *error = "malformed json near offset " + std::to_string(pos_);
+        return ok;
+    }
+
+ private:
+    void skip() {
+        while (pos_ < text_.size() && isspace((unsigned char)text_[pos_])) pos_++;
+    }
+
+    bool consume(char ch) {
+        skip();
+        if (pos_ >= text_.size() || text_[pos_] != ch) return false;
+        pos_++;
+        return true;
+    }
+
+    bool string(std::string *out) {
+        if (!consume('"')) return false;
+        out->clear();
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            if (text_[pos_] == '\\') pos_++;
+            if (pos_ < text_.size()) *out += text_[pos_++];
+        }
+        return consume('"');
+    }
+
+    // depth 0 is the document, 1 its members, 2 the result array, 3 the fields of a result
+    bool value(int depth, const std::string &key, std::map<std::string, std::string> *fields = 0) {
+        skip();
+        if (pos_ >= text_.size()) return false;
+        char ch = text_[pos_];
+        if (ch == '{') {
+            pos_++;
+            std::map<std::string, std::string> members;
+            if (!consume('}')) {
+                do {
+                    std::string name;
+                    if (!string(&name) || !consume(':') || !value(depth + 1, name, &members)) {
+                        return false;
+                    }
+                } while (consume(','));
+                if (!consume('}')) return false;
+            }
+            if (depth == 2 && results_) results_->push_back(toResult(members));
+            return true;
+        }
+        if (ch == '[') {
+            pos_++;
+            if (consume(']')) return true;
+            do {
+                if (!value(depth + 1, key)) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+        std::string text;
+        if (ch == '"') {
+            if (!string(&text)) return false;
+        } else {
+            size_t start = pos_;
+            while (pos_ < text_.size() && (isalnum((unsigned char)text_[pos_]) ||
+                                           strchr("+-.", text_[pos_]) != nullptr)) {
+                pos_++;
+            }
+            if (pos_ == start) return false;
+            text = text_.substr(start, pos_ - start);
+        }
+        if (fields) (*fields)[key] = text;
+        return true;
+    }
+
+    static Result toResult(std::map<std::string, std::string> &m) {
+        Result r;
+        r.label = m["label"];
+        r.op = m["op"];
+        r.algo = m["algo"];
+        r.status = m["status"];
+        r.kernel = m["kernel"];
+        r.iters = atoi(m["iters"].c_str());
+        r.median_us = atof(m["median_us"].c_str());
+        r.p99_us = atof(m["p99_us"].c_str());
+        r.kernel_us = atof(m["kernel_us"].c_str());
+        r.dispatch_us = atof(m["dispatch_us"].c_str());
+        r.gbps = atof(m["gbps"].c_str());
+        r.gflops = atof(m["gflops"].c_str());
+        r.bytes = strtoull(m["bytes"].c_str(), nullptr, 10);
+        r.flops = strtoull(m["flops"].c_str(), nullptr, 10);
+        return r;
+    }
+
+    const std::string &text_;
+    size_t pos_ = 0;
+    std::vector<Result> *results_ = nullptr;
+};
+
+bool readJson(const char *path, std::vector<Result> *results, std::string *error) {
+    std::ifstream file(path);
+    if (!file) {
+        *error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    std::string content = text.str();
+    results->clear();
+    if (!JsonReader(content).readResults(results, error)) {
+        *error = std::string(path) + ": " + *error;
+        return false;
+    }
+    return true;
+}
+
+int compareResults(const std::vector<Result> &base, const std::vector<Result> &current,
+                   double threshold) {
+    std::map<std::string, const Result *> base_by_key;
+    for (auto &r : base) base_by_key[r.key()] = &r;
+
+    int regressions = 0;
+    printf("%-60s %12s %12s %9s\n", "case", "base us", "new us", "change");
+    for (auto &r : current) {
+        auto it = base_by_key.find(r.key());
+        if (it == base_by_key.end()) {
+            printf("%-60s %12s %12.3f %9s\n", r.key().c_str(), "-", r.median_us, "new");
+            continue;
+        }
+        const Result &b = *it->second;
+        base_by_key.erase(it);
+        const char *mark = "";
+        if (r.status != "success") {
+            if (b.status == "success") {
+                regressions++;
+                mark = "  FAILED";
+            }
+            printf("%-60s %12.3f %12s %9s%s\n", r.key().c_str(), b.median_us, r.status.c_str(),
+                   "-", mark);
+            continue;
+        }
+        double change = b.median_us > 0 ? (r.median_us / b.median_us - 1) * 100 : 0;
+        if (b.status == "success" && change > threshold) {
+            regressions++;
+            mark = "  REGRESSION";
+        }
+        printf("%-60s %12.3f %12.3f %+8.1f%%%s\n", r.key().c_str(), b.median_us, r.median_us,
+               change, mark);
+    }
+    for (auto &entry : base_by_key) {
+        printf("%-60s %12.3f %12s %9s\n", entry.first.c_str(), entry.second->median_us, "-",
+               "missing");
+    }
+    printf("%d regression(s) beyond %.1f%%\n", regressions, threshold);
+    return regressions;
+}
+
+}  // namespace bench
+}  // namespace tecoal
@@ -0,0 +1,83 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_ALGO_PERF_H_
+#define INTERFACE_COMMON_ALGO_PERF_H_
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "interface/common/convert.h"
+#include "interface/include/tecoal.h"
+
+namespace tecoal {
+
+#define TECOAL_FIND_TIMING_ITERS 3
+
+// Time an op whose kernel is already selected: one warm-up launch, then the mean of
+// TECOAL_FIND_TIMING_ITERS launches, each waited on with the stream.
+template <typename OpType>
+tecoalStatus_t timeAlgo(OpType *op, const typename OpType::ArgsType *args, sdaaStream_t stream,
+                        float *time) {
+    Status status = op->run(args, stream);
+    if (status != Status::SUCCESS) return Convert::toStatus(status);
+    if (sdaaStreamSynchronize(stream) != sdaaSuccess) return TECOAL_STATUS_EXECUTION_FAILED;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TECOAL_FIND_TIMING_ITERS; i++) {
+        status = op->run(args, stream);
+        if (status != Status::SUCCESS) return Convert::toStatus(status);
+    }
+    if (sdaaStreamSynchronize(stream) != sdaaSuccess) return TECOAL_STATUS_EXECUTION_FAILED;
+    auto end = std::chrono::steady_clock::now();
+
+    *time = std::chrono::duration<float, std::milli>(end - start).count() /
+            TECOAL_FIND_TIMING_ITERS;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+// Successful algorithms fastest first, then the failed ones in algo order.
+static inline void sortAlgoPerf(std::vector<tecoalAlgoPerf_t> *perfs) {
+    std::stable_sort(perfs->begin(), perfs->end(),
+                     [](const tecoalAlgoPerf_t &a, const tecoalAlgoPerf_t &b) {
+                         bool a_ok = a.status == TECOAL_STATUS_SUCCESS;
+                         bool b_ok = b.status == TECOAL_STATUS_SUCCESS;
+                         if (a_ok != b_ok) return a_ok;
+                         return a_ok && a.time < b.time;
+                     });
+}
+
+static inline void copyAlgoPerf(const std::vector<tecoalAlgoPerf_t> &perfs,
+                                const int requestedAlgoCount, int *returnedAlgoCount,
+                                tecoalAlgoPerf_t *perfResults) {
+    int count = std::min(requestedAlgoCount, (int)perfs.size());
+    std::copy(perfs.begin(), perfs.begin() + count, perfResults);
+    *returnedAlgoCount = count;
+}
+
+}  // namespace tecoal
+
+#endif  // INTERFACE_COMMON_ALGO_PERF_H_
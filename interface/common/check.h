@@ -27,9 +27,9 @@
 #ifndef INTERFACE_COMMON_CHECK_H_
 #define INTERFACE_COMMON_CHECK_H_
 
-#include <cstdio>
 #include "interface/common/convert.h"
 #include "interface/include/tecoal.h"
+#include "ual/com/log.h"
 
 namespace tecoal {
 
@@ -37,8 +37,7 @@ namespace tecoal {
     do {                                                                                    \
         Status __status = a;                                                                \
         if (Status::SUCCESS != (__status)) {                                                \
-            fprintf(stderr, "tecoal runtime error in line %d of file %s : %s \n", __LINE__, \
-                    __FILE__, toStatusStr(__status));                                       \
+            ERROR("tecoal runtime error: %s", toStatusStr(__status));                       \
             return __status;                                                                \
         }                                                                                   \
     } while (0);
@@ -47,8 +46,7 @@ namespace tecoal {
     do {                                                                                     \
         Status __status = a;                                                                 \
         if (Status::SUCCESS != (__status)) {                                                 \
-            fprintf(stderr, "tecoual runtime error in line %d of file %s : %s \n", __LINE__, \
-                    __FILE__, Convert::toStatusStr(__status));                               \
+            ERROR("tecoual runtime error: %s", Convert::toStatusStr(__status));              \
             return Convert::toStatus(__status);                                              \
         }                                                                                    \
     } while (0);
@@ -57,7 +55,7 @@ namespace tecoal {
     do {                                                                            \
         tecoalStatus_t __errcode = status;                                          \
         if (__errcode != TECOAL_STATUS_SUCCESS) {                                   \
-            fprintf(stderr, "TECOAL Error: %s\n", tecoalGetErrorString(__errcode)); \
+            ERROR("TECOAL Error: %s", tecoalGetErrorString(__errcode));             \
             return __errcode;                                                       \
         }                                                                           \
     } while (0);
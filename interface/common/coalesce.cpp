@@ -0,0 +1,182 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include <climits>
+#include <cstring>
+#include "interface/common/coalesce.h"
+#include "ual/com/log.h"
+
+namespace tecoal {
+
+// 4d descriptors are read as n, c, h, w so that operands of different formats line up
+static inline void logicalDim(const tecoalTensorStruct *desc, int i, int *dim, int *stride) {
+    if (desc->nbDims == 4) {
+        const int dims[4] = {desc->n, desc->c, desc->h, desc->w};
+        const int strides[4] = {desc->nStride, desc->cStride, desc->hStride, desc->wStride};
+        *dim = dims[i];
+        *stride = strides[i];
+        return;
+    }
+    *dim = desc->dimA[i];
+    *stride = desc->strideA[i];
+}
+
+static inline bool sameDense(const tecoalTensorStruct *a, const tecoalTensorStruct *b) {
+    return a->isContiguous && b->isContiguous && a->format == b->format &&
+           a->nbDims == b->nbDims && memcmp(a->dimA, b->dimA, sizeof(int) * a->nbDims) == 0;
+}
+
+// Builds the coalesced view. Without broadcast every operand must have operand 0's shape;
+// with it shapes are right aligned and a size-1 (or missing) dim is read with stride 0.
+static tecoalStatus_t coalesceImpl(const tecoalTensorStruct *const *descs, int operand_num,
+                                   bool broadcast, bool keep_order, CoalescedShape *shape) {
+    if (operand_num <= 0 || operand_num > TECOAL_COALESCE_OPERAND_MAX) {
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    const tecoalTensorStruct *out = descs[0];
+    shape->operandNum = operand_num;
+
+    bool dense = true;
+    for (int k = 0; k < operand_num && dense; k++) dense = sameDense(out, descs[k]);
+    if (dense) {
+        shape->nbDims = 1;
+        shape->elemNum = out->elemNum;
+        shape->dimA[0] = (int)out->elemNum;
+        for (int k = 0; k < operand_num; k++) shape->strideA[k][0] = 1;
+        return TECOAL_STATUS_SUCCESS;
+    }
+
+    int full_rank = out->nbDims;
+    for (int k = 1; k < operand_num; k++) {
+        if (descs[k]->nbDims > full_rank) full_rank = descs[k]->nbDims;
+        if (!broadcast && descs[k]->nbDims != out->nbDims) {
+            ERROR("coalesceDims operand %d has %d dims, output has %d\n", k, descs[k]->nbDims,
+                  out->nbDims);
+            return TECOAL_STATUS_BAD_PARAM;
+        }
+    }
+
+    int rank = 0;
+    int dims[TECOAL_DIM_MAX];
+    int strides[TECOAL_COALESCE_OPERAND_MAX][TECOAL_DIM_MAX];
+    shape->elemNum = 1;
+    for (int i = 0; i < full_rank; i++) {
+        int dim = 1;
+        int dim_k[TECOAL_COALESCE_OPERAND_MAX];
+        int stride_k[TECOAL_COALESCE_OPERAND_MAX];
+        for (int k = 0; k < operand_num; k++) {
+            int idx = i - (full_rank - descs[k]->nbDims);
+            if (idx < 0) {
+                dim_k[k] = 1;
+                stride_k[k] = 0;
+            } else {
+                logicalDim(descs[k], idx, &dim_k[k], &stride_k[k]);
+            }
+            if (dim_k[k] == 1) continue;
+            if (dim != 1 && dim_k[k] != dim) {
+                ERROR("coalesceDims operand %d dim %d is %d, expected %d\n", k, i, dim_k[k], dim);
+                return TECOAL_STATUS_BAD_PARAM;
+            }
+            dim = dim_k[k];
+        }
+        for (int k = 0; k < operand_num; k++) {
+            if (dim_k[k] == dim) continue;
+            if (!broadcast) {
+                ERROR("coalesceDims operand %d dim %d is %d, output has %d\n", k, i, dim_k[k],
+                      dim_k[0]);
+                return TECOAL_STATUS_BAD_PARAM;
+            }
+            stride_k[k] = 0;
+        }
+        shape->elemNum *= dim;
+        if (dim == 1) continue;
+        if (rank == TECOAL_DIM_MAX) return TECOAL_STATUS_NOT_SUPPORTED;
+        dims[rank] = dim;
+        for (int k = 0; k < operand_num; k++) strides[k][rank] = stride_k[k];
+        rank++;
+    }
+
+    // order dims by the output's strides, outermost first; ties go to the other operands
+    for (int i = 1; i < rank && !keep_order; i++) {
+        for (int j = i; j > 0; j--) {
+            int k = 0;
+            while (k < operand_num - 1 && strides[k][j - 1] == strides[k][j]) k++;
+            if (strides[k][j - 1] >= strides[k][j]) break;
+            int t = dims[j];
+            dims[j] = dims[j - 1];
+            dims[j - 1] = t;
+            for (k = 0; k < operand_num; k++) {
+                t = strides[k][j];
+                strides[k][j] = strides[k][j - 1];
+                strides[k][j - 1] = t;
+            }
+        }
+    }
+
+    shape->nbDims = 0;
+    for (int i = 0; i < rank; i++) {
+        int last = shape->nbDims - 1;
+        bool merge = last >= 0 && (int64_t)shape->dimA[last] * dims[i] <= INT_MAX;
+        for (int k = 0; k < operand_num && merge; k++) {
+            merge = (int64_t)dims[i] * strides[k][i] == shape->strideA[k][last];
+        }
+        if (merge) {
+            shape->dimA[last] *= dims[i];
+            for (int k = 0; k < operand_num; k++) shape->strideA[k][last] = strides[k][i];
+            continue;
+        }
+        shape->dimA[shape->nbDims] = dims[i];
+        for (int k = 0; k < operand_num; k++) shape->strideA[k][shape->nbDims] = strides[k][i];
+        shape->nbDims++;
+    }
+    if (shape->nbDims == 0) {
+        shape->nbDims = 1;
+        shape->dimA[0] = 1;
+        for (int k = 0; k < operand_num; k++) shape->strideA[k][0] = 1;
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t coalesceDims(const tecoalTensorStruct *const *descs, int operand_num,
+                            CoalescedShape *shape) {
+    return coalesceImpl(descs, operand_num, false, false, shape);
+}
+
+tecoalStatus_t broadcastDims(const tecoalTensorStruct *const *descs, int operand_num,
+                             bool keep_order, CoalescedShape *shape) {
+    return coalesceImpl(descs, operand_num, true, keep_order, shape);
+}
+
+void CoalescedShape::toPlan(BroadcastPlan *plan) const {
+    plan->nb_dims = nbDims;
+    plan->operand_num = operandNum;
+    for (int i = 0; i < nbDims; i++) {
+        plan->dims[i] = dimA[i];
+        for (int k = 0; k < operandNum; k++) plan->strides[k][i] = strideA[k][i];
+    }
+}
+
+}  // namespace tecoal
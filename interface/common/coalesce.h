@@ -0,0 +1,79 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_COALESCE_H_
+#define INTERFACE_COMMON_COALESCE_H_
+
+#include <stddef.h>
+#include "interface/common/tensor.h"
+#include "ual/com/broadcast.h"
+
+using tecoal::ual::common::BroadcastPlan;
+
+namespace tecoal {
+
+#define TECOAL_COALESCE_OPERAND_MAX UAL_BROADCAST_OPERAND_MAX
+
+// Elementwise view of several operands. Dims are put in the memory order of operand 0 (the
+// output), size-1 dims are dropped, and neighbours are merged wherever every operand steps over
+// them exactly. dimA and strideA are outermost first, strides are in elements and 0 along the
+// dims a broadcast operand is repeated on.
+struct CoalescedShape {
+    int nbDims = 0;
+    int operandNum = 0;
+    size_t elemNum = 0;
+    int dimA[TECOAL_DIM_MAX];
+    int strideA[TECOAL_COALESCE_OPERAND_MAX][TECOAL_DIM_MAX];
+
+    bool innerContiguous() const {
+        for (int k = 0; k < operandNum; k++) {
+            if (nbDims > 0 && strideA[k][nbDims - 1] != 1) return false;
+        }
+        return true;
+    }
+    // rows() x cols() with unit-stride rows, the layout the streaming kernels accept
+    bool isRows() const { return nbDims <= 2 && innerContiguous(); }
+    int rows() const { return nbDims == 2 ? dimA[0] : 1; }
+    int cols() const { return nbDims == 0 ? 1 : dimA[nbDims - 1]; }
+    int rowStride(int operand) const { return nbDims == 2 ? strideA[operand][0] : cols(); }
+
+    void toPlan(BroadcastPlan *plan) const;
+};
+
+// descs[0] is the output. Returns TECOAL_STATUS_BAD_PARAM when the logical shapes differ and
+// TECOAL_STATUS_NOT_SUPPORTED when more than TECOAL_DIM_MAX dims survive merging.
+tecoalStatus_t coalesceDims(const tecoalTensorStruct *const *descs, int operand_num,
+                            CoalescedShape *shape);
+
+// Same, but shapes are right aligned and broadcast against each other, an operand getting
+// stride 0 along its size-1 or missing dims. keep_order skips the reordering for ops whose
+// output follows the logical element order, such as masked select.
+tecoalStatus_t broadcastDims(const tecoalTensorStruct *const *descs, int operand_num,
+                             bool keep_order, CoalescedShape *shape);
+
+}  // namespace tecoal
+
+#endif  // INTERFACE_COMMON_COALESCE_H_
@@ -38,6 +38,7 @@ tecoalStatus_t Convert::toStatus(const Status status) {
         case Status::NOT_INITIALIZED: return tecoalStatus_t::TECOAL_STATUS_NOT_INITIALIZED;
         case Status::NOT_SUPPORTED: return tecoalStatus_t::TECOAL_STATUS_NOT_SUPPORTED;
         case Status::NO_IMPLEMENTATION: return tecoalStatus_t::TECOAL_STATUS_INTERNAL_ERROR;
+        case Status::RUNTIME_ERROR: return tecoalStatus_t::TECOAL_STATUS_EXECUTION_FAILED;
         default: return tecoalStatus_t::TECOAL_STATUS_INTERNAL_ERROR;
     }
 }
@@ -49,6 +50,7 @@ const char *Convert::toStatusStr(const Status status) {
         case Status::NOT_INITIALIZED: return ("STATUS_NOT_INITIALOZED");
         case Status::NOT_SUPPORTED: return ("STATUS_NOT_SUPPORT");
         case Status::NO_IMPLEMENTATION: return ("STATUS_NO_IMPLEMENTATION");
+        case Status::RUNTIME_ERROR: return ("STATUS_RUNTIME_ERROR");
         default: return ("status err");
     }
 }
@@ -93,6 +95,16 @@ UALOperation Convert::toUALOperation(const tecoalOperation_t trans_type) {
     }
 }
 
+UALBackend Convert::toUALBackend(const tecoalBackend_t backend) {
+    switch (backend) {
+        case TECOAL_BACKEND_DEVICE: return UALBackend::UAL_BACKEND_DEVICE;
+        case TECOAL_BACKEND_CPU: return UALBackend::UAL_BACKEND_HOST;
+        default: {
+            throw std::runtime_error("tecoalBackend_t convert to UALBackend failed!");
+        };
+    }
+}
+
 UALAlgoType Convert::toUalAlgoType(const tecoalAlgo_t algo) {
     switch (algo) {
         case TECOAL_ALGO_0: return UALAlgoType::UAL_ALGO_0;
@@ -146,6 +158,7 @@ UALAlgoType Convert::toUalAlgoType(const tecoalAlgo_t algo) {
         case TECOAL_ALGO_48: return UALAlgoType::UAL_ALGO_48;
         case TECOAL_ALGO_49: return UALAlgoType::UAL_ALGO_49;
         case TECOAL_ALGO_50: return UALAlgoType::UAL_ALGO_50;
+        case TECOAL_ALGO_BEST: return UALAlgoType::UAL_ALGO_BEST;
         default: {
             throw std::runtime_error("tecoalAlgo_t convert to UALAlgoType failed!");
         }
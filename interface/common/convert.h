@@ -41,6 +41,7 @@ class Convert {
     static UALDataType toUALDataType(const tecoalDataType_t data_type);
     static UALOperation toUALOperation(const tecoalOperation_t trans_type);
     static UALAlgoType toUalAlgoType(const tecoalAlgo_t algo);
+    static UALBackend toUALBackend(const tecoalBackend_t backend);
     static unsigned int toDescDataTypeSize(const tecoalDataType_t data_type);
     // unary ops
     static UALUnaryOpsMode toUALUnaryOpsMode(const tecoalUnaryOpsMode_t mode);
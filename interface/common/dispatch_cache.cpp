@@ -0,0 +1,125 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include <cstring>
+#include "interface/common/dispatch_cache.h"
+#include "interface/include/builtin_type.h"
+#include "ual/ops/tuning_db.h"
+
+using tecoal::ual::ops::TuningDatabase;
+
+namespace tecoal {
+
+void DispatchKey::add(double value) {
+    int64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+}
+
+void DispatchKey::add(const tecoalTensorStruct *desc) {
+    // the descriptor hash tells most layouts apart in one word; the exact dims and strides
+    // behind it keep two layouts with the same hash apart. The coalesced view and the 4d fields
+    // follow from these; ops with an axis or broadcast read the dims as given, so the key keeps
+    // them unmerged.
+    add((int64_t)desc->hash);
+    add((int64_t)desc->dataType);
+    add((int64_t)desc->format);
+    add((int64_t)desc->nbDims);
+    for (int i = 0; i < desc->nbDims; i++) {
+        add((int64_t)desc->dimA[i]);
+        add((int64_t)desc->strideA[i]);
+    }
+}
+
+void DispatchKey::add(const tecoalFilterStruct *desc) {
+    add((int64_t)desc->dataType);
+    add((int64_t)desc->format);
+    add((int64_t)desc->m);
+    add((int64_t)desc->c);
+    add((int64_t)desc->r);
+    add((int64_t)desc->s);
+}
+
+void DispatchKey::add(const tecoalConvolutionStruct *desc) {
+    add((int64_t)desc->padA[0]);
+    add((int64_t)desc->padA[1]);
+    add((int64_t)desc->filterStrideA[0]);
+    add((int64_t)desc->filterStrideA[1]);
+    add((int64_t)desc->dilationA[0]);
+    add((int64_t)desc->dilationA[1]);
+    add((int64_t)desc->mode);
+    add((int64_t)desc->dataType);
+}
+
+bool DispatchKey::operator==(const DispatchKey &other) const {
+    return valid_ == other.valid_ && size_ == other.size_ && hash_ == other.hash_ &&
+           memcmp(words_, other.words_, sizeof(int64_t) * size_) == 0;
+}
+
+const DispatchEntry *DispatchCache::lookup(const DispatchKey &key) {
+    // find() results depend on the tuning database, drop them whenever it changes
+    uint64_t generation = TuningDatabase::instance().generation();
+    if (generation != tuning_generation_) {
+        entries_.clear();
+        tuning_generation_ = generation;
+    }
+    if (key.valid()) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            ++hits_;
+            return &it->second;
+        }
+    }
+    ++misses_;
+    return nullptr;
+}
+
+void DispatchCache::insert(const DispatchKey &key, DispatchFunc instance, const char *discription,
+                           int algo, const void *args, size_t args_size) {
+    // shapes of a serving loop are few; an overflowing cache means churn, so start over
+    if (entries_.size() >= TECOAL_DISPATCH_CACHE_MAX) {
+        entries_.clear();
+    }
+    DispatchEntry &entry = entries_[key];
+    entry.instance = instance;
+    entry.discription = discription;
+    entry.algo = algo;
+    entry.args.assign((const char *)args, (const char *)args + args_size);
+}
+
+tecoalAlgo_t DispatchCache::resolveAlgo(const DispatchKey &key, tecoalAlgo_t algo) const {
+    if (algo != TECOAL_ALGO_BEST || !key.valid()) return algo;
+    auto it = best_algos_.find(key);
+    return it != best_algos_.end() ? it->second : algo;
+}
+
+void DispatchCache::clear() {
+    entries_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+}  // namespace tecoal
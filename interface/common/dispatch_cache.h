@@ -0,0 +1,140 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_DISPATCH_CACHE_H_
+#define INTERFACE_COMMON_DISPATCH_CACHE_H_
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "interface/include/tecoal.h"
+#include "ual/com/def.h"
+
+struct tecoalTensorStruct;
+struct tecoalFilterStruct;
+struct tecoalConvolutionStruct;
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+
+#define TECOAL_DISPATCH_KEY_MAX 96
+#define TECOAL_DISPATCH_CACHE_MAX 4096
+
+// Everything find() reads to pick a kernel, flattened to integer words. Data pointers are never
+// part of the key. A key that outgrows TECOAL_DISPATCH_KEY_MAX is marked invalid and simply
+// bypasses the cache.
+struct DispatchKey {
+ public:
+    explicit DispatchKey(const char *op_name) { add((int64_t)(uintptr_t)op_name); }
+
+    void add(int64_t value) {
+        if (size_ >= TECOAL_DISPATCH_KEY_MAX) {
+            valid_ = false;
+            return;
+        }
+        words_[size_++] = value;
+        hash_ = (hash_ ^ (uint64_t)value) * 0x100000001b3ULL;
+    }
+    void add(double value);
+    void add(const tecoalTensorStruct *desc);
+    void add(const tecoalFilterStruct *desc);
+    void add(const tecoalConvolutionStruct *desc);
+
+    bool valid() const { return valid_; }
+    uint64_t hash() const { return hash_; }
+    bool operator==(const DispatchKey &other) const;
+
+ private:
+    int64_t words_[TECOAL_DISPATCH_KEY_MAX];
+    int size_ = 0;
+    bool valid_ = true;
+    uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+struct DispatchKeyHash {
+    size_t operator()(const DispatchKey &key) const { return (size_t)key.hash(); }
+};
+
+typedef void (*DispatchFunc)();
+
+// Resolved branch of one key: kernel entry and the args as patched by find() (bM/bN/bK, ...).
+struct DispatchEntry {
+    DispatchFunc instance;
+    const char *discription;
+    int algo;
+    std::vector<char> args;
+};
+
+// Per-handle memo of find() results. Like the handle itself it is not thread-safe.
+class DispatchCache {
+ public:
+    // Select the kernel of impl and patch args, from the memo or by calling find()
+    template <typename OpType>
+    Status resolve(OpType *impl, typename OpType::ArgsType *args,
+                   const typename OpType::PatchType *patch_args, const DispatchKey *key) {
+        using ArgsType = typename OpType::ArgsType;
+        using PImplType = typename OpType::PImplType;
+
+        const DispatchEntry *entry = lookup(*key);
+        if (entry != nullptr) {
+            impl->setInstance(reinterpret_cast<PImplType>(entry->instance), entry->discription,
+                              entry->algo);
+            impl->restore(reinterpret_cast<const ArgsType *>(entry->args.data()), args);
+            return Status::SUCCESS;
+        }
+        Status status = impl->find(patch_args);
+        if (status != Status::SUCCESS) return status;
+        if (key->valid()) {
+            insert(*key, reinterpret_cast<DispatchFunc>(impl->instance()), impl->discription(),
+                   impl->algo(), args, sizeof(ArgsType));
+        }
+        return Status::SUCCESS;
+    }
+
+    // TECOAL_ALGO_BEST resolves to the algorithm remembered for the key, if any
+    tecoalAlgo_t resolveAlgo(const DispatchKey &key, tecoalAlgo_t algo) const;
+    void setBestAlgo(const DispatchKey &key, tecoalAlgo_t algo) { best_algos_[key] = algo; }
+
+    void clear();
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+ private:
+    const DispatchEntry *lookup(const DispatchKey &key);
+    void insert(const DispatchKey &key, DispatchFunc instance, const char *discription, int algo,
+                const void *args, size_t args_size);
+
+    std::unordered_map<DispatchKey, DispatchEntry, DispatchKeyHash> entries_;
+    std::unordered_map<DispatchKey, tecoalAlgo_t, DispatchKeyHash> best_algos_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t tuning_generation_ = 0;
+};
+
+}  // namespace tecoal
+
+#endif  // INTERFACE_COMMON_DISPATCH_CACHE_H_
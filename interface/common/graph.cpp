@@ -0,0 +1,58 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include <cstring>
+#include "interface/common/graph.h"
+#include "interface/common/convert.h"
+
+tecoalStatus_t tecoalGraphStruct::launch(sdaaStream_t stream,
+                                         tecoal::ual::ops::OpStats *stats) const {
+    for (const tecoal::GraphNode &node : nodes) {
+        Status status = node.launch(node.instance, node.discription, node.algo, node.backend,
+                                    node.args.data(), stream, stats);
+        if (status != Status::SUCCESS) return tecoal::Convert::toStatus(status);
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
+
+// Returns how many pointer fields referred to old_ptr
+int tecoalGraphStruct::updatePointer(const void *old_ptr, void *new_ptr) {
+    int updated = 0;
+    for (tecoal::GraphNode &node : nodes) {
+        for (int i = 0; i < node.pointer_num; i++) {
+            char *field = node.args.data() + node.pointers[i];
+            // a node covering a later slice of the caller's buffer moves along with it
+            const char *value;
+            memcpy(&value, field, sizeof(value));
+            if (value == (const char *)old_ptr + node.pointer_offset) {
+                char *rebound = (char *)new_ptr + node.pointer_offset;
+                memcpy(field, &rebound, sizeof(rebound));
+                updated++;
+            }
+        }
+    }
+    return updated;
+}
@@ -0,0 +1,118 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_GRAPH_H_
+#define INTERFACE_COMMON_GRAPH_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "interface/include/tecoal.h"
+#include "ual/com/def.h"
+#include "ual/ops/op_stats.h"
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+
+typedef void (*GraphKernel)();
+typedef Status (*GraphLaunchFunc)(GraphKernel instance, const char *discription, int algo,
+                                  UALBackend backend, const void *args, sdaaStream_t stream,
+                                  ual::ops::OpStats *stats);
+
+template <typename OpType>
+static Status launchGraphNode(GraphKernel instance, const char *discription, int algo,
+                              UALBackend backend, const void *args, sdaaStream_t stream,
+                              ual::ops::OpStats *stats) {
+    OpType op{};
+    op.setBackend(backend);
+    op.setInstance(reinterpret_cast<typename OpType::PImplType>(instance), discription, algo);
+    op.setStats(stats);
+    return op.run(reinterpret_cast<const typename OpType::ArgsType *>(args), stream);
+}
+
+// One recorded op: the kernel find() chose, its final args, and where the device pointers sit
+// inside those args.
+struct GraphNode {
+    GraphLaunchFunc launch;
+    GraphKernel instance;
+    const char *discription;
+    int algo;
+    UALBackend backend;
+    std::vector<char> args;
+    const size_t *pointers;
+    int pointer_num;
+    size_t pointer_offset;  // bytes the pointer fields sit past the buffers the caller passed
+};
+
+}  // namespace tecoal
+
+// Op sequence recorded between tecoalBeginCapture and tecoalEndCapture. Replaying it skips
+// descriptor checks, args building and kernel selection entirely.
+struct tecoalGraphStruct {
+ public:
+    template <typename OpType>
+    void record(const OpType *op, const typename OpType::ArgsType *args) {
+        tecoal::GraphNode node;
+        node.launch = tecoal::launchGraphNode<OpType>;
+        node.instance = reinterpret_cast<tecoal::GraphKernel>(op->instance());
+        node.discription = op->discription();
+        node.algo = op->algo();
+        node.backend = op->backend();
+        node.args.assign((const char *)args, (const char *)args + sizeof(*args));
+        node.pointers = OpType::pointers(&node.pointer_num);
+        node.pointer_offset = OpType::pointerOffset(args);
+        nodes.push_back(node);
+    }
+
+    // stats: the counters of the handle replaying the graph
+    tecoalStatus_t launch(sdaaStream_t stream, tecoal::ual::ops::OpStats *stats) const;
+    int updatePointer(const void *old_ptr, void *new_ptr);
+
+    // Replays queued on a host stream; the graph is neither rewritten nor freed under them.
+    void beginQueued() {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued++;
+    }
+    void endQueued() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queued--;
+        }
+        idle.notify_all();
+    }
+    void waitQueued() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [&]() { return queued == 0; });
+    }
+
+    std::vector<tecoal::GraphNode> nodes;
+    std::mutex mutex;
+    std::condition_variable idle;
+    int queued = 0;
+};
+
+#endif  // INTERFACE_COMMON_GRAPH_H_
@@ -29,13 +29,27 @@
 
 #include "interface/common/check.h"
 
-#define RUN_OP(op_type, args, patch_args, handle) \
-    do {                                          \
-        op_type impl{};                           \
-        auto status = impl.find(&patch_args);     \
-        checkUalStatusInTecoal(status);           \
-        status = impl.run(&args, handle->stream); \
-        checkUalStatusInTecoal(status);           \
+// key holds everything find() depends on; a hit on the handle's dispatch cache skips find().
+// The backend completes the key, device and host kernels of one problem are separate entries.
+// While the handle is capturing, the resolved kernel and args are recorded instead of launched;
+// otherwise host kernels run on the handle's thread pool, queued on its host stream if it has one.
+#define RUN_OP(op_type, args, patch_args, handle, key)                                           \
+    do {                                                                                         \
+        op_type op_impl{};                                                                       \
+        op_impl.setBackend(tecoal::Convert::toUALBackend(handle->backend));                      \
+        op_impl.setStats(handle->op_stats);                                                      \
+        key.add((int64_t)handle->backend);                                                       \
+        auto status = handle->dispatch_cache->resolve(&op_impl, &args, &patch_args, &key);      \
+        checkUalStatusInTecoal(status);                                                          \
+        if (handle->capture != nullptr) {                                                        \
+            handle->capture->record(&op_impl, &args);                                            \
+        } else if (handle->host_stream != nullptr && handle->backend == TECOAL_BACKEND_CPU) {    \
+            handle->host_stream->enqueue(&op_impl, &args, handle->host_pool);                    \
+        } else {                                                                                 \
+            tecoal::ual::host::PoolScope pool_scope(handle->host_pool);                          \
+            status = op_impl.run(&args, handle->stream);                                         \
+            checkUalStatusInTecoal(status);                                                      \
+        }                                                                                        \
     } while (0);
 
 #define TECO_PREDICT_FALSE(x) (__builtin_expect(!!(x), 0))
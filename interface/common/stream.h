@@ -0,0 +1,135 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_STREAM_H_
+#define INTERFACE_COMMON_STREAM_H_
+
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include "interface/include/tecoal.h"
+#include "ual/com/def.h"
+#include "ual/host/host_stream.h"
+#include "ual/host/thread_pool.h"
+
+struct tecoalHostStreamStruct {
+ public:
+    // The op runs later on the stream's thread with its own copy of the args, as a graph node
+    // would, and spreads over pool (null: the shared pool).
+    template <typename OpType>
+    void enqueue(const OpType *op, const typename OpType::ArgsType *args,
+                 tecoal::ual::host::ThreadPool *pool) {
+        auto instance = op->instance();
+        const char *discription = op->discription();
+        const int algo = op->algo();
+        auto stats = op->stats();
+        const typename OpType::ArgsType copy = *args;
+        queue.enqueue([instance, discription, algo, stats, copy, pool]() {
+            tecoal::ual::host::PoolScope pool_scope(pool);
+            OpType op_impl{};
+            op_impl.setBackend(tecoal::ual::common::UALBackend::UAL_BACKEND_HOST);
+            op_impl.setInstance(instance, discription, algo);
+            op_impl.setStats(stats);
+            return op_impl.run(&copy, nullptr);
+        });
+    }
+
+    tecoal::ual::host::HostStream queue;
+};
+
+// Every tecoalEventRecord bumps recorded. A host record completes once the host stream reaches
+// it, stamping time_ns; a device record goes to the sdaa event device, created by the first one,
+// and completes with the device stream.
+struct tecoalEventStruct {
+ public:
+    ~tecoalEventStruct() {
+        if (device != nullptr) sdaaEventDestroy(device);
+    }
+
+    uint64_t record() {
+        std::lock_guard<std::mutex> lock(mutex);
+        on_device = false;
+        return ++recorded;
+    }
+
+    bool recordDevice(sdaaStream_t stream) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (device == nullptr && sdaaEventCreate(&device) != sdaaSuccess) {
+                device = nullptr;
+                return false;
+            }
+            if (sdaaEventRecord(device, stream) != sdaaSuccess) return false;
+            on_device = true;
+            completed = ++recorded;  // host waiters hand over to the device event
+        }
+        done.notify_all();
+        return true;
+    }
+
+    void complete(uint64_t ticket, uint64_t now_ns) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ticket > completed) {
+                completed = ticket;
+                time_ns = now_ns;
+            }
+        }
+        done.notify_all();
+    }
+
+    // Waits for the latest record. TECOAL_STATUS_BAD_PARAM if the event was never recorded,
+    // TECOAL_STATUS_EXECUTION_FAILED if the device failed to reach it.
+    tecoalStatus_t wait(uint64_t *stamp_ns) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (recorded == 0) return TECOAL_STATUS_BAD_PARAM;
+        if (on_device) {
+            sdaaEvent_t event = device;
+            lock.unlock();
+            return sdaaEventSynchronize(event) == sdaaSuccess ? TECOAL_STATUS_SUCCESS
+                                                               : TECOAL_STATUS_EXECUTION_FAILED;
+        }
+        const uint64_t target = recorded;
+        done.wait(lock, [&]() { return completed >= target; });
+        if (stamp_ns != nullptr) *stamp_ns = time_ns;
+        return TECOAL_STATUS_SUCCESS;
+    }
+
+    bool onDevice() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return on_device;
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    uint64_t recorded = 0;
+    uint64_t completed = 0;
+    uint64_t time_ns = 0;
+    sdaaEvent_t device = nullptr;
+    bool on_device = false;  // the latest record is a device record
+};
+
+#endif  // INTERFACE_COMMON_STREAM_H_
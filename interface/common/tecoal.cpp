@@ -24,26 +24,237 @@
 // WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
 // OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <vector>
 #include "interface/include/builtin_type.h"
 #include "interface/common/marco.h"
 #include "interface/common/tensor.h"
+#include "interface/common/convert.h"
+#include "ual/com/log.h"
+#include "ual/ops/tuning_db.h"
+#include "ual/ops/profiler.h"
+#include "ual/ops/op_stats.h"
+
+using tecoal::ual::ops::TuningDatabase;
+using tecoal::ual::ops::Profiler;
+using tecoal::ual::ops::OpStats;
+using tecoal::ual::ops::OpStatsEntry;
+
+// Host work already queued for the handle keeps the pool and workspace it was issued with
+static void drainHostStream(tecoalHandle_t handle) {
+    if (handle->host_stream != nullptr) handle->host_stream->queue.synchronize();
+}
+
+// Live host streams, so that tecoalSetStream can tell them from sdaa streams
+struct HostStreamRegistry {
+    std::mutex mutex;
+    std::set<const void *> streams;
+};
+
+static HostStreamRegistry &hostStreams() {
+    static HostStreamRegistry registry;
+    return registry;
+}
+
+static bool isHostStream(const void *stream) {
+    HostStreamRegistry &registry = hostStreams();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.streams.count(stream) != 0;
+}
+
+// The database named by TECOAL_TUNING_DB is mapped once, when the first handle is created
+static void loadTuningDatabaseFromEnv() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        const char *path = getenv("TECOAL_TUNING_DB");
+        if (path != nullptr && TuningDatabase::instance().load(path) != Status::SUCCESS) {
+            WARNING("tuning database %s is ignored", path);
+        }
+    });
+}
 
 tecoalStatus_t TECOALWINAPI tecoalCreate(tecoalHandle_t *handle) {
-    *handle = (tecoalHandle_t)malloc(sizeof(tecoalHandle_t));
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    loadTuningDatabaseFromEnv();
+    Profiler::instance();  // picks up TECOAL_PROFILE
+    OpStats::loadEnv();    // picks up TECOAL_OP_STATS
+    *handle = new tecoalContext();
     (*handle)->spa_num = 1;
     (*handle)->spe_num = 32;
     (*handle)->stream = nullptr;
+    (*handle)->backend = TECOAL_BACKEND_DEVICE;
+    (*handle)->host_pool = nullptr;
+    (*handle)->host_stream = nullptr;
+    (*handle)->dispatch_cache = new tecoal::DispatchCache();
+    (*handle)->capture = nullptr;
+    (*handle)->op_stats = new OpStats();
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t TECOALWINAPI tecoalDestroy(tecoalHandle_t handle) {
     if (!handle) return TECOAL_STATUS_BAD_PARAM;
-    free(handle);
+    drainHostStream(handle);
+    delete handle->dispatch_cache;
+    delete handle->capture;
+    delete handle->host_pool;
+    delete handle->op_stats;
+    delete handle;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGetDispatchCacheStats(tecoalHandle_t handle, uint64_t *hits,
+                                                        uint64_t *misses) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    if (hits != nullptr) *hits = handle->dispatch_cache->hits();
+    if (misses != nullptr) *misses = handle->dispatch_cache->misses();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalClearDispatchCache(tecoalHandle_t handle) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    handle->dispatch_cache->clear();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetWorkspace(tecoalHandle_t handle, void *workSpace,
+                                               size_t workSpaceSizeInBytes) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    if (!workSpace && workSpaceSizeInBytes > 0) return TECOAL_STATUS_BAD_PARAM;
+    drainHostStream(handle);
+    handle->workspace.reset(workSpace, workSpaceSizeInBytes);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGetWorkspacePeakUsage(tecoalHandle_t handle,
+                                                        size_t *peakSizeInBytes) {
+    if (!handle || !peakSizeInBytes) return TECOAL_STATUS_BAD_PARAM;
+    *peakSizeInBytes = handle->workspace.peak();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalResetWorkspacePeakUsage(tecoalHandle_t handle) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    handle->workspace.resetPeak();
     return TECOAL_STATUS_SUCCESS;
 }
 
+tecoalStatus_t TECOALWINAPI tecoalBeginCapture(tecoalHandle_t handle) {
+    if (!handle || handle->capture != nullptr) return TECOAL_STATUS_BAD_PARAM;
+    handle->capture = new tecoalGraphStruct();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalEndCapture(tecoalHandle_t handle, tecoalGraph_t *graph) {
+    if (!handle || !graph || handle->capture == nullptr) return TECOAL_STATUS_BAD_PARAM;
+    *graph = handle->capture;
+    handle->capture = nullptr;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGraphLaunch(tecoalHandle_t handle, const tecoalGraph_t graph) {
+    if (!handle || !graph) return TECOAL_STATUS_BAD_PARAM;
+    // as RUN_OP: only host work goes through the host stream
+    if (handle->host_stream != nullptr && handle->backend == TECOAL_BACKEND_CPU) {
+        tecoal::ual::host::ThreadPool *pool = handle->host_pool;
+        sdaaStream_t stream = handle->stream;
+        OpStats *stats = handle->op_stats;
+        graph->beginQueued();
+        handle->host_stream->queue.enqueue([graph, pool, stream, stats]() {
+            tecoal::ual::host::PoolScope pool_scope(pool);
+            tecoalStatus_t status = graph->launch(stream, stats);
+            graph->endQueued();
+            return status == TECOAL_STATUS_SUCCESS ? Status::SUCCESS : Status::RUNTIME_ERROR;
+        });
+        return TECOAL_STATUS_SUCCESS;
+    }
+    tecoal::ual::host::PoolScope pool_scope(handle->host_pool);
+    return graph->launch(handle->stream, handle->op_stats);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGraphUpdatePointer(tecoalGraph_t graph, const void *oldPtr,
+                                                     void *newPtr) {
+    if (!graph || !oldPtr) return TECOAL_STATUS_BAD_PARAM;
+    graph->waitQueued();
+    if (graph->updatePointer(oldPtr, newPtr) == 0) return TECOAL_STATUS_BAD_PARAM;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalDestroyGraph(tecoalGraph_t graph) {
+    if (!graph) return TECOAL_STATUS_BAD_PARAM;
+    graph->waitQueued();
+    delete graph;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetProfiling(bool enable) {
+    Profiler::instance();
+    Profiler::setEnabled(enable);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalDumpProfile(const char *path) {
+    if (!path) return TECOAL_STATUS_BAD_PARAM;
+    return tecoal::Convert::toStatus(Profiler::instance().dump(path));
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetOpStats(bool enable) {
+    OpStats::loadEnv();
+    OpStats::setEnabled(enable);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGetOpStats(tecoalHandle_t handle, const int requestedCount,
+                                             int *returnedCount, tecoalOpStats_t *stats) {
+    if (!handle || !returnedCount) return TECOAL_STATUS_BAD_PARAM;
+    drainHostStream(handle);
+    std::vector<OpStatsEntry> entries = handle->op_stats->collect();
+    if (stats == nullptr) {
+        *returnedCount = (int)entries.size();
+        return TECOAL_STATUS_SUCCESS;
+    }
+
+    int count = std::min(requestedCount, (int)entries.size());
+    for (int i = 0; i < count; i++) {
+        const OpStatsEntry &entry = entries[i];
+        stats[i].opName = entry.name;
+        stats[i].kernelName = entry.discription;
+        stats[i].algo = entry.algo;
+        stats[i].calls = entry.calls;
+        stats[i].totalTimeMs = entry.total_ns / 1e6;
+        stats[i].maxTimeMs = entry.max_ns / 1e6;
+        stats[i].bytesRead = entry.bytes_read;
+        stats[i].bytesWritten = entry.bytes_written;
+        stats[i].flops = entry.flops;
+    }
+    *returnedCount = count;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalResetOpStats(tecoalHandle_t handle) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    drainHostStream(handle);
+    handle->op_stats->reset();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalLoadTuningDatabase(const char *path) {
+    if (!path) return TECOAL_STATUS_BAD_PARAM;
+    return tecoal::Convert::toStatus(TuningDatabase::instance().load(path));
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSaveTuningDatabase(const char *path) {
+    if (!path) return TECOAL_STATUS_BAD_PARAM;
+    return tecoal::Convert::toStatus(TuningDatabase::instance().save(path));
+}
+
 tecoalStatus_t TECOALWINAPI tecoalSetStream(tecoalHandle_t handle, sdaaStream_t streamId) {
     if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    if (streamId != nullptr && isHostStream(streamId)) {
+        return tecoalSetHostStream(handle, reinterpret_cast<tecoalHostStream_t>(streamId));
+    }
     handle->stream = streamId;
     return TECOAL_STATUS_SUCCESS;
 }
@@ -54,6 +265,143 @@ tecoalStatus_t TECOALWINAPI tecoalGetStream(tecoalHandle_t handle, sdaaStream_t
     return TECOAL_STATUS_SUCCESS;
 }
 
+tecoalStatus_t TECOALWINAPI tecoalCreateHostStream(tecoalHostStream_t *stream) {
+    if (!stream) return TECOAL_STATUS_BAD_PARAM;
+    *stream = new tecoalHostStreamStruct();
+    HostStreamRegistry &registry = hostStreams();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.streams.insert(*stream);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalDestroyHostStream(tecoalHostStream_t stream) {
+    if (!stream) return TECOAL_STATUS_BAD_PARAM;
+    {
+        HostStreamRegistry &registry = hostStreams();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.streams.erase(stream);
+    }
+    delete stream;  // runs what is still queued first
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetHostStream(tecoalHandle_t handle, tecoalHostStream_t stream) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    // work queued on the old stream stays ahead of what the handle issues next
+    drainHostStream(handle);
+    handle->host_stream = stream;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGetHostStream(tecoalHandle_t handle,
+                                                tecoalHostStream_t *stream) {
+    if (!handle || !stream) return TECOAL_STATUS_BAD_PARAM;
+    *stream = handle->host_stream;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalStreamSynchronize(tecoalHandle_t handle) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    drainHostStream(handle);
+    // a failure of queued work is reported once, by the first synchronize after it
+    if (handle->host_stream != nullptr &&
+        handle->host_stream->queue.takeError() != Status::SUCCESS) {
+        return TECOAL_STATUS_EXECUTION_FAILED;
+    }
+    if (handle->backend == TECOAL_BACKEND_DEVICE &&
+        sdaaStreamSynchronize(handle->stream) != sdaaSuccess) {
+        return TECOAL_STATUS_EXECUTION_FAILED;
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalCreateEvent(tecoalEvent_t *event) {
+    if (!event) return TECOAL_STATUS_BAD_PARAM;
+    *event = new tecoalEventStruct();
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalDestroyEvent(tecoalEvent_t event) {
+    if (!event) return TECOAL_STATUS_BAD_PARAM;
+    event->wait(nullptr);  // a queued record still refers to it
+    delete event;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalEventRecord(tecoalHandle_t handle, tecoalEvent_t event) {
+    if (!handle || !event) return TECOAL_STATUS_BAD_PARAM;
+    if (handle->backend == TECOAL_BACKEND_DEVICE) {
+        return event->recordDevice(handle->stream) ? TECOAL_STATUS_SUCCESS
+                                                   : TECOAL_STATUS_EXECUTION_FAILED;
+    }
+    const uint64_t ticket = event->record();
+    if (handle->host_stream != nullptr) {
+        handle->host_stream->queue.enqueue([event, ticket]() {
+            event->complete(ticket, Profiler::now());
+            return Status::SUCCESS;
+        });
+    } else {
+        event->complete(ticket, Profiler::now());
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalEventSynchronize(tecoalEvent_t event) {
+    if (!event) return TECOAL_STATUS_BAD_PARAM;
+    return event->wait(nullptr);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalEventElapsedTime(float *ms, tecoalEvent_t start,
+                                                   tecoalEvent_t end) {
+    if (!ms || !start || !end) return TECOAL_STATUS_BAD_PARAM;
+    uint64_t start_ns = 0, end_ns = 0;
+    tecoalStatus_t status = start->wait(&start_ns);
+    if (status == TECOAL_STATUS_SUCCESS) status = end->wait(&end_ns);
+    if (status != TECOAL_STATUS_SUCCESS) return status;
+    const bool on_device = start->onDevice();
+    // host records are stamped on the host clock, device ones on the device's
+    if (on_device != end->onDevice()) return TECOAL_STATUS_BAD_PARAM;
+    if (on_device) {
+        return sdaaEventElapsedTime(ms, start->device, end->device) == sdaaSuccess
+                   ? TECOAL_STATUS_SUCCESS
+                   : TECOAL_STATUS_EXECUTION_FAILED;
+    }
+    *ms = (float)(((double)end_ns - (double)start_ns) / 1e6);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetBackend(tecoalHandle_t handle, tecoalBackend_t backend) {
+    if (!handle) return TECOAL_STATUS_BAD_PARAM;
+    if (backend != TECOAL_BACKEND_DEVICE && backend != TECOAL_BACKEND_CPU) {
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    handle->backend = backend;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGetBackend(tecoalHandle_t handle, tecoalBackend_t *backend) {
+    if (!handle || !backend) return TECOAL_STATUS_BAD_PARAM;
+    *backend = handle->backend;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalSetHostThreads(tecoalHandle_t handle, int threadNum,
+                                                 const int *cpuSet, int cpuNum) {
+    if (!handle || cpuNum < 0 || (cpuNum > 0 && !cpuSet)) return TECOAL_STATUS_BAD_PARAM;
+    std::vector<int> cpus(cpuSet, cpuSet + cpuNum);
+    for (int cpu : cpus) {
+        if (cpu < 0) return TECOAL_STATUS_BAD_PARAM;
+    }
+    drainHostStream(handle);
+    delete handle->host_pool;
+    handle->host_pool = nullptr;
+    if (threadNum >= 0) {
+        handle->host_pool =
+            new tecoal::ual::host::ThreadPool(threadNum > 0 ? threadNum : handle->spe_num, cpus);
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
+
 tecoalStatus_t TECOALWINAPI tecoalCreateTensorDescriptor(tecoalTensorDescriptor_t *tensorDesc) {
     *tensorDesc = new tecoalTensorStruct();
     return TECOAL_STATUS_SUCCESS;
@@ -99,7 +447,7 @@ tecoalStatus_t TECOALWINAPI tecoalSetTensor4dDescriptor(tecoalTensorDescriptor_t
     checkTecoalStatus(tensorDesc->setTensorStrideC(cStride));
     checkTecoalStatus(tensorDesc->setTensorStrideH(hStride));
     checkTecoalStatus(tensorDesc->setTensorStrideW(wStride));
-    return TECOAL_STATUS_SUCCESS;
+    return tensorDesc->update();
 }
 
 tecoalStatus_t TECOALWINAPI tecoalGetTensor4dDescriptor(tecoalTensorDescriptor_t tensorDesc,
@@ -180,7 +528,7 @@ tecoalStatus_t TECOALWINAPI tecoalSetTensorNdDescriptor(tecoalTensorDescriptor_t
             (tensorDesc->strideA)[i] = (tensorDesc->strideA)[i + 1] * dimA[i + 1];
         }
     }
-    return TECOAL_STATUS_SUCCESS;
+    return tensorDesc->update();
 }
 
 tecoalStatus_t TECOALWINAPI tecoalGetTensorNdDescriptor(const tecoalTensorDescriptor_t tensorDesc,
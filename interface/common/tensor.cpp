@@ -1,3 +1,4 @@
+#include <climits>
 #include "interface/common/tensor.h"
 #include "interface/common/convert.h"
 #include "ual/com/log.h"
@@ -25,137 +26,49 @@ tecoalStatus_t tecoalTensorStruct::check() {
 
 tecoalStatus_t tecoalTensorStruct::getTensorDimN(int *dim_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NCHW:
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_NWHC: index = 0; break;
-        case TECOAL_TENSOR_CHWN: index = 3; break;
-        default:
-            ERROR("tecoal getTensorDimN illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *dim_size = dimA[index];
+    *dim_size = n;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorDimH(int *dim_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_CHWN: index = 1; break;
-        case TECOAL_TENSOR_NCHW:
-        case TECOAL_TENSOR_NWHC: index = 2; break;
-        default:
-            ERROR("tecoal getTensorDimH illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *dim_size = dimA[index];
+    *dim_size = h;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorDimW(int *dim_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NWHC: index = 1; break;
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_CHWN: index = 2; break;
-        case TECOAL_TENSOR_NCHW: index = 3; break;
-        default:
-            ERROR("tecoal getTensorDimW illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *dim_size = dimA[index];
+    *dim_size = w;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorDimC(int *dim_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_CHWN: index = 0; break;
-        case TECOAL_TENSOR_NCHW: index = 1; break;
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_NWHC: index = 3; break;
-        default:
-            ERROR("tecoal getTensorDimC illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *dim_size = dimA[index];
+    *dim_size = c;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorStrideN(int *stride_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NCHW:
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_NWHC: index = 0; break;
-        case TECOAL_TENSOR_CHWN: index = 3; break;
-        default:
-            ERROR("tecoal getTensorStrideN illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *stride_size = strideA[index];
+    *stride_size = nStride;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorStrideH(int *stride_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_CHWN: index = 1; break;
-        case TECOAL_TENSOR_NCHW:
-        case TECOAL_TENSOR_NWHC: index = 2; break;
-        default:
-            ERROR("tecoal getTensorStrideH illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *stride_size = strideA[index];
+    *stride_size = hStride;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorStrideW(int *stride_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_NWHC: index = 1; break;
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_CHWN: index = 2; break;
-        case TECOAL_TENSOR_NCHW: index = 3; break;
-        default:
-            ERROR("tecoal getTensorStrideW illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *stride_size = strideA[index];
+    *stride_size = wStride;
     return TECOAL_STATUS_SUCCESS;
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorStrideC(int *stride_size) {
     checkTecoalStatus(check());
-
-    int index;
-    switch (format) {
-        case TECOAL_TENSOR_CHWN: index = 0; break;
-        case TECOAL_TENSOR_NCHW: index = 1; break;
-        case TECOAL_TENSOR_NHWC:
-        case TECOAL_TENSOR_NWHC: index = 3; break;
-        default:
-            ERROR("tecoal getTensorStrideC illegal format: %d\n", format);
-            return TECOAL_STATUS_BAD_PARAM;
-    }
-    *stride_size = strideA[index];
+    *stride_size = cStride;
     return TECOAL_STATUS_SUCCESS;
 }
 
@@ -304,11 +217,94 @@ tecoalStatus_t tecoalTensorStruct::setTensorStrideC(int stride_size) {
 }
 
 tecoalStatus_t tecoalTensorStruct::getTensorSizeInBytes(size_t *tensor_size) {
-    *tensor_size = 1;
+    *tensor_size = sizeInBytes;
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t tecoalTensorStruct::update() {
+    for (int i = 0; i < nbDims; i++) {
+        if (dimA[i] < 0 || strideA[i] < 0) {
+            ERROR("tecoal tensor dim %d has negative size or stride\n", i);
+            return TECOAL_STATUS_BAD_PARAM;
+        }
+    }
+
+    // the 4d fields follow dimA, also after an Nd set
+    if (nbDims == 4 && check() == TECOAL_STATUS_SUCCESS) {
+        int in, ic, ih, iw;
+        switch (format) {
+            case TECOAL_TENSOR_NHWC: in = 0, ih = 1, iw = 2, ic = 3; break;
+            case TECOAL_TENSOR_NWHC: in = 0, iw = 1, ih = 2, ic = 3; break;
+            case TECOAL_TENSOR_CHWN: ic = 0, ih = 1, iw = 2, in = 3; break;
+            default: in = 0, ic = 1, ih = 2, iw = 3; break;
+        }
+        n = dimA[in], c = dimA[ic], h = dimA[ih], w = dimA[iw];
+        nStride = strideA[in], cStride = strideA[ic];
+        hStride = strideA[ih], wStride = strideA[iw];
+    }
+
+    size_t type_size = Convert::toDescDataTypeSize(dataType);
+    elemNum = 1;
+    size_t extent = 1;
+    for (int i = 0; i < nbDims; i++) {
+        elemNum *= dimA[i];
+        if (dimA[i] > 0) extent += (size_t)(dimA[i] - 1) * strideA[i];
+    }
+    sizeInBytes = elemNum == 0 ? 0 : extent * type_size;
+
+    // walk inner to outer, merging a dim into the current run when it steps exactly over it
+    int rank = 0;
+    int64_t run_dim = 1;
+    int run_stride = 1;
+    bool overflow = false;
     for (int i = nbDims - 1; i >= 0; i--) {
-        *tensor_size += (dimA[i] - 1) * strideA[i];
+        if (dimA[i] == 1) continue;
+        if (run_dim == 1) {
+            run_dim = dimA[i], run_stride = strideA[i];
+        } else if (run_dim * run_stride == strideA[i] && run_dim * dimA[i] <= INT_MAX) {
+            run_dim *= dimA[i];
+        } else {
+            if (rank == TECOAL_DIM_MAX) overflow = true;
+            if (!overflow) {
+                coalescedDimA[rank] = (int)run_dim, coalescedStrideA[rank] = run_stride;
+                rank++;
+            }
+            run_dim = dimA[i], run_stride = strideA[i];
+        }
+    }
+    if (rank == TECOAL_DIM_MAX) overflow = true;
+    if (!overflow) {
+        coalescedDimA[rank] = (int)run_dim;
+        coalescedStrideA[rank] = run_dim == 1 ? 1 : run_stride;
+        rank++;
+    }
+    coalescedNbDims = overflow ? 0 : rank;
+    // collected inner first, stored outermost first
+    for (int i = 0; i < coalescedNbDims / 2; i++) {
+        int j = coalescedNbDims - 1 - i;
+        int d = coalescedDimA[i], st = coalescedStrideA[i];
+        coalescedDimA[i] = coalescedDimA[j], coalescedStrideA[i] = coalescedStrideA[j];
+        coalescedDimA[j] = d, coalescedStrideA[j] = st;
+    }
+    isContiguous = elemNum <= 1 || (coalescedNbDims == 1 && coalescedStrideA[0] == 1);
+
+    alignBytes = 0;
+    if (coalescedNbDims > 0 && coalescedStrideA[coalescedNbDims - 1] == 1) {
+        size_t run_bytes = (size_t)coalescedDimA[coalescedNbDims - 1] * type_size;
+        alignBytes = TECOAL_ALIGN_MAX;
+        while (alignBytes > 1 && run_bytes % alignBytes != 0) alignBytes >>= 1;
+    }
+
+    uint64_t h64 = 0xcbf29ce484222325ULL;
+    int64_t words[] = {dataType, format, nbDims, n, c, h, w};
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        h64 = (h64 ^ (uint64_t)words[i]) * 0x100000001b3ULL;
+    }
+    for (int i = 0; i < nbDims; i++) {
+        h64 = (h64 ^ (uint64_t)dimA[i]) * 0x100000001b3ULL;
+        h64 = (h64 ^ (uint64_t)strideA[i]) * 0x100000001b3ULL;
     }
-    *tensor_size *= Convert::toDescDataTypeSize(dataType);
+    hash = h64;
     return TECOAL_STATUS_SUCCESS;
 }
 
@@ -6,6 +6,7 @@
 #include "interface/include/tecoal.h"
 
 #define TECOAL_DIM_MAX 8
+#define TECOAL_ALIGN_MAX 64
 
 struct tecoalTensorStruct {
  public:
@@ -24,17 +25,11 @@ struct tecoalTensorStruct {
     tecoalStatus_t getTensorStrideW(int *stride_size);
     tecoalStatus_t getTensorStrideC(int *stride_size);
 
-    tecoalStatus_t setTensorDimN(int dim_size);
-    tecoalStatus_t setTensorDimH(int dim_size);
-    tecoalStatus_t setTensorDimW(int dim_size);
-    tecoalStatus_t setTensorDimC(int dim_size);
-    tecoalStatus_t setTensorStrideN(int stride_size);
-    tecoalStatus_t setTensorStrideH(int stride_size);
-    tecoalStatus_t setTensorStrideW(int stride_size);
-    tecoalStatus_t setTensorStrideC(int stride_size);
-
     tecoalStatus_t getTensorSizeInBytes(size_t *tensor_size);
 
+    // recompute the derived facts below, called once by every tecoalSet*Descriptor
+    tecoalStatus_t update();
+
     // member variables start
     tecoalTensorFormat_t format = TECOAL_TENSOR_NHWC;
     tecoalDataType_t dataType = TECOAL_DATA_FLOAT;
@@ -60,7 +55,35 @@ struct tecoalTensorStruct {
     int hStride = 0;
     int wStride = 0;
 
+    // derived facts, read-only for ops
+    size_t elemNum = 0;
+    size_t sizeInBytes = 0;
+    bool isContiguous = false;
+    // dims merged wherever strides allow and size-1 dims dropped, outermost first.
+    // coalescedNbDims is 0 when the merged rank still exceeds TECOAL_DIM_MAX.
+    int coalescedNbDims = 0;
+    int coalescedDimA[TECOAL_DIM_MAX] = {0};
+    int coalescedStrideA[TECOAL_DIM_MAX] = {0};
+    // largest power of two (<= TECOAL_ALIGN_MAX) dividing the innermost contiguous run in bytes
+    int alignBytes = 0;
+    // digest of every field above update() reads, compared first by the dispatch cache
+    uint64_t hash = 0;
+
  private:
+    // Single fields leave the derived facts stale, so only tecoalSetTensor4dDescriptor sets
+    // them, followed by update()
+    friend tecoalStatus_t TECOALWINAPI tecoalSetTensor4dDescriptor(tecoalTensorDescriptor_t,
+                                                                   tecoalTensorFormat_t,
+                                                                   tecoalDataType_t, int, int,
+                                                                   int, int);
+    tecoalStatus_t setTensorDimN(int dim_size);
+    tecoalStatus_t setTensorDimH(int dim_size);
+    tecoalStatus_t setTensorDimW(int dim_size);
+    tecoalStatus_t setTensorDimC(int dim_size);
+    tecoalStatus_t setTensorStrideN(int stride_size);
+    tecoalStatus_t setTensorStrideH(int stride_size);
+    tecoalStatus_t setTensorStrideW(int stride_size);
+    tecoalStatus_t setTensorStrideC(int stride_size);
 };
 
 struct tecoalFilterStruct {
@@ -0,0 +1,89 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef INTERFACE_COMMON_WORKSPACE_H_
+#define INTERFACE_COMMON_WORKSPACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace tecoal {
+
+#define TECOAL_WORKSPACE_ALIGN 128
+
+// Stack allocator over the buffer given to tecoalSetWorkspace. Ops take temporaries
+// inside a WorkspaceScope and hand them back when the scope closes, so nothing is allocated
+// per call. Memory is reused by the next op on the handle, which is safe because both are
+// ordered on the handle's stream.
+class WorkspaceArena {
+ public:
+    void reset(void *base, size_t size) {
+        base_ = (char *)base;
+        size_ = base == nullptr ? 0 : size;
+        offset_ = 0;
+    }
+
+    // Returns nullptr when the request does not fit. The demand still counts towards peak(),
+    // so a too small workspace reports the size it should have had.
+    void *alloc(size_t bytes) {
+        const size_t mask = TECOAL_WORKSPACE_ALIGN - 1;
+        size_t begin = (offset_ + mask) & ~mask;
+        size_t end = begin + bytes;
+        if (end > peak_) peak_ = end;
+        if (end > size_) return nullptr;
+        offset_ = end;
+        return base_ + begin;
+    }
+
+    size_t mark() const { return offset_; }
+    void release(size_t mark) { offset_ = mark; }
+
+    size_t size() const { return size_; }
+    size_t peak() const { return peak_; }
+    void resetPeak() { peak_ = offset_; }
+
+ private:
+    char *base_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    size_t peak_ = 0;
+};
+
+class WorkspaceScope {
+ public:
+    explicit WorkspaceScope(WorkspaceArena *arena) : arena_(arena), mark_(arena->mark()) {}
+    ~WorkspaceScope() { arena_->release(mark_); }
+    WorkspaceScope(const WorkspaceScope &other) = delete;
+    WorkspaceScope &operator=(const WorkspaceScope &other) = delete;
+
+ private:
+    WorkspaceArena *arena_;
+    size_t mark_;
+};
+
+}  // namespace tecoal
+
+#endif  // INTERFACE_COMMON_WORKSPACE_H_
@@ -29,12 +29,24 @@
 
 #include "interface/include/tecoal.h"
 #include "interface/common/tensor.h"
+#include "interface/common/dispatch_cache.h"
+#include "interface/common/workspace.h"
+#include "interface/common/graph.h"
+#include "interface/common/stream.h"
+#include "ual/host/thread_pool.h"
 
 struct tecoalContext {
     int spa_num;
     int spe_num;
     int spm_size;
     sdaaStream_t stream;
+    tecoalBackend_t backend;
+    tecoal::ual::host::ThreadPool *host_pool;  // null: the shared pool
+    tecoalHostStreamStruct *host_stream;       // null: host kernels run in the op call
+    tecoal::DispatchCache *dispatch_cache;
+    tecoal::WorkspaceArena workspace;
+    tecoalGraphStruct *capture;  // non-null between tecoalBeginCapture and tecoalEndCapture
+    tecoal::ual::ops::OpStats *op_stats;  // counters of the launches made through the handle
 };
 
 struct tecoalConvolutionStruct {
@@ -143,12 +143,55 @@ typedef enum {
     TECOAL_ALGO_47,
     TECOAL_ALGO_48,
     TECOAL_ALGO_49,
-    TECOAL_ALGO_50
+    TECOAL_ALGO_50,
+    // fastest algorithm measured by tecoalFind*Algorithm on this handle for the same problem,
+    // the most optimized eligible variant if it has not been tuned. Every op takes it, an op with
+    // a single kernel runs that one.
+    TECOAL_ALGO_BEST = -1
 } tecoalAlgo_t;
 
+typedef struct {
+    tecoalAlgo_t algo;
+    tecoalStatus_t status;
+    float time;     // milliseconds, -1 if the algorithm did not run
+    size_t memory;  // workspace in bytes
+} tecoalAlgoPerf_t;
+
+// Counters of one kernel variant; bytes and FLOPs are derived from the op arguments.
+typedef struct {
+    const char *opName;
+    const char *kernelName;
+    int algo;
+    uint64_t calls;
+    double totalTimeMs;
+    double maxTimeMs;
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    uint64_t flops;
+} tecoalOpStats_t;
+
+// Where the ops of a handle run. TECOAL_BACKEND_CPU runs the same ops, descriptors and status
+// codes on host threads, so pointers passed to ops must then be host memory.
+typedef enum {
+    TECOAL_BACKEND_DEVICE = 0,
+    TECOAL_BACKEND_CPU = 1,
+} tecoalBackend_t;
+
 struct tecoalContext;
 typedef struct tecoalContext *tecoalHandle_t;
 
+struct tecoalGraphStruct;
+typedef struct tecoalGraphStruct *tecoalGraph_t;
+
+struct tecoalHostStreamStruct;
+typedef struct tecoalHostStreamStruct *tecoalHostStream_t;
+
+struct tecoalEventStruct;
+typedef struct tecoalEventStruct *tecoalEvent_t;
+
+// streamId is an sdaa stream for the device backend, or a tecoalHostStream_t cast to
+// sdaaStream_t, which does what tecoalSetHostStream does. tecoalGetStream returns the sdaa
+// stream only.
 tecoalStatus_t TECOALWINAPI tecoalSetStream(tecoalHandle_t handle, sdaaStream_t streamId);
 tecoalStatus_t TECOALWINAPI tecoalGetStream(tecoalHandle_t handle, sdaaStream_t *streamId);
 
@@ -156,15 +199,162 @@ tecoalStatus_t TECOALWINAPI tecoalCreate(tecoalHandle_t *handle);
 
 tecoalStatus_t TECOALWINAPI tecoalDestroy(tecoalHandle_t handle);
 
+// Switching the backend does not invalidate the dispatch cache or recorded graphs; every entry
+// and graph node remembers the backend it was resolved for.
+tecoalStatus_t TECOALWINAPI tecoalSetBackend(tecoalHandle_t handle, tecoalBackend_t backend);
+tecoalStatus_t TECOALWINAPI tecoalGetBackend(tecoalHandle_t handle, tecoalBackend_t *backend);
+
+// Threads of the CPU backend. Handles share one process-wide pool with as many threads as a
+// handle has SPEs (spe_num), so work splits as it would over the SPEs, unless they get their
+// own: threadNum > 0 threads, the calling thread included, or spe_num threads when threadNum
+// is 0. A pool runs the ops of several threads or host streams at once. A negative threadNum
+// returns the handle to the shared pool. With cpuNum > 0 the pool's threads are pinned
+// round-robin to the cpus in cpuSet.
+tecoalStatus_t TECOALWINAPI tecoalSetHostThreads(tecoalHandle_t handle, int threadNum,
+                                                 const int *cpuSet, int cpuNum);
+
+// Host streams make the ops of a TECOAL_BACKEND_CPU handle asynchronous: the op call checks,
+// dispatches and queues the kernel, a thread of the stream runs it later on the handle's pool.
+// Streams keep their order and overlap each other. Operands must stay valid until the stream
+// has run the op. A stream may be shared by several handles; unset it from every handle before
+// destroying it, which waits for the queued work. tecoalSetStream also takes a host stream.
+tecoalStatus_t TECOALWINAPI tecoalCreateHostStream(tecoalHostStream_t *stream);
+tecoalStatus_t TECOALWINAPI tecoalDestroyHostStream(tecoalHostStream_t stream);
+// stream = NULL runs host kernels inside the op call again
+tecoalStatus_t TECOALWINAPI tecoalSetHostStream(tecoalHandle_t handle, tecoalHostStream_t stream);
+tecoalStatus_t TECOALWINAPI tecoalGetHostStream(tecoalHandle_t handle, tecoalHostStream_t *stream);
+// Waits for everything issued on the handle's host stream, and on its device stream for the
+// device backend. TECOAL_STATUS_EXECUTION_FAILED reports queued work that failed since the
+// previous call.
+tecoalStatus_t TECOALWINAPI tecoalStreamSynchronize(tecoalHandle_t handle);
+
+// An event marks a point of the handle's stream and is stamped once the stream gets there. On
+// the device backend it is an sdaa event recorded on the device stream, so recording does not
+// wait. Elapsed time is in milliseconds and waits for both events; it needs two host or two
+// device records. An event that was never recorded gives TECOAL_STATUS_BAD_PARAM.
+tecoalStatus_t TECOALWINAPI tecoalCreateEvent(tecoalEvent_t *event);
+tecoalStatus_t TECOALWINAPI tecoalDestroyEvent(tecoalEvent_t event);
+tecoalStatus_t TECOALWINAPI tecoalEventRecord(tecoalHandle_t handle, tecoalEvent_t event);
+tecoalStatus_t TECOALWINAPI tecoalEventSynchronize(tecoalEvent_t event);
+tecoalStatus_t TECOALWINAPI tecoalEventElapsedTime(float *ms, tecoalEvent_t start,
+                                                   tecoalEvent_t end);
+
 tecoalStatus_t TECOALWINAPI tecoalGetVersion(tecoalHandle_t handle, int *version);
 
 const char *tecoalGetErrorString(tecoalStatus_t status);
 
+// Every handle memoizes kernel selection per (op, dtypes, dims, strides, algo); these expose and
+// reset the hit/miss counters of that cache.
+tecoalStatus_t TECOALWINAPI tecoalGetDispatchCacheStats(tecoalHandle_t handle, uint64_t *hits,
+                                                        uint64_t *misses);
+tecoalStatus_t TECOALWINAPI tecoalClearDispatchCache(tecoalHandle_t handle);
+
+// Scratch owned by the handle, device memory for TECOAL_BACKEND_DEVICE and host memory for
+// TECOAL_BACKEND_CPU. Ops needing temporaries (the host unique's sort buffer, a convolution
+// called without a workspace) take them from it, so size it once from the peak usage seen during
+// warm-up. The peak includes requests that did not fit; those fall back to a per-call buffer.
+tecoalStatus_t TECOALWINAPI tecoalSetWorkspace(tecoalHandle_t handle, void *workSpace,
+                                               size_t workSpaceSizeInBytes);
+tecoalStatus_t TECOALWINAPI tecoalGetWorkspacePeakUsage(tecoalHandle_t handle,
+                                                        size_t *peakSizeInBytes);
+tecoalStatus_t TECOALWINAPI tecoalResetWorkspacePeakUsage(tecoalHandle_t handle);
+
+// Between tecoalBeginCapture and tecoalEndCapture, op calls on the handle are validated and
+// dispatched as usual but recorded into a graph instead of launched. tecoalGraphLaunch replays
+// the graph on the handle's stream; tecoalGraphUpdatePointer rebinds every recorded use of a
+// device buffer, e.g. the input and output of the next step. A pointer array (grouped or
+// batched GEMM) is rebound as a whole, also where the op ran as several launches over slices of
+// it; the pointers inside the array are read at every replay. Graphs also capture the addresses
+// ops took from the buffer of tecoalSetWorkspace, so keep it set while they are in use. On a
+// handle with a host stream and the CPU backend the replay is queued there and reads the graph
+// only when the stream reaches it; updating or destroying the graph waits for such queued
+// replays.
+tecoalStatus_t TECOALWINAPI tecoalBeginCapture(tecoalHandle_t handle);
+tecoalStatus_t TECOALWINAPI tecoalEndCapture(tecoalHandle_t handle, tecoalGraph_t *graph);
+tecoalStatus_t TECOALWINAPI tecoalGraphLaunch(tecoalHandle_t handle, const tecoalGraph_t graph);
+tecoalStatus_t TECOALWINAPI tecoalGraphUpdatePointer(tecoalGraph_t graph, const void *oldPtr,
+                                                     void *newPtr);
+tecoalStatus_t TECOALWINAPI tecoalDestroyGraph(tecoalGraph_t graph);
+
+// Process-wide kernel tracing, also enabled by TECOAL_PROFILE=<file>, which dumps at exit. Each
+// launch records op, kernel, algo, shape and thread; enabled tracing waits for every kernel.
+// The dump is Chrome trace JSON for chrome://tracing or Perfetto.
+tecoalStatus_t TECOALWINAPI tecoalSetProfiling(bool enable);
+tecoalStatus_t TECOALWINAPI tecoalDumpProfile(const char *path);
+
+// Per-kernel counters of the launches made through a handle, switched on for all handles by
+// tecoalSetOpStats or TECOAL_OP_STATS=1. Device kernels are timed with events on the stream, so
+// counting does not wait for them; tecoalGetOpStats waits for the ones counted so far. Pass
+// stats = NULL to get only the number of entries.
+tecoalStatus_t TECOALWINAPI tecoalSetOpStats(bool enable);
+tecoalStatus_t TECOALWINAPI tecoalGetOpStats(tecoalHandle_t handle, const int requestedCount,
+                                             int *returnedCount, tecoalOpStats_t *stats);
+tecoalStatus_t TECOALWINAPI tecoalResetOpStats(tecoalHandle_t handle);
+
+// Process-wide tuning database: the algo and tile choices recorded by the tecoalFind*Algorithm
+// calls, consulted whenever TECOAL_ALGO_BEST is requested. A file named by the TECOAL_TUNING_DB
+// environment variable is mapped by the first tecoalCreate; loading replaces the current content.
+tecoalStatus_t TECOALWINAPI tecoalLoadTuningDatabase(const char *path);
+tecoalStatus_t TECOALWINAPI tecoalSaveTuningDatabase(const char *path);
+
+// Row-major C = alpha * op(A) * op(B) + beta * C with op(A) m x k and op(B) k x n. A is stored
+// m x k for TECOAL_OP_N and k x m for TECOAL_OP_T, B k x n and n x k; TECOAL_OP_C is TECOAL_OP_T.
 tecoalStatus_t TECOALWINAPI tecoalHgemm(tecoalHandle_t handle, tecoalOperation_t transa,
                                         tecoalOperation_t transb, int m, int n, int k, float alpha,
                                         const void *A, int lda, const void *B, int ldb, float beta,
                                         void *C, int ldc, tecoalAlgo_t algo);
 
+// tecoalHgemm on bfloat16 A, B and C with float accumulation; host backend only for now.
+tecoalStatus_t TECOALWINAPI tecoalBgemm(tecoalHandle_t handle, tecoalOperation_t transa,
+                                        tecoalOperation_t transb, int m, int n, int k, float alpha,
+                                        const void *A, int lda, const void *B, int ldb, float beta,
+                                        void *C, int ldc, tecoalAlgo_t algo);
+
+// tecoalHgemm with A, B and C of their own types, accumulated in computeType. Supported are half
+// A and B with half or float C, float A, B and C, and bfloat16 A and B with bfloat16 or float C;
+// computeType must be TECOAL_DATA_FLOAT. On TECOAL_BACKEND_DEVICE float and bfloat16 inputs
+// run on TECOAL_ALGO_0 only and need float C; bfloat16 C is host backend only.
+tecoalStatus_t TECOALWINAPI tecoalGemmEx(tecoalHandle_t handle, tecoalOperation_t transa,
+                                         tecoalOperation_t transb, int m, int n, int k,
+                                         float alpha, const void *A, tecoalDataType_t Atype,
+                                         int lda, const void *B, tecoalDataType_t Btype, int ldb,
+                                         float beta, void *C, tecoalDataType_t Ctype, int ldc,
+                                         tecoalDataType_t computeType, tecoalAlgo_t algo);
+
+// batchCount tecoalHgemm problems in one launch, entry i at A + i * strideA, B + i * strideB and
+// C + i * strideC (in elements).
+tecoalStatus_t TECOALWINAPI tecoalHgemmStridedBatched(
+    tecoalHandle_t handle, tecoalOperation_t transa, tecoalOperation_t transb, int m, int n, int k,
+    float alpha, const void *A, int lda, long long strideA, const void *B, int ldb,
+    long long strideB, float beta, void *C, int ldc, long long strideC, int batchCount,
+    tecoalAlgo_t algo);
+
+// As above with entry i at Aarray[i], Barray[i] and Carray[i]. The arrays are read where the
+// backend runs: device memory for TECOAL_BACKEND_DEVICE, host memory for TECOAL_BACKEND_CPU.
+tecoalStatus_t TECOALWINAPI tecoalHgemmBatched(tecoalHandle_t handle, tecoalOperation_t transa,
+                                               tecoalOperation_t transb, int m, int n, int k,
+                                               float alpha, const void *const Aarray[], int lda,
+                                               const void *const Barray[], int ldb, float beta,
+                                               void *const Carray[], int ldc, int batchCount,
+                                               tecoalAlgo_t algo);
+
+// groupCount independent tecoalHgemm problems with their own sizes, for example one per expert of
+// a mixture-of-experts layer. m, n, k and the leading dimensions are host arrays; A, B and C are
+// read where the backend runs, as for tecoalHgemmBatched. Groups with m, n or k of 0 are allowed.
+tecoalStatus_t TECOALWINAPI tecoalHgemmGrouped(tecoalHandle_t handle, tecoalOperation_t transa,
+                                               tecoalOperation_t transb, int groupCount,
+                                               const int m[], const int n[], const int k[],
+                                               float alpha, const void *const A[],
+                                               const int lda[], const void *const B[],
+                                               const int ldb[], float beta, void *const C[],
+                                               const int ldc[], tecoalAlgo_t algo);
+
+// Same as tecoalFindConvolutionForwardAlgorithm for tecoalHgemm; C is overwritten.
+tecoalStatus_t TECOALWINAPI tecoalFindHgemmAlgorithm(
+    tecoalHandle_t handle, tecoalOperation_t transa, tecoalOperation_t transb, int m, int n, int k,
+    float alpha, const void *A, int lda, const void *B, int ldb, float beta, void *C, int ldc,
+    const int requestedAlgoCount, int *returnedAlgoCount, tecoalAlgoPerf_t *perfResults);
+
 typedef struct tecoalTensorStruct *tecoalTensorDescriptor_t;
 typedef struct tecoalConvolutionStruct *tecoalConvolutionDescriptor_t;
 typedef struct tecoalFilterStruct *tecoalFilterDescriptor_t;
@@ -268,6 +458,16 @@ tecoalStatus_t TECOALWINAPI tecoalConvolutionForward(
     const tecoalConvolutionDescriptor_t convDesc, tecoalAlgo_t algo, void *workSpace,
     size_t workSpaceSizeInBytes, const void *beta, const tecoalTensorDescriptor_t yDesc, void *y);
 
+// Run and time every forward convolution algorithm on the given problem and buffers; y is
+// overwritten. Results are sorted fastest first, failed algorithms last. The fastest one is
+// remembered on the handle and used when TECOAL_ALGO_BEST is passed for the same problem.
+tecoalStatus_t TECOALWINAPI tecoalFindConvolutionForwardAlgorithm(
+    tecoalHandle_t handle, const tecoalTensorDescriptor_t xDesc, const void *x,
+    const tecoalFilterDescriptor_t wDesc, const void *w,
+    const tecoalConvolutionDescriptor_t convDesc, const tecoalTensorDescriptor_t yDesc, void *y,
+    const int requestedAlgoCount, int *returnedAlgoCount, tecoalAlgoPerf_t *perfResults,
+    void *workSpace, size_t workSpaceSizeInBytes);
+
 // Scale all values of a tensor by a given factor : y[i] = alpha * y[i]
 tecoalStatus_t TECOALWINAPI tecoalScaleTensor(tecoalHandle_t handle,
                                               const tecoalTensorDescriptor_t yDesc, void *y,
@@ -363,6 +563,13 @@ tecoalStatus_t TECOALWINAPI tecoalLogicalNotTensor(tecoalHandle_t handle,
                                                    const void *A,
                                                    const tecoalTensorDescriptor_t cDesc, void *C,
                                                    tecoalAlgo_t algo);
+
+// y = x converted to the type of yDesc, same shape. Supported pairs are float <-> bfloat16 and
+// half <-> bfloat16, rounded to nearest even.
+tecoalStatus_t TECOALWINAPI tecoalCastTensor(tecoalHandle_t handle,
+                                             const tecoalTensorDescriptor_t xDesc, const void *x,
+                                             const tecoalTensorDescriptor_t yDesc, void *y,
+                                             tecoalAlgo_t algo);
 typedef enum {
     TECOAL_NOT_PROPAGATE_NAN = 0,
     TECOAL_PROPAGATE_NAN = 1,
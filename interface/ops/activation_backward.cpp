@@ -34,15 +34,20 @@ using tecoal::ual::ops::ActivationBwdOp;
 using tecoal::ual::args::ActivationBwdArgs;
 using tecoal::ual::args::ActivationBwdPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 tecoalStatus_t TECOALWINAPI tecoalActivationBackward(
     tecoalHandle_t handle, tecoalActivationDescriptor_t activationDesc, const void *alpha,
     const tecoalTensorDescriptor_t yDesc, const void *y, const tecoalTensorDescriptor_t dyDesc,
     const void *dy, const tecoalTensorDescriptor_t xDesc, const void *x, const void *beta,
     const tecoalTensorDescriptor_t dxDesc, void *dx, tecoalAlgo_t algo) {
+    if (activationDesc->mode != TECOAL_ACTIVATION_SILU) {
+        WARNING("activation mode %d is not supported\n", (int)activationDesc->mode);
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
     ActivationBwdArgs abarg;
     abarg.spe_num = handle->spe_num;
-    abarg.data_num = xDesc->n * xDesc->h * xDesc->w * xDesc->c;
+    abarg.data_num = (int)xDesc->elemNum;
     abarg.mode = activationDesc->mode;
     abarg.COEF = activationDesc->coef;
     abarg.x = x;
@@ -57,6 +62,11 @@ tecoalStatus_t TECOALWINAPI tecoalActivationBackward(
     abarg_patch.data_type = Convert::toUALDataType(xDesc->dataType);
     abarg_patch.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(ActivationBwdOp, abarg, abarg_patch, handle);
+    DispatchKey key(ActivationBwdOp::name());
+    key.add(xDesc);
+    key.add((int64_t)activationDesc->mode);
+    key.add((int64_t)algo);
+
+    RUN_OP(ActivationBwdOp, abarg, abarg_patch, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
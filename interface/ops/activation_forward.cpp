@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/activation_forward_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/activation_forward/activation_forward.hpp"
 
@@ -34,6 +35,9 @@ using tecoal::ual::ops::ActivationFwdOp;
 using tecoal::ual::args::ActivationFwdArgs;
 using tecoal::ual::args::ActivationFwdPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::coalesceDims;
 
 tecoalStatus_t TECOALWINAPI
 tecoalCreateActivationDescriptor(tecoalActivationDescriptor_t *activationDesc) {
@@ -93,10 +97,24 @@ tecoalStatus_t TECOALWINAPI tecoalActivationForward(
     tecoalHandle_t handle, tecoalActivationDescriptor_t activationDesc, const void *alpha,
     const tecoalTensorDescriptor_t xDesc, const void *x, const void *beta,
     const tecoalTensorDescriptor_t yDesc, void *y, tecoalAlgo_t algo) {
+    if (activationDesc->mode != TECOAL_ACTIVATION_SILU) {
+        WARNING("activation mode %d is not supported\n", (int)activationDesc->mode);
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+    const tecoalTensorStruct *descs[] = {yDesc, xDesc};
+    CoalescedShape shape;
+    if (coalesceDims(descs, 2, &shape) != TECOAL_STATUS_SUCCESS || !shape.isRows()) {
+        WARNING("activation forward x and y do not coalesce to unit-stride rows\n");
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+
     // define ops args
     ActivationFwdArgs arg;
     arg.spe_num = handle->spe_num;
-    arg.data_num = xDesc->n * xDesc->c * xDesc->h * xDesc->w;
+    arg.data_num = shape.cols();
+    arg.row_num = shape.rows();
+    arg.y_row_stride = shape.rowStride(0);
+    arg.x_row_stride = shape.rowStride(1);
     arg.mode = (int)(activationDesc->mode);
     arg.coef = (double)(activationDesc->coef);
     arg.alpha = *reinterpret_cast<const float *>(alpha);
@@ -111,6 +129,12 @@ tecoalStatus_t TECOALWINAPI tecoalActivationForward(
     patch_arg.tab_B = activationDesc->tab_B;
     patch_arg.data_type = Convert::toUALDataType(xDesc->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
-    RUN_OP(ActivationFwdOp, arg, patch_arg, handle);
+
+    DispatchKey key(ActivationFwdOp::name());
+    key.add(xDesc);
+    key.add(yDesc);
+    key.add((int64_t)activationDesc->mode);
+    key.add((int64_t)algo);
+    RUN_OP(ActivationFwdOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
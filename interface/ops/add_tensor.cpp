@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/add_tensor_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/add_tensor/add_tensor.hpp"
 
@@ -34,6 +35,9 @@ using tecoal::ual::ops::AddTensorOp;
 using tecoal::ual::args::AddTensorArgs;
 using tecoal::ual::args::AddTensorPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::broadcastDims;
 
 tecoalStatus_t TECOALWINAPI tecoalAddTensor(tecoalHandle_t handle, const void *alpha,
                                             const tecoalTensorDescriptor_t aDesc, const void *A,
@@ -48,6 +52,24 @@ tecoalStatus_t TECOALWINAPI tecoalAddTensor(tecoalHandle_t handle, const void *a
     arg.a_hw_num = aDesc->h * aDesc->w;
     arg.c_hw_num = cDesc->h * cDesc->w;
     arg.format = cDesc->format;
+    // A broadcasts to C, never the other way round
+    const tecoalTensorStruct *descs[] = {cDesc, aDesc};
+    CoalescedShape shape;
+    arg.data_num = 0;
+    arg.row_num = 0;
+    arg.c_row_stride = 0;
+    arg.a_row_stride = 0;
+    arg.plan.nb_dims = 0;
+    if (broadcastDims(descs, 2, false, &shape) == TECOAL_STATUS_SUCCESS &&
+        shape.elemNum == cDesc->elemNum) {
+        shape.toPlan(&arg.plan);
+        if (shape.isRows()) {
+            arg.data_num = shape.cols();
+            arg.row_num = shape.rows();
+            arg.c_row_stride = shape.rowStride(0);
+            arg.a_row_stride = shape.rowStride(1);
+        }
+    }
     arg.alpha = *reinterpret_cast<const float *>(alpha);
     arg.beta = *reinterpret_cast<const float *>(beta);
     arg.A = A;
@@ -60,6 +82,11 @@ tecoalStatus_t TECOALWINAPI tecoalAddTensor(tecoalHandle_t handle, const void *a
     patch_arg.data_type = Convert::toUALDataType(aDesc->dataType);
 
     // Execute the tensor addition operation
-    RUN_OP(AddTensorOp, arg, patch_arg, handle);
+    DispatchKey key(AddTensorOp::name());
+    key.add(aDesc);
+    key.add(cDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(AddTensorOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
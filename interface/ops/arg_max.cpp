@@ -34,6 +34,7 @@ using tecoal::ual::ops::ArgMaxOp;
 using tecoal::ual::args::ArgMaxArgs;
 using tecoal::ual::args::ArgMaxPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 tecoalStatus_t TECOALWINAPI tecoalArgmax(tecoalHandle_t handle, const int axis,
                                          const tecoalTensorDescriptor_t xDesc, const void *x,
@@ -84,6 +85,11 @@ tecoalStatus_t TECOALWINAPI tecoalArgmax(tecoalHandle_t handle, const int axis,
     patch_arg.algo = Convert::toUalAlgoType(algo);
     patch_arg.data_type = Convert::toUALDataType(xDesc->dataType);
 
-    RUN_OP(ArgMaxOp, arg, patch_arg, handle);
+    DispatchKey key(ArgMaxOp::name());
+    key.add(xDesc);
+    key.add((int64_t)axis);
+    key.add((int64_t)algo);
+
+    RUN_OP(ArgMaxOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -0,0 +1,77 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "interface/include/tecoal.h"
+#include "interface/include/builtin_type.h"
+#include "ual/args/cast_tensor_args.h"
+#include "interface/common/coalesce.h"
+#include "interface/common/marco.h"
+#include "ual/ops/cast_tensor/cast_tensor.hpp"
+
+using tecoal::ual::ops::CastTensorOp;
+using tecoal::ual::args::CastTensorArgs;
+using tecoal::ual::args::CastTensorPatchArgs;
+using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::coalesceDims;
+
+tecoalStatus_t TECOALWINAPI tecoalCastTensor(tecoalHandle_t handle,
+                                             const tecoalTensorDescriptor_t xDesc, const void *x,
+                                             const tecoalTensorDescriptor_t yDesc, void *y,
+                                             tecoalAlgo_t algo) {
+    const tecoalTensorStruct *descs[] = {yDesc, xDesc};
+    CoalescedShape shape;
+    if (coalesceDims(descs, 2, &shape) != TECOAL_STATUS_SUCCESS || !shape.isRows()) {
+        WARNING("cast x and y do not coalesce to unit-stride rows\n");
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+
+    CastTensorArgs arg;
+    arg.spe_num = handle->spe_num;
+    arg.x = x;
+    arg.y = y;
+    arg.data_num = shape.cols();
+    arg.row_num = shape.rows();
+    arg.y_row_stride = shape.rowStride(0);
+    arg.x_row_stride = shape.rowStride(1);
+    arg.x_size = Convert::toDescDataTypeSize(xDesc->dataType);
+    arg.y_size = Convert::toDescDataTypeSize(yDesc->dataType);
+
+    CastTensorPatchArgs patch_arg;
+    patch_arg.args = &arg;
+    patch_arg.x_type = Convert::toUALDataType(xDesc->dataType);
+    patch_arg.y_type = Convert::toUALDataType(yDesc->dataType);
+    patch_arg.algo = Convert::toUalAlgoType(algo);
+
+    DispatchKey key(CastTensorOp::name());
+    key.add(xDesc);
+    key.add(yDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(CastTensorOp, arg, patch_arg, handle, key);
+    return TECOAL_STATUS_SUCCESS;
+}
@@ -27,11 +27,19 @@
 #include "interface/include/builtin_type.h"
 #include "interface/common/check.h"
 #include "interface/common/marco.h"
+#include "interface/common/algo_perf.h"
+#include "ual/ops/tuning_db.h"
 #include "ual/ops/conv_forward/conv_forward.hpp"
 
 using tecoal::ual::args::ConvFwdArgs;
 using tecoal::ual::args::ConvFwdPatchArgs;
 using tecoal::ual::ops::ConvFwdOp;
+using tecoal::ual::ops::ConvFwdAlgos;
+using tecoal::ual::ops::findConvForwardBranch;
+using tecoal::ual::ops::findConvForwardWorkspace;
+using tecoal::ual::ops::getConvForwardTuningKey;
+using tecoal::ual::ops::TuningDatabase;
+using tecoal::ual::ops::TuningRecord;
 using namespace tecoal;
 
 static tecoalStatus_t getConvFwdArgs(tecoalHandle_t handle, const tecoalTensorDescriptor_t xDesc,
@@ -70,6 +78,17 @@ static tecoalStatus_t getConvFwdArgs(tecoalHandle_t handle, const tecoalTensorDe
     return TECOAL_STATUS_SUCCESS;
 }
 
+// Dispatch key of a forward convolution problem, without the algo
+static void getConvFwdKey(const tecoalTensorDescriptor_t xDesc,
+                          const tecoalFilterDescriptor_t wDesc,
+                          const tecoalConvolutionDescriptor_t convDesc,
+                          const tecoalTensorDescriptor_t yDesc, DispatchKey *key) {
+    key->add(xDesc);
+    key->add(wDesc);
+    key->add(convDesc);
+    key->add(yDesc);
+}
+
 // Create an instance of convolution descriptor
 tecoalStatus_t TECOALWINAPI
 tecoalCreateConvolutionDescriptor(tecoalConvolutionDescriptor_t *convDesc) {
@@ -178,16 +197,98 @@ tecoalStatus_t TECOALWINAPI tecoalConvolutionForward(
     // Validate and retrieve the convolution operation arguments based on descriptors
     checkTecoalStatus(getConvFwdArgs(handle, xDesc, wDesc, convDesc, yDesc, &arg, &args_patch));
 
+    DispatchKey key(ConvFwdOp::name());
+    getConvFwdKey(xDesc, wDesc, convDesc, yDesc, &key);
+    algo = handle->dispatch_cache->resolveAlgo(key, algo);
+    key.add((int64_t)algo);
+    args_patch.algo = Convert::toUalAlgoType(algo);
+
+    // Without a caller workspace, scratch comes from the handle's arena
+    tecoal::WorkspaceScope scope(&handle->workspace);
+    if (workSpace == nullptr) {
+        workSpaceSizeInBytes = findConvForwardWorkspace(&args_patch);
+        if (workSpaceSizeInBytes > 0) {
+            workSpace = handle->workspace.alloc(workSpaceSizeInBytes);
+            if (workSpace == nullptr) return TECOAL_STATUS_ALLOC_FAILED;
+        }
+    }
+
     // Assign data to arguments
     arg.x = x;
     arg.w = w;
     arg.y = y;
     arg.workSpace = workSpace;
     arg.workSpaceSize = workSpaceSizeInBytes;
-    args_patch.algo = Convert::toUalAlgoType(algo);
 
     // Execute the forward convolution operation
-    RUN_OP(ConvFwdOp, arg, args_patch, handle);
+    RUN_OP(ConvFwdOp, arg, args_patch, handle, key);
+
+    return TECOAL_STATUS_SUCCESS;
+}
+
+// Run every forward convolution algorithm on the caller's buffers and rank them by time
+tecoalStatus_t TECOALWINAPI tecoalFindConvolutionForwardAlgorithm(
+    tecoalHandle_t handle, const tecoalTensorDescriptor_t xDesc, const void *x,
+    const tecoalFilterDescriptor_t wDesc, const void *w,
+    const tecoalConvolutionDescriptor_t convDesc, const tecoalTensorDescriptor_t yDesc, void *y,
+    const int requestedAlgoCount, int *returnedAlgoCount, tecoalAlgoPerf_t *perfResults,
+    void *workSpace, size_t workSpaceSizeInBytes) {
+    if (!handle || !returnedAlgoCount || !perfResults || requestedAlgoCount <= 0) {
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    // timing needs real launches of the device algorithms
+    if (handle->capture != nullptr || handle->backend != TECOAL_BACKEND_DEVICE) {
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
 
+    ConvFwdArgs arg;
+    ConvFwdPatchArgs args_patch;
+    checkTecoalStatus(getConvFwdArgs(handle, xDesc, wDesc, convDesc, yDesc, &arg, &args_patch));
+    arg.x = x;
+    arg.w = w;
+    arg.y = y;
+
+    std::vector<tecoalAlgoPerf_t> perfs;
+    const int algo_num = sizeof(ConvFwdAlgos) / sizeof(ConvFwdAlgos[0]);
+    for (int i = 0; i < algo_num; i++) {
+        tecoalAlgoPerf_t perf;
+        perf.algo = (tecoalAlgo_t)i;
+        perf.time = -1;
+        args_patch.algo = Convert::toUalAlgoType(perf.algo);
+        perf.memory = findConvForwardWorkspace(&args_patch);
+
+        // Without a caller workspace, each candidate borrows its scratch from the arena
+        tecoal::WorkspaceScope scope(&handle->workspace);
+        arg.workSpace = workSpace;
+        arg.workSpaceSize = workSpaceSizeInBytes;
+        if (workSpace == nullptr && perf.memory > 0) {
+            arg.workSpace = handle->workspace.alloc(perf.memory);
+            arg.workSpaceSize = arg.workSpace == nullptr ? 0 : perf.memory;
+        }
+
+        ConvFwdOp op{};
+        if (perf.memory > arg.workSpaceSize) {
+            perf.status = TECOAL_STATUS_ALLOC_FAILED;
+        } else if (findConvForwardBranch(&args_patch) == -1) {
+            perf.status = TECOAL_STATUS_NOT_SUPPORTED;
+        } else {
+            perf.status = Convert::toStatus(op.find(&args_patch));
+            if (perf.status == TECOAL_STATUS_SUCCESS) {
+                perf.status = timeAlgo(&op, &arg, handle->stream, &perf.time);
+            }
+        }
+        perfs.push_back(perf);
+    }
+    sortAlgoPerf(&perfs);
+
+    if (perfs[0].status == TECOAL_STATUS_SUCCESS) {
+        DispatchKey key(ConvFwdOp::name());
+        getConvFwdKey(xDesc, wDesc, convDesc, yDesc, &key);
+        handle->dispatch_cache->setBestAlgo(key, perfs[0].algo);
+
+        TuningRecord record = {getConvForwardTuningKey(&args_patch), perfs[0].algo, 0, 0, 0};
+        TuningDatabase::instance().update(record);
+    }
+    copyAlgoPerf(perfs, requestedAlgoCount, returnedAlgoCount, perfResults);
     return TECOAL_STATUS_SUCCESS;
 }
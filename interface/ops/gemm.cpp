@@ -28,18 +28,47 @@
 #include "interface/common/check.h"
 #include "ual/ops/gemm/gemm.hpp"
 #include "interface/common/marco.h"
+#include "interface/common/algo_perf.h"
+#include "ual/ops/tuning_db.h"
 
 using tecoal::ual::args::GEMMArgs;
 using tecoal::ual::args::GEMMPatchArgs;
 using tecoal::ual::ops::GEMMOp;
+using tecoal::ual::ops::GEMMAlgos;
+using tecoal::ual::ops::findGEMMBranch;
+using tecoal::ual::ops::getGEMMTuningKey;
+using tecoal::ual::ops::TuningDatabase;
+using tecoal::ual::ops::TuningRecord;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::timeAlgo;
+using tecoal::sortAlgoPerf;
+using tecoal::copyAlgoPerf;
 
-tecoalStatus_t TECOALWINAPI tecoalHgemm(tecoalHandle_t handle, tecoalOperation_t transa,
-                                        tecoalOperation_t transb, int m, int n, int k, float alpha,
-                                        const void *A, int lda, const void *B, int ldb, float beta,
-                                        void *C, int ldc, tecoalAlgo_t algo) {
-    // Initialize and fill the structure with tensor operation arguments
-    GEMMArgs args;
+// Dispatch key of a gemm problem, everything findGEMMBranch looks at except the algo
+static void getGemmKey(const GEMMArgs &args, tecoalOperation_t transa, tecoalOperation_t transb,
+                       DispatchKey *key) {
+    key->add((int64_t)args.Atype);
+    key->add((int64_t)args.Btype);
+    key->add((int64_t)args.Ctype);
+    key->add((int64_t)transa);
+    key->add((int64_t)transb);
+    key->add((int64_t)args.m);
+    key->add((int64_t)args.n);
+    key->add((int64_t)args.k);
+    key->add((int64_t)args.lda);
+    key->add((int64_t)args.ldb);
+    key->add((int64_t)args.ldc);
+    key->add((double)args.alpha);
+    key->add((double)args.beta);
+    key->add((int64_t)args.batch);
+}
+
+// A single problem with A, B and C all of type dtype; the batched entry points fill in the rest
+static GEMMArgs getGemmArgs(tecoalOperation_t transa, tecoalOperation_t transb, int m, int n,
+                            int k, float alpha, int lda, int ldb, float beta, int ldc,
+                            UALDataType dtype) {
+    GEMMArgs args = {};
     args.m = m;
     args.n = n;
     args.k = k;
@@ -49,21 +78,171 @@ tecoalStatus_t TECOALWINAPI tecoalHgemm(tecoalHandle_t handle, tecoalOperation_t
     args.alpha = alpha;
     args.beta = beta;
     args.batch = 1;
+    args.Atype = dtype;
+    args.Btype = dtype;
+    args.Ctype = dtype;
+    args.transa = Convert::toUALOperation(transa);
+    args.transb = Convert::toUALOperation(transb);
+    return args;
+}
+
+// Accumulated in float; the whole batch is one op and so one kernel launch
+static tecoalStatus_t runGemm(tecoalHandle_t handle, tecoalOperation_t transa,
+                              tecoalOperation_t transb, GEMMArgs args, tecoalAlgo_t algo) {
+    if (args.batch == 0) return TECOAL_STATUS_SUCCESS;
+
+    // Initialize patch arguments structure for additional configurations
+    GEMMPatchArgs patch_args;
+    patch_args.gemm_args = &args;
+    patch_args.transa = args.transa;
+    patch_args.transb = args.transb;
+
+    DispatchKey key(GEMMOp::name());
+    getGemmKey(args, transa, transb, &key);
+    algo = handle->dispatch_cache->resolveAlgo(key, algo);
+    key.add((int64_t)algo);
+    patch_args.algo = Convert::toUalAlgoType(algo);
+
+    // Execute GEMM operation
+    RUN_OP(GEMMOp, args, patch_args, handle, key);
+    return TECOAL_STATUS_SUCCESS;
+}
+
+tecoalStatus_t TECOALWINAPI tecoalHgemm(tecoalHandle_t handle, tecoalOperation_t transa,
+                                        tecoalOperation_t transb, int m, int n, int k, float alpha,
+                                        const void *A, int lda, const void *B, int ldb, float beta,
+                                        void *C, int ldc, tecoalAlgo_t algo) {
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                UALDataType::UAL_DTYPE_HALF);
+    args.A = A;
+    args.B = B;
+    args.C = C;
+    return runGemm(handle, transa, transb, args, algo);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalBgemm(tecoalHandle_t handle, tecoalOperation_t transa,
+                                        tecoalOperation_t transb, int m, int n, int k, float alpha,
+                                        const void *A, int lda, const void *B, int ldb, float beta,
+                                        void *C, int ldc, tecoalAlgo_t algo) {
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                UALDataType::UAL_DTYPE_BFLOAT16);
+    args.A = A;
+    args.B = B;
+    args.C = C;
+    return runGemm(handle, transa, transb, args, algo);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalHgemmStridedBatched(
+    tecoalHandle_t handle, tecoalOperation_t transa, tecoalOperation_t transb, int m, int n, int k,
+    float alpha, const void *A, int lda, long long strideA, const void *B, int ldb,
+    long long strideB, float beta, void *C, int ldc, long long strideC, int batchCount,
+    tecoalAlgo_t algo) {
+    if (batchCount < 0) return TECOAL_STATUS_BAD_PARAM;
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                UALDataType::UAL_DTYPE_HALF);
+    args.A = A;
+    args.B = B;
+    args.C = C;
+    args.strideA = strideA;
+    args.strideB = strideB;
+    args.strideC = strideC;
+    args.batch = batchCount;
+    return runGemm(handle, transa, transb, args, algo);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalHgemmBatched(tecoalHandle_t handle, tecoalOperation_t transa,
+                                               tecoalOperation_t transb, int m, int n, int k,
+                                               float alpha, const void *const Aarray[], int lda,
+                                               const void *const Barray[], int ldb, float beta,
+                                               void *const Carray[], int ldc, int batchCount,
+                                               tecoalAlgo_t algo) {
+    if (batchCount < 0) return TECOAL_STATUS_BAD_PARAM;
+    if (batchCount > 0 && (!Aarray || !Barray || !Carray)) return TECOAL_STATUS_BAD_PARAM;
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                UALDataType::UAL_DTYPE_HALF);
+    args.Aarray = Aarray;
+    args.Barray = Barray;
+    args.Carray = Carray;
+    args.batch = batchCount;
+    return runGemm(handle, transa, transb, args, algo);
+}
+
+tecoalStatus_t TECOALWINAPI tecoalGemmEx(tecoalHandle_t handle, tecoalOperation_t transa,
+                                         tecoalOperation_t transb, int m, int n, int k,
+                                         float alpha, const void *A, tecoalDataType_t Atype,
+                                         int lda, const void *B, tecoalDataType_t Btype, int ldb,
+                                         float beta, void *C, tecoalDataType_t Ctype, int ldc,
+                                         tecoalDataType_t computeType, tecoalAlgo_t algo) {
+    // every kernel accumulates in float; which A/B/C combinations run is up to the op
+    if (computeType != TECOAL_DATA_FLOAT) return TECOAL_STATUS_NOT_SUPPORTED;
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                Convert::toUALDataType(Atype));
+    args.Btype = Convert::toUALDataType(Btype);
+    args.Ctype = Convert::toUALDataType(Ctype);
+    args.A = A;
+    args.B = B;
+    args.C = C;
+    return runGemm(handle, transa, transb, args, algo);
+}
+
+// Run every hgemm algorithm on the caller's buffers and rank them by time
+tecoalStatus_t TECOALWINAPI tecoalFindHgemmAlgorithm(
+    tecoalHandle_t handle, tecoalOperation_t transa, tecoalOperation_t transb, int m, int n, int k,
+    float alpha, const void *A, int lda, const void *B, int ldb, float beta, void *C, int ldc,
+    const int requestedAlgoCount, int *returnedAlgoCount, tecoalAlgoPerf_t *perfResults) {
+    if (!handle || !returnedAlgoCount || !perfResults || requestedAlgoCount <= 0) {
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    // timing needs real launches of the device algorithms
+    if (handle->capture != nullptr || handle->backend != TECOAL_BACKEND_DEVICE) {
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+
+    GEMMArgs args = getGemmArgs(transa, transb, m, n, k, alpha, lda, ldb, beta, ldc,
+                                UALDataType::UAL_DTYPE_HALF);
     args.A = A;
     args.B = B;
     args.C = C;
-    args.Atype = UALDataType::UAL_DTYPE_HALF;
-    args.Btype = UALDataType::UAL_DTYPE_HALF;
-    args.Ctype = UALDataType::UAL_DTYPE_HALF;
 
-    // Initialize patch arguments structure for additional configurations
     GEMMPatchArgs patch_args;
     patch_args.gemm_args = &args;
     patch_args.transa = Convert::toUALOperation(transa);
     patch_args.transb = Convert::toUALOperation(transb);
-    patch_args.algo = Convert::toUalAlgoType(algo);
 
-    // Execute GEMM operation
-    RUN_OP(GEMMOp, args, patch_args, handle);
+    std::vector<tecoalAlgoPerf_t> perfs;
+    const int algo_num = sizeof(GEMMAlgos) / sizeof(GEMMAlgos[0]);
+    for (int i = 0; i < algo_num; i++) {
+        tecoalAlgoPerf_t perf;
+        perf.algo = (tecoalAlgo_t)i;
+        perf.time = -1;
+        perf.memory = 0;
+        patch_args.algo = Convert::toUalAlgoType(perf.algo);
+
+        GEMMOp op{};
+        if (findGEMMBranch(&patch_args) == -1) {
+            perf.status = TECOAL_STATUS_NOT_SUPPORTED;
+        } else {
+            perf.status = Convert::toStatus(op.find(&patch_args));
+            if (perf.status == TECOAL_STATUS_SUCCESS) {
+                perf.status = timeAlgo(&op, &args, handle->stream, &perf.time);
+            }
+        }
+        perfs.push_back(perf);
+    }
+    sortAlgoPerf(&perfs);
+
+    if (perfs[0].status == TECOAL_STATUS_SUCCESS) {
+        DispatchKey key(GEMMOp::name());
+        getGemmKey(args, transa, transb, &key);
+        handle->dispatch_cache->setBestAlgo(key, perfs[0].algo);
+
+        // Persist the winner together with the tiles its branch picks
+        patch_args.algo = Convert::toUalAlgoType(perfs[0].algo);
+        findGEMMBranch(&patch_args);
+        TuningRecord record = {getGEMMTuningKey(&patch_args), perfs[0].algo, args.bM, args.bN,
+                               args.bK};
+        TuningDatabase::instance().update(record);
+    }
+    copyAlgoPerf(perfs, requestedAlgoCount, returnedAlgoCount, perfResults);
     return TECOAL_STATUS_SUCCESS;
 }
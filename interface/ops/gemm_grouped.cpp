@@ -0,0 +1,95 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "interface/include/builtin_type.h"
+#include "interface/common/check.h"
+#include "ual/ops/gemm_grouped/gemm_grouped.hpp"
+#include "interface/common/marco.h"
+
+using tecoal::ual::args::GEMMGroupedArgs;
+using tecoal::ual::args::GEMMGroupedPatchArgs;
+using tecoal::ual::ops::GEMMGroupedOp;
+using tecoal::Convert;
+using tecoal::DispatchKey;
+
+// Groups beyond GEMM_GROUPED_MAX run as further launches, each covering the next slice of the
+// arrays; every launch still schedules the tiles of all its groups together.
+tecoalStatus_t TECOALWINAPI tecoalHgemmGrouped(tecoalHandle_t handle, tecoalOperation_t transa,
+                                               tecoalOperation_t transb, int groupCount,
+                                               const int m[], const int n[], const int k[],
+                                               float alpha, const void *const A[],
+                                               const int lda[], const void *const B[],
+                                               const int ldb[], float beta, void *const C[],
+                                               const int ldc[], tecoalAlgo_t algo) {
+    if (groupCount < 0) return TECOAL_STATUS_BAD_PARAM;
+    if (groupCount == 0) return TECOAL_STATUS_SUCCESS;
+    if (!m || !n || !k || !A || !lda || !B || !ldb || !C || !ldc) return TECOAL_STATUS_BAD_PARAM;
+    for (int g = 0; g < groupCount; g++) {
+        if (m[g] < 0 || n[g] < 0 || k[g] < 0) return TECOAL_STATUS_BAD_PARAM;
+    }
+
+    for (int base = 0; base < groupCount; base += GEMM_GROUPED_MAX) {
+        const int count = std::min(GEMM_GROUPED_MAX, groupCount - base);
+        GEMMGroupedArgs args = {};
+        args.group_count = count;
+        args.group_base = base;
+        args.alpha = alpha;
+        args.beta = beta;
+        args.A = A + base;
+        args.B = B + base;
+        args.C = C + base;
+        args.Atype = UALDataType::UAL_DTYPE_HALF;
+        args.Btype = UALDataType::UAL_DTYPE_HALF;
+        args.Ctype = UALDataType::UAL_DTYPE_HALF;
+        args.transa = Convert::toUALOperation(transa);
+        args.transb = Convert::toUALOperation(transb);
+
+        GEMMGroupedPatchArgs patch_args;
+        patch_args.args = &args;
+
+        DispatchKey key(GEMMGroupedOp::name());
+        key.add((int64_t)transa);
+        key.add((int64_t)transb);
+        key.add((double)alpha);
+        key.add((double)beta);
+        key.add((int64_t)count);
+        for (int g = 0; g < count; g++) {
+            args.shapes[g] = {m[base + g], n[base + g], k[base + g],
+                              lda[base + g], ldb[base + g], ldc[base + g]};
+            key.add((int64_t)m[base + g]);
+            key.add((int64_t)n[base + g]);
+            key.add((int64_t)k[base + g]);
+            key.add((int64_t)lda[base + g]);
+            key.add((int64_t)ldb[base + g]);
+            key.add((int64_t)ldc[base + g]);
+        }
+        key.add((int64_t)algo);
+        patch_args.algo = Convert::toUalAlgoType(algo);
+
+        RUN_OP(GEMMGroupedOp, args, patch_args, handle, key);
+    }
+    return TECOAL_STATUS_SUCCESS;
+}
@@ -27,6 +27,7 @@
 #include <utility>
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/args/index_put_args.h"
 #include "ual/com/log.h"
@@ -36,6 +37,9 @@ using tecoal::ual::ops::IndexPutOp;
 using tecoal::ual::args::IndexPutArgs;
 using tecoal::ual::args::IndexPutPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::broadcastDims;
 
 static inline void reverse_array(int *array, int length) {
     int loop_cnt = length >> 1;
@@ -44,6 +48,48 @@ static inline void reverse_array(int *array, int length) {
     }
 }
 
+// Index tensors broadcast against each other. Values broadcast against the shape they are read
+// over, the broadcast index shape followed by the output dims that are not indexed.
+static tecoalStatus_t planIndexPut(int indices_length, const tecoalTensorDescriptor_t *indicesDesc,
+                                   const tecoalTensorDescriptor_t valuesDesc,
+                                   const tecoalTensorDescriptor_t outputDesc, IndexPutArgs *arg) {
+    if (indices_length <= 0 || indices_length > UAL_BROADCAST_OPERAND_MAX) {
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    CoalescedShape shape;
+    checkTecoalStatus(broadcastDims(indicesDesc, indices_length, true, &shape));
+    shape.toPlan(&arg->index_plan);
+
+    int index_nb = 0;
+    for (int k = 0; k < indices_length; k++) {
+        index_nb = indicesDesc[k]->nbDims > index_nb ? indicesDesc[k]->nbDims : index_nb;
+    }
+    int tail_nb = outputDesc->nbDims - indices_length;
+    if (tail_nb < 0 || index_nb + tail_nb > TECOAL_DIM_MAX) return TECOAL_STATUS_NOT_SUPPORTED;
+
+    int dims[TECOAL_DIM_MAX];
+    for (int i = 0; i < index_nb; i++) {
+        dims[i] = 1;
+        for (int k = 0; k < indices_length; k++) {
+            int idx = i - (index_nb - indicesDesc[k]->nbDims);
+            if (idx >= 0 && indicesDesc[k]->dimA[idx] != 1) dims[i] = indicesDesc[k]->dimA[idx];
+        }
+    }
+    for (int i = 0; i < tail_nb; i++) dims[index_nb + i] = outputDesc->dimA[indices_length + i];
+
+    tecoalTensorStruct target;
+    checkTecoalStatus(tecoalSetTensorNdDescriptor(&target, valuesDesc->dataType,
+                                                  index_nb + tail_nb, dims, nullptr));
+    const tecoalTensorStruct *value_descs[] = {&target, valuesDesc};
+    checkTecoalStatus(broadcastDims(value_descs, 2, true, &shape));
+    if (shape.elemNum != target.elemNum) {
+        WARNING("index put values do not broadcast to the indexed shape\n");
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    shape.toPlan(&arg->value_plan);
+    return TECOAL_STATUS_SUCCESS;
+}
+
 tecoalStatus_t TECOALWINAPI
 tecoalIndexPut(tecoalHandle_t handle, int indices_length, bool accumulate,
                const tecoalTensorDescriptor_t *indicesDesc, void **indices,
@@ -165,12 +211,24 @@ tecoalIndexPut(tecoalHandle_t handle, int indices_length, bool accumulate,
     reverse_array(arg.dim_index, dim_ln_index);
     reverse_array(arg.dim_output, dim_ln);
 
+    if (!arg.is_bool_index) {
+        checkTecoalStatus(planIndexPut(indices_length, indicesDesc, valuesDesc, outputDesc, &arg));
+    }
+
     IndexPutPatchArgs patch_arg;
     patch_arg.arg = &arg;
     patch_arg.data_type = Convert::toUALDataType(valuesDesc->dataType);
     patch_arg.index_data_type = Convert::toUALDataType(indexDesc->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(IndexPutOp, arg, patch_arg, handle);
+    DispatchKey key(IndexPutOp::name());
+    for (int i = 0; i < indices_length; i++) {
+        key.add(indicesDesc[i]);
+    }
+    key.add(valuesDesc);
+    key.add(outputDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(IndexPutOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/logical_not_tensor_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/logical_not_tensor/logical_not_tensor.hpp"
 
@@ -34,15 +35,28 @@ using tecoal::ual::ops::LogicalNotTensorOp;
 using tecoal::ual::args::LogicalNotTensorArgs;
 using tecoal::ual::args::LogicalNotTensorPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::coalesceDims;
 
 tecoalStatus_t TECOALWINAPI tecoalLogicalNotTensor(tecoalHandle_t handle,
                                                    const tecoalTensorDescriptor_t aDesc,
                                                    const void *A,
                                                    const tecoalTensorDescriptor_t cDesc, void *C,
                                                    tecoalAlgo_t algo) {
+    const tecoalTensorStruct *descs[] = {cDesc, aDesc};
+    CoalescedShape shape;
+    if (coalesceDims(descs, 2, &shape) != TECOAL_STATUS_SUCCESS || !shape.isRows()) {
+        WARNING("logical not A and C do not coalesce to unit-stride rows\n");
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+
     LogicalNotTensorArgs ntarg;
     ntarg.spe_num = handle->spe_num;
-    ntarg.A_num = aDesc->n * aDesc->h * aDesc->w * aDesc->c;
+    ntarg.A_num = shape.cols();
+    ntarg.row_num = shape.rows();
+    ntarg.C_row_stride = shape.rowStride(0);
+    ntarg.A_row_stride = shape.rowStride(1);
     ntarg.A = A;
     ntarg.C = C;
 
@@ -51,6 +65,11 @@ tecoalStatus_t TECOALWINAPI tecoalLogicalNotTensor(tecoalHandle_t handle,
     ntarg_patch.data_type = Convert::toUALDataType(aDesc->dataType);
     ntarg_patch.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(LogicalNotTensorOp, ntarg, ntarg_patch, handle);
+    DispatchKey key(LogicalNotTensorOp::name());
+    key.add(aDesc);
+    key.add(cDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(LogicalNotTensorOp, ntarg, ntarg_patch, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/masked_fill_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/masked_fill/masked_fill.hpp"
 
@@ -34,6 +35,9 @@ using tecoal::ual::ops::MaskedFillOp;
 using tecoal::ual::args::MaskedFillArgs;
 using tecoal::ual::args::MaskedFillPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::broadcastDims;
 
 #define SWAP_TYPE(type, x, y) \
     do {                      \
@@ -60,6 +64,7 @@ tecoalMaskedFill(tecoalHandle_t handle, const float value, const tecoalTensorDes
     arg.input = input;
     arg.mask = mask;
     arg.output = output;
+    arg.dtype_size = Convert::toDescDataTypeSize(inputDesc->dataType);
 
     arg.dimLen = inputDesc->nbDims;
 
@@ -86,11 +91,35 @@ tecoalMaskedFill(tecoalHandle_t handle, const float value, const tecoalTensorDes
         arg.dimMask[i] = 1;
     }
 
+    // input and mask broadcast to output; unit-stride rows stream, anything else walks the plan
+    const tecoalTensorStruct *descs[] = {outputDesc, inputDesc, maskDesc};
+    CoalescedShape shape;
+    if (broadcastDims(descs, 3, false, &shape) != TECOAL_STATUS_SUCCESS ||
+        shape.elemNum != outputDesc->elemNum) {
+        WARNING("masked fill input and mask do not broadcast to output\n");
+        return TECOAL_STATUS_BAD_PARAM;
+    }
+    shape.toPlan(&arg.plan);
+    arg.row_num = 0;
+    if (shape.isRows()) {
+        arg.data_num = shape.cols();
+        arg.row_num = shape.rows();
+        arg.output_row_stride = shape.rowStride(0);
+        arg.input_row_stride = shape.rowStride(1);
+        arg.mask_row_stride = shape.rowStride(2);
+    }
+
     MaskedFillPatchArgs patch_arg;
     patch_arg.args = &arg;
     patch_arg.data_type = Convert::toUALDataType(inputDesc->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(MaskedFillOp, arg, patch_arg, handle);
+    DispatchKey key(MaskedFillOp::name());
+    key.add(inputDesc);
+    key.add(maskDesc);
+    key.add(outputDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(MaskedFillOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
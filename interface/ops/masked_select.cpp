@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/masked_select_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/masked_select/masked_select.hpp"
 
@@ -34,6 +35,9 @@ using tecoal::ual::ops::MaskedSelectOp;
 using tecoal::ual::args::MaskedSelectArgs;
 using tecoal::ual::args::MaskedSelectPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::broadcastDims;
 
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
@@ -44,6 +48,7 @@ tecoalStatus_t TECOALWINAPI tecoalMaskedSelect(
     // mask broadcasts broadcast_flag 0x1 with a value of 1<<1 to input
     // input broadcasts broadcast_flag 0x2 to mask with a value of 1<<2
     // The mask and input bidirectional broadcast broadcast_flag have a value of 0x3
+    // Input or mask not contiguous adds 0x4, these all go through the broadcast plan
     int broadcast_flag = 0;
     MaskedSelectArgs arg;
     arg.spe_num = handle->spe_num;
@@ -80,6 +85,15 @@ tecoalStatus_t TECOALWINAPI tecoalMaskedSelect(
         broadcast_flag |= 0x1;  // mask broadcasts to input
     }
 
+    // the selected elements come out in logical order, so the plan keeps the dims in order
+    const tecoalTensorStruct *descs[] = {inputDesc, maskDesc};
+    CoalescedShape shape;
+    checkTecoalStatus(broadcastDims(descs, 2, true, &shape));
+    shape.toPlan(&arg.plan);
+    if (shape.nbDims != 1 || shape.strideA[0][0] != 1 || shape.strideA[1][0] != 1) {
+        broadcast_flag |= 0x4;
+    }
+
     arg.input = input;
     arg.mask = mask;
     arg.output = out;
@@ -94,6 +108,11 @@ tecoalStatus_t TECOALWINAPI tecoalMaskedSelect(
     arg_patch.mask_type = Convert::toUALDataType(maskDesc->dataType);
     arg_patch.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(MaskedSelectOp, arg, arg_patch, handle);
+    DispatchKey key(MaskedSelectOp::name());
+    key.add(inputDesc);
+    key.add(maskDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(MaskedSelectOp, arg, arg_patch, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #include "interface/include/tecoal.h"
 #include "interface/include/builtin_type.h"
 #include "ual/args/scale_tensor_args.h"
+#include "interface/common/coalesce.h"
 #include "interface/common/marco.h"
 #include "ual/ops/scale_tensor/scale_tensor.hpp"
 
@@ -34,10 +35,20 @@ using tecoal::ual::ops::ScaleTensorOp;
 using tecoal::ual::args::ScaleTensorArgs;
 using tecoal::ual::args::ScaleTensorPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
+using tecoal::CoalescedShape;
+using tecoal::coalesceDims;
 
 tecoalStatus_t TECOALWINAPI tecoalScaleTensor(tecoalHandle_t handle,
                                               const tecoalTensorDescriptor_t yDesc, void *y,
                                               const void *alpha, tecoalAlgo_t algo) {
+    const tecoalTensorStruct *descs[] = {yDesc};
+    CoalescedShape shape;
+    if (coalesceDims(descs, 1, &shape) != TECOAL_STATUS_SUCCESS || !shape.isRows()) {
+        WARNING("scale tensor y does not coalesce to unit-stride rows\n");
+        return TECOAL_STATUS_NOT_SUPPORTED;
+    }
+
     // init params
     ScaleTensorArgs arg;
     arg.spe_num = handle->spe_num;
@@ -45,21 +56,25 @@ tecoalStatus_t TECOALWINAPI tecoalScaleTensor(tecoalHandle_t handle,
     arg.data_num = 1;
     arg.spa_num = 0;
     arg.y = y;
-    int data_num = 1;
-    for (size_t i = 0; i < yDesc->nbDims; ++i) {
-        data_num *= yDesc->dimA[i];
-    }
-    arg.data_num = data_num;
-    if (yDesc->dataType == TECOAL_DATA_FLOAT)
+    arg.data_num = shape.cols();
+    arg.row_num = shape.rows();
+    arg.y_row_stride = shape.rowStride(0);
+    // alpha is a float for both float and bfloat16 y
+    if (yDesc->dataType == TECOAL_DATA_FLOAT || yDesc->dataType == TECOAL_DATA_BFLOAT16)
         arg.x = *reinterpret_cast<const float *>(alpha);
     else
         return TECOAL_STATUS_NOT_SUPPORTED;
+    arg.dtype_size = Convert::toDescDataTypeSize(yDesc->dataType);
 
     ScaleTensorPatchArgs patch_arg;
     patch_arg.starg = &arg;
     patch_arg.data_type = Convert::toUALDataType(yDesc->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(ScaleTensorOp, arg, patch_arg, handle);
+    DispatchKey key(ScaleTensorOp::name());
+    key.add(yDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(ScaleTensorOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -34,6 +34,7 @@ using tecoal::ual::ops::ScatterNdAddOp;
 using tecoal::ual::args::ScatterNdAddArgs;
 using tecoal::ual::args::ScatterNdAddPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 tecoalStatus_t TECOALWINAPI
 tecoalScatterNdAdd(tecoalHandle_t handle, const tecoalTensorDescriptor_t xDesc, const void *x,
@@ -74,6 +75,11 @@ tecoalScatterNdAdd(tecoalHandle_t handle, const tecoalTensorDescriptor_t xDesc,
     arg_patch.x_data_type = Convert::toUALDataType(xDesc->dataType);
     arg_patch.index_data_type = Convert::toUALDataType(indexDesc->dataType);
     arg_patch.algo = Convert::toUalAlgoType(algo);
-    RUN_OP(ScatterNdAddOp, arg, arg_patch, handle);
+
+    DispatchKey key(ScatterNdAddOp::name());
+    key.add(xDesc);
+    key.add(indexDesc);
+    key.add((int64_t)algo);
+    RUN_OP(ScatterNdAddOp, arg, arg_patch, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -34,6 +34,7 @@ using tecoal::ual::ops::ScatterOutOp;
 using tecoal::ual::args::ScatterOutArgs;
 using tecoal::ual::args::ScatterOutPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 #define SWAP_TYPE(type, x, y) \
     do {                      \
@@ -103,6 +104,10 @@ tecoalStatus_t TECOALWINAPI tecoalScatterOut(
     patch_arg.data_type = Convert::toUALDataType(desc_input->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(ScatterOutOp, arg, patch_arg, handle);
+    DispatchKey key(ScatterOutOp::name());
+    key.add(desc_input);
+    key.add((int64_t)algo);
+
+    RUN_OP(ScatterOutOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -34,15 +34,13 @@ using tecoal::ual::ops::UnaryOpsOp;
 using tecoal::ual::args::UnaryOpsArgs;
 using tecoal::ual::args::UnaryOpsPatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 tecoalStatus_t TECOALWINAPI tecoalUnaryOps(tecoalHandle_t handle, tecoalUnaryOpsMode_t mode,
                                            const void *alpha, const tecoalTensorDescriptor_t xDesc,
                                            const void *x, const tecoalTensorDescriptor_t yDesc,
                                            void *y, tecoalAlgo_t algo) {
-    int count = xDesc->dimA[0];
-    for (int i = 1; i < xDesc->nbDims; i++) {
-        count *= xDesc->dimA[i];
-    }
+    int count = (int)xDesc->elemNum;
 
     UnaryOpsArgs arg;
     arg.mode = mode;
@@ -50,6 +48,8 @@ tecoalStatus_t TECOALWINAPI tecoalUnaryOps(tecoalHandle_t handle, tecoalUnaryOps
     arg.y = y;
     arg.n = count;
     arg.spe_num = handle->spe_num;
+    // alpha has the data type of x, the kernel reads the matching field
+    arg.alpha_f32 = ((float *)alpha)[0];
     arg.alpha_int32 = ((int *)alpha)[0];
 
     UnaryOpsPatchArgs arg_patch;
@@ -59,6 +59,12 @@ tecoalStatus_t TECOALWINAPI tecoalUnaryOps(tecoalHandle_t handle, tecoalUnaryOps
     arg_patch.mode = Convert::toUALUnaryOpsMode(mode);
     arg_patch.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(UnaryOpsOp, arg, arg_patch, handle);
+    DispatchKey key(UnaryOpsOp::name());
+    key.add(xDesc);
+    key.add(yDesc);
+    key.add((int64_t)mode);
+    key.add((int64_t)algo);
+
+    RUN_OP(UnaryOpsOp, arg, arg_patch, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
@@ -34,6 +34,7 @@ using tecoal::ual::ops::UniqueOp;
 using tecoal::ual::args::UniqueArgs;
 using tecoal::ual::args::UniquePatchArgs;
 using tecoal::Convert;
+using tecoal::DispatchKey;
 
 tecoalStatus_t TECOALWINAPI tecoalUnique(tecoalHandle_t handle, tecoalUniqueMode_t mode, int axis,
                                          bool sorted, bool return_inverse, bool return_counts,
@@ -54,10 +55,13 @@ tecoalStatus_t TECOALWINAPI tecoalUnique(tecoalHandle_t handle, tecoalUniqueMode
     arg.return_inverse = return_inverse;
     arg.return_counts = return_counts;
     arg.out_size = (void *)out_size;
-    int ndimsA = inputDesc->nbDims;
-    arg.data_len = 1;
-    for (int i = 0; i < ndimsA; i++) {
-        arg.data_len *= inputDesc->dimA[i];
+    arg.data_len = (int)inputDesc->elemNum;
+
+    // The host kernel sorts a copy of the input, taken from the handle's workspace
+    tecoal::WorkspaceScope scope(&handle->workspace);
+    arg.sort_buf = nullptr;
+    if (handle->backend == TECOAL_BACKEND_CPU) {
+        arg.sort_buf = handle->workspace.alloc((size_t)arg.data_len * sizeof(int64_t));
     }
 
     // Initialize patch arguments structure for additional configurations
@@ -66,6 +70,10 @@ tecoalStatus_t TECOALWINAPI tecoalUnique(tecoalHandle_t handle, tecoalUniqueMode
     patch_arg.data_type = Convert::toUALDataType(inputDesc->dataType);
     patch_arg.algo = Convert::toUalAlgoType(algo);
 
-    RUN_OP(UniqueOp, arg, patch_arg, handle);
+    DispatchKey key(UniqueOp::name());
+    key.add(inputDesc);
+    key.add((int64_t)algo);
+
+    RUN_OP(UniqueOp, arg, patch_arg, handle, key);
     return TECOAL_STATUS_SUCCESS;
 }
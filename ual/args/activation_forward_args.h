@@ -40,6 +40,9 @@ typedef struct ActivationFwdArgs {
     int spa_num;
 
     int data_num;
+    int row_num;
+    int x_row_stride;
+    int y_row_stride;
     int mode;
     double coef;
     const void *x;
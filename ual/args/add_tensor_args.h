@@ -27,6 +27,7 @@
 #ifndef UAL_ARGS_ADD_TENSOR_ARGS_H_
 #define UAL_ARGS_ADD_TENSOR_ARGS_H_
 
+#include "ual/com/broadcast.h"
 #include "ual/com/def.h"
 
 using namespace tecoal::ual::common;
@@ -43,6 +44,13 @@ typedef struct AddTensorArgs {
     int a_hw_num;
     int c_hw_num;
     int format;
+    // coalesced problem: row_num rows of data_num elements, unit stride inside a row
+    int data_num;
+    int row_num;
+    int a_row_stride;
+    int c_row_stride;
+    // C = operand 0, A = operand 1, for shapes that do not reduce to rows
+    BroadcastPlan plan;
     float alpha;
     float beta;
     const void *A;
@@ -56,9 +56,17 @@ typedef struct GEMMArgs {
     const void *A;
     const void *B;
     void *C;
+    // batch entry b is Aarray[b] etc. when these are set, A + b * strideA etc. otherwise; the
+    // arrays live where the kernels run, device memory for the device backend
+    const void *const *Aarray;
+    const void *const *Barray;
+    void *const *Carray;
     UALDataType Atype;
     UALDataType Btype;
     UALDataType Ctype;
+    // A is stored k x m and B n x k when transposed; UAL_OP_C is UAL_OP_T on real types
+    UALOperation transa;
+    UALOperation transb;
 } GEMMArgs;
 
 typedef struct GEMMPatchArgs {
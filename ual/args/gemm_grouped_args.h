@@ -0,0 +1,78 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_ARGS_GEMM_GROUPED_ARGS_H_
+#define UAL_ARGS_GEMM_GROUPED_ARGS_H_
+
+#include "ual/com/def.h"
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+namespace ual {
+namespace args {
+
+// groups one launch carries; the interface runs longer lists as consecutive launches
+#define GEMM_GROUPED_MAX 64
+
+typedef struct GEMMGroupShape {
+    int m;
+    int n;
+    int k;
+    int lda;
+    int ldb;
+    int ldc;
+} GEMMGroupShape;
+
+// Row-major C[g] = alpha * op(A[g]) * op(B[g]) + beta * C[g] for every group g. The shapes
+// travel inside the args; the pointer arrays live where the kernels run.
+typedef struct GEMMGroupedArgs {
+    int spe_num;
+    int group_count;
+    int group_base;  // index of shapes[0] in the caller's arrays, A/B/C already point there
+    float alpha;
+    float beta;
+    GEMMGroupShape shapes[GEMM_GROUPED_MAX];
+    const void *const *A;
+    const void *const *B;
+    void *const *C;
+    UALDataType Atype;
+    UALDataType Btype;
+    UALDataType Ctype;
+    UALOperation transa;
+    UALOperation transb;
+} GEMMGroupedArgs;
+
+typedef struct GEMMGroupedPatchArgs {
+    GEMMGroupedArgs *args;
+    UALAlgoType algo;
+} GEMMGroupedPatchArgs;
+
+}  // namespace args
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_ARGS_GEMM_GROUPED_ARGS_H_
@@ -27,6 +27,7 @@
 #ifndef UAL_ARGS_INDEX_PUT_ARGS_H_
 #define UAL_ARGS_INDEX_PUT_ARGS_H_
 
+#include "ual/com/broadcast.h"
 #include "ual/com/def.h"
 
 using namespace tecoal::ual::common;
@@ -67,6 +68,10 @@ typedef struct IndexPutArgs {
     int broadcast_value;
 
     int broadcast;
+    // indices[i] = operand i over the broadcast index shape
+    BroadcastPlan index_plan;
+    // value = operand 1 over the index shape followed by the output's trailing dims
+    BroadcastPlan value_plan;
 } IndexPutArgs;
 
 typedef struct IndexPutPatchArgs {
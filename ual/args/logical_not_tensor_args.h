@@ -40,6 +40,9 @@ typedef struct LogicalNotTensorArgs {
     void *C;
     int spe_num;
     int A_num;
+    int row_num;
+    int A_row_stride;
+    int C_row_stride;
 } LogicalNotTensorArgs;
 
 typedef struct LogicalNotTensorPatchArgs {
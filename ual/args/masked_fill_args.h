@@ -27,6 +27,7 @@
 #ifndef UAL_ARGS_MASKED_FILL_ARGS_H_
 #define UAL_ARGS_MASKED_FILL_ARGS_H_
 
+#include "ual/com/broadcast.h"
 #include "ual/com/def.h"
 
 using namespace tecoal::ual::common;
@@ -43,10 +44,19 @@ typedef struct MaskedFillArgs {
     const void *input;
     const void *mask;
     void *output;
+    int dtype_size;
     int dimLen;
     int dimInput[MAX_DIM];
     int dimMask[MAX_DIM];
     int dimOutput[MAX_DIM];
+    // coalesced problem: row_num rows of data_num elements, unit stride inside a row
+    int data_num;
+    int row_num;
+    int input_row_stride;
+    int mask_row_stride;
+    int output_row_stride;
+    // output = operand 0, input = 1, mask = 2, for shapes that do not reduce to rows
+    BroadcastPlan plan;
 } MaskedFillArgs;
 
 typedef struct MaskedFillPatchArgs {
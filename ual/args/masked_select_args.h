@@ -27,6 +27,7 @@
 #ifndef UAL_ARGS_MASKED_SELECT_ARGS_H_
 #define UAL_ARGS_MASKED_SELECT_ARGS_H_
 
+#include "ual/com/broadcast.h"
 #include "ual/com/def.h"
 
 using namespace tecoal::ual::common;
@@ -50,6 +51,8 @@ typedef struct MaskedSelectArgs {
     int broadcast_dim[MAX_DIM];
     int x_dim[MAX_DIM];
     int mask_dim[MAX_DIM];
+    // input = operand 0, mask = 1, in logical element order
+    BroadcastPlan plan;
 } MaskedSelectArgs;
 
 typedef struct MaskedSelectPatchArgs {
@@ -39,7 +39,10 @@ typedef struct ScaleTensorArgs {
     int spe_num;
     int spa_num;
     int data_num;
+    int row_num;
+    int y_row_stride;
     float x;
+    int dtype_size;
     void *y;
 } ScaleTensorArgs;
 
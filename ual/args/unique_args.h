@@ -46,6 +46,7 @@ typedef struct UniqueArgs {
     unsigned return_counts;
     int data_len;
     void *out_size;
+    void *sort_buf;  // data_len int64 of scratch for the host sort, null: the kernel allocates
 } UniqueArgs;
 
 typedef struct UniquePatchArgs {
@@ -0,0 +1,211 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_COM_BFLOAT16_H_
+#define UAL_COM_BFLOAT16_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "ual/com/half.hpp"
+
+namespace tecoal {
+namespace ual {
+namespace common {
+
+// bits of the nearest bfloat16, ties to even; NaNs keep their sign and top payload and are
+// made quiet, so they stay NaNs after the truncation
+static inline uint16_t floatToBfloat16Bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) return (uint16_t)((bits >> 16) | 0x40);
+    return (uint16_t)((bits + 0x7FFFu + ((bits >> 16) & 1)) >> 16);
+}
+
+static inline float bfloat16BitsToFloat(uint16_t bits) {
+    uint32_t value = (uint32_t)bits << 16;
+    float result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+// Host-side bfloat16: the upper half of an IEEE float. Arithmetic goes through float, so host
+// kernels written for half take it unchanged.
+struct bfloat16 {
+    uint16_t bits;
+
+    bfloat16() = default;
+    explicit bfloat16(float value) : bits(floatToBfloat16Bits(value)) {}
+    explicit operator float() const { return bfloat16BitsToFloat(bits); }
+};
+
+namespace detail {
+#if HALF_ENABLE_BULK_SIMD
+// GCC 12 warns about the undefined passthrough operands inside its own AVX-512 intrinsics
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+enum class Bf16Isa { SCALAR, AVX2, AVX512 };
+
+static inline Bf16Isa detectBf16Isa() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Bf16Isa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Bf16Isa::AVX2;
+    return Bf16Isa::SCALAR;
+}
+
+static inline Bf16Isa bf16Isa() {
+    static const Bf16Isa isa = detectBf16Isa();
+    return isa;
+}
+
+// The leading multiple of 16 (AVX-512F) or 8 (AVX2) elements, rounded as floatToBfloat16Bits;
+// each returns how many it converted.
+__attribute__((target("avx512f"))) static inline size_t floatToBfloat16Avx512(const float *src,
+                                                                             uint16_t *dst,
+                                                                             size_t n) {
+    const __m512i one = _mm512_set1_epi32(1), bias = _mm512_set1_epi32(0x7FFF);
+    const __m512i abs_mask = _mm512_set1_epi32(0x7FFFFFFF), inf = _mm512_set1_epi32(0x7F800000);
+    const __m512i quiet = _mm512_set1_epi32(0x40);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i bits = _mm512_loadu_si512(src + i);
+        __m512i upper = _mm512_srli_epi32(bits, 16);
+        __m512i lsb = _mm512_and_si512(upper, one);
+        __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(bias, lsb));
+        rounded = _mm512_srli_epi32(rounded, 16);
+        __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, abs_mask), inf);
+        rounded = _mm512_mask_mov_epi32(rounded, nan, _mm512_or_si512(upper, quiet));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm512_cvtepi32_epi16(rounded));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static inline size_t floatToBfloat16Avx2(const float *src,
+                                                                        uint16_t *dst,
+                                                                        size_t n) {
+    const __m256i one = _mm256_set1_epi32(1), bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF), inf = _mm256_set1_epi32(0x7F800000);
+    const __m256i quiet = _mm256_set1_epi32(0x40);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i bits = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i upper = _mm256_srli_epi32(bits, 16);
+        __m256i lsb = _mm256_and_si256(upper, one);
+        __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(bias, lsb));
+        rounded = _mm256_srli_epi32(rounded, 16);
+        __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, abs_mask), inf);
+        rounded = _mm256_blendv_epi8(rounded, _mm256_or_si256(upper, quiet), nan);
+        // every lane fits 16 bits, so the saturating pack only narrows; it packs per 128-bit
+        // half, the permute brings the two results together
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(rounded, rounded), 0x08);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) static inline size_t bfloat16ToFloatAvx512(const uint16_t *src,
+                                                                             float *dst,
+                                                                             size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i bits = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(src + i)));
+        _mm512_storeu_si512(dst + i, _mm512_slli_epi32(bits, 16));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static inline size_t bfloat16ToFloatAvx2(const uint16_t *src,
+                                                                        float *dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_slli_epi32(bits, 16));
+    }
+    return i;
+}
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+}  // namespace detail
+
+// Bulk conversions, bit for bit those of the scalar functions above. Where the CPU has
+// AVX-512F or AVX2 (and HALF_ENABLE_BULK_SIMD allows) 16 or 8 elements go per step. The AVX512
+// BF16 instructions are not used: they flush denormals, which the scalar rounding keeps.
+static inline void convert(const float *src, bfloat16 *dst, size_t n) {
+    static_assert(sizeof(bfloat16) == sizeof(uint16_t), "bfloat16 must be its bits");
+    size_t i = 0;
+#if HALF_ENABLE_BULK_SIMD
+    uint16_t *bits = (uint16_t *)dst;
+    switch (detail::bf16Isa()) {
+        case detail::Bf16Isa::AVX512: i = detail::floatToBfloat16Avx512(src, bits, n); break;
+        case detail::Bf16Isa::AVX2: i = detail::floatToBfloat16Avx2(src, bits, n); break;
+        default: break;
+    }
+#endif
+    for (; i < n; i++) dst[i].bits = floatToBfloat16Bits(src[i]);
+}
+
+static inline void convert(const bfloat16 *src, float *dst, size_t n) {
+    size_t i = 0;
+#if HALF_ENABLE_BULK_SIMD
+    const uint16_t *bits = (const uint16_t *)src;
+    switch (detail::bf16Isa()) {
+        case detail::Bf16Isa::AVX512: i = detail::bfloat16ToFloatAvx512(bits, dst, n); break;
+        case detail::Bf16Isa::AVX2: i = detail::bfloat16ToFloatAvx2(bits, dst, n); break;
+        default: break;
+    }
+#endif
+    for (; i < n; i++) dst[i] = bfloat16BitsToFloat(src[i].bits);
+}
+
+// half <-> bfloat16 through float in stack-sized chunks; the float step is exact, so each
+// value is rounded once
+static inline void convert(const half_float::half *src, bfloat16 *dst, size_t n) {
+    float chunk[256];
+    for (size_t i = 0; i < n; i += 256) {
+        size_t len = n - i < 256 ? n - i : 256;
+        half_float::convert(src + i, chunk, len);
+        convert(chunk, dst + i, len);
+    }
+}
+
+static inline void convert(const bfloat16 *src, half_float::half *dst, size_t n) {
+    float chunk[256];
+    for (size_t i = 0; i < n; i += 256) {
+        size_t len = n - i < 256 ? n - i : 256;
+        convert(src + i, chunk, len);
+        half_float::convert(chunk, dst + i, len);
+    }
+}
+
+}  // namespace common
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_COM_BFLOAT16_H_
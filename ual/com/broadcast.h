@@ -0,0 +1,53 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_COM_BROADCAST_H_
+#define UAL_COM_BROADCAST_H_
+
+#include <stdint.h>
+
+namespace tecoal {
+namespace ual {
+namespace common {
+
+#define UAL_BROADCAST_DIM_MAX 8
+#define UAL_BROADCAST_OPERAND_MAX 8
+
+// Iteration plan over the broadcast shape of a set of operands, built on the host and walked by
+// the kernels. dims are outermost first with size-1 dims dropped and mergeable neighbours
+// merged; strides are in elements per operand and 0 along the dims an operand is broadcast on.
+typedef struct BroadcastPlan {
+    int nb_dims;
+    int operand_num;
+    int dims[UAL_BROADCAST_DIM_MAX];
+    int strides[UAL_BROADCAST_OPERAND_MAX][UAL_BROADCAST_DIM_MAX];
+} BroadcastPlan;
+
+}  // namespace common
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_COM_BROADCAST_H_
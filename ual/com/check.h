@@ -28,18 +28,29 @@
 #define UAL_COM_CHECK_H_
 
 #include <cstdio>
+#include "ual/com/log_level.h"
 
 #ifndef __LOG_ERR_PREFIX
 #define __LOG_ERR_PREFIX "ERROR"
 #endif
 
+// Device side check: a failing kernel reports and returns instead of taking the process down.
+// The host is not told and the outputs stay unwritten, so it only guards conditions the find
+// function already rules out. Only usable in functions returning void.
+#if TECOAL_LOG_LEVEL <= TECOAL_LOG_LEVEL_ERROR
 #define CHECK(cond, format, ...)                                                            \
     do {                                                                                    \
         if (!(cond)) {                                                                      \
             printf("%s [%s %d]: %s => " format " \n", __LOG_ERR_PREFIX, __FILE__, __LINE__, \
                    __FUNCTION__, ##__VA_ARGS__);                                            \
-            exit(0);                                                                        \
+            return;                                                                         \
         }                                                                                   \
     } while (0)
+#else
+#define CHECK(cond, format, ...) \
+    do {                         \
+        if (!(cond)) return;     \
+    } while (0)
+#endif
 
 #endif  // UAL_COM_CHECK_H_
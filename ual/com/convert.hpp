@@ -86,8 +86,35 @@ static int inline convertAlgoToIndex(UALAlgoType type) {
         case UALAlgoType::UAL_ALGO_48: return 48;
         case UALAlgoType::UAL_ALGO_49: return 49;
         case UALAlgoType::UAL_ALGO_50: return 50;
+        default: return -1;  // UAL_ALGO_BEST names no kernel of its own
+    }
+}
+
+// The ops with a single kernel run it for UAL_ALGO_BEST as well
+static inline bool isDefaultAlgo(UALAlgoType type) {
+    return type == UALAlgoType::UAL_ALGO_0 || type == UALAlgoType::UAL_ALGO_BEST;
+}
+
+static int inline convertDataTypeSize(UALDataType type) {
+    switch (type) {
+        case UALDataType::UAL_DTYPE_INT8:
+        case UALDataType::UAL_DTYPE_UINT8:
+        case UALDataType::UAL_DTYPE_BOOL: return 1;
+        case UALDataType::UAL_DTYPE_HALF:
+        case UALDataType::UAL_DTYPE_INT16:
+        case UALDataType::UAL_DTYPE_UINT16:
+        case UALDataType::UAL_DTYPE_BFLOAT16: return 2;
+        case UALDataType::UAL_DTYPE_FLOAT:
+        case UALDataType::UAL_DTYPE_INT32:
+        case UALDataType::UAL_DTYPE_UINT32:
+        case UALDataType::UAL_DTYPE_COMPLEX_HALF: return 4;
+        case UALDataType::UAL_DTYPE_INT64:
+        case UALDataType::UAL_DTYPE_UINT64:
+        case UALDataType::UAL_DTYPE_DOUBLE:
+        case UALDataType::UAL_DTYPE_COMPLEX_FLOAT: return 8;
+        case UALDataType::UAL_DTYPE_COMPLEX_DOUBLE: return 16;
         default: {
-            throw std::runtime_error("UALAlgoType is not exist!\n");
+            throw std::runtime_error("UALDataType is not exist!\n");
         }
     }
 }
@@ -38,7 +38,8 @@ typedef enum {
     NOT_IMPLEMENTED = 4,
     NO_IMPLEMENTATION = 5,
     REINITIALIZED = 6,
-    TRY_FAILED = 7
+    TRY_FAILED = 7,
+    RUNTIME_ERROR = 8  // a launched kernel failed
 } Status;
 
 typedef enum {
@@ -68,6 +69,12 @@ typedef enum {
     UAL_DTYPE_BFLOAT16 = 15,
 } UALDataType;
 
+// where an op's kernels run: the accelerator, or host threads on the same args
+typedef enum {
+    UAL_BACKEND_DEVICE = 0,
+    UAL_BACKEND_HOST = 1,
+} UALBackend;
+
 typedef enum UALOperation {
     UAL_OP_N = 0,  // no transpose
     UAL_OP_T = 1,  // transpose
@@ -125,7 +132,8 @@ typedef enum {
     UAL_ALGO_47,
     UAL_ALGO_48,
     UAL_ALGO_49,
-    UAL_ALGO_50
+    UAL_ALGO_50,
+    UAL_ALGO_BEST = -1
 } UALAlgoType;
 
 // used by unary ops
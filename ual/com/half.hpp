@@ -290,6 +290,24 @@
 #include <immintrin.h>
 #endif
 
+#ifndef HALF_ENABLE_BULK_SIMD
+/// Enable runtime-dispatched SIMD in the bulk conversions.
+/// Defining this to 1 lets [convert](\ref half_float::convert) use AVX-512F or F16C instructions
+/// whenever the CPU running the program supports them, independent of the target the code is
+/// compiled for, and the scalar conversion otherwise. This needs GCC-style `target` attributes and
+/// `__builtin_cpu_supports`.
+///
+/// Unless predefined it will be enabled automatically for GCC-compatible compilers targeting x86.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HALF_ENABLE_BULK_SIMD 1
+#else
+#define HALF_ENABLE_BULK_SIMD 0
+#endif
+#endif
+#if HALF_ENABLE_BULK_SIMD && !HALF_ENABLE_F16C_INTRINSICS
+#include <immintrin.h>
+#endif
+
 #ifdef HALF_DOXYGEN_ONLY
 /// Type for internal floating-point computations.
 /// This can be predefined to a built-in floating-point type (`float`, `double` or `long double`) to
@@ -2502,6 +2520,8 @@ class half {
     friend HALF_CONSTEXPR bool isless(half, half);
     friend HALF_CONSTEXPR bool islessequal(half, half);
     friend HALF_CONSTEXPR bool islessgreater(half, half);
+    friend void convert(const float *, half *, std::size_t);
+    friend void convert(const half *, float *, std::size_t);
     template <typename, typename, std::float_round_style>
     friend struct detail::half_caster;
     friend class std::numeric_limits<half>;
@@ -4914,6 +4934,188 @@ T half_cast(U arg) {
 }
 /// \}
 
+/// \name Bulk conversion
+/// \{
+
+namespace detail {
+#if HALF_ENABLE_BULK_SIMD
+/// Instruction sets of the bulk conversions.
+enum bulk_isa { bulk_scalar, bulk_f16c, bulk_avx512 };
+
+/// Best instruction set the running CPU and OS support.
+inline bulk_isa detect_bulk_isa() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return bulk_avx512;
+    if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) return bulk_f16c;
+    return bulk_scalar;
+}
+
+/// Instruction set of the bulk conversions, detected on first use.
+inline bulk_isa bulk_conversion_isa() {
+    static const bulk_isa isa = detect_bulk_isa();
+    return isa;
+}
+
+/// Rounding immediate of `vcvtps2ph` for a rounding mode, as in float2half_impl().
+/// \tparam R rounding mode to use
+template <std::float_round_style R>
+struct bulk_rounding {
+    static const int value = (R == std::round_to_nearest)          ? _MM_FROUND_TO_NEAREST_INT :
+                             (R == std::round_toward_zero)         ? _MM_FROUND_TO_ZERO :
+                             (R == std::round_toward_infinity)     ? _MM_FROUND_TO_POS_INF :
+                             (R == std::round_toward_neg_infinity) ? _MM_FROUND_TO_NEG_INF :
+                                                                     _MM_FROUND_CUR_DIRECTION;
+};
+
+/// Convert the leading multiple of 16 single-precision values with AVX-512F.
+/// Like the other bulk helpers it ends in `vzeroupper`: compilers only add one when optimizing,
+/// and SSE code running after dirty upper halves is many times slower.
+/// \tparam R rounding mode to use
+/// \param src values to convert
+/// \param dst storage for the half-precision bits
+/// \param n number of values
+/// \return number of values converted
+template <std::float_round_style R>
+__attribute__((target("avx512f"))) std::size_t float2half_avx512(const float *src, uint16 *dst,
+                                                                 std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        // the zero-masking forms, as GCC warns about the undefined passthrough of the others
+        __m256i h = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(src + i),
+                                          bulk_rounding<R>::value);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), h);
+    }
+    _mm256_zeroupper();
+    return i;
+}
+
+/// Convert the leading multiple of 8 single-precision values with F16C.
+/// \tparam R rounding mode to use
+/// \param src values to convert
+/// \param dst storage for the half-precision bits
+/// \param n number of values
+/// \return number of values converted
+template <std::float_round_style R>
+__attribute__((target("avx,f16c"))) std::size_t float2half_f16c(const float *src, uint16 *dst,
+                                                                std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), bulk_rounding<R>::value);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+    }
+    _mm256_zeroupper();
+    return i;
+}
+
+/// Check 8 half-precision values for signaling NaNs.
+/// `vcvtph2ps` quiets them while the scalar conversion keeps the payload unchanged, so blocks
+/// holding one are converted the scalar way.
+/// \param h half-precision bits
+/// \return true if any value is a signaling NaN
+__attribute__((target("sse2"))) inline bool any_signaling_nan(__m128i h) {
+    __m128i nan_quiet = _mm_and_si128(h, _mm_set1_epi16(0x7E00));
+    __m128i payload = _mm_and_si128(h, _mm_set1_epi16(0x01FF));
+    __m128i signaling = _mm_andnot_si128(_mm_cmpeq_epi16(payload, _mm_setzero_si128()),
+                                         _mm_cmpeq_epi16(nan_quiet, _mm_set1_epi16(0x7C00)));
+    return _mm_movemask_epi8(signaling) != 0;
+}
+
+/// Convert the leading multiple of 16 half-precision values with AVX-512F.
+/// \param src half-precision bits to convert
+/// \param dst storage for the single-precision values
+/// \param n number of values
+/// \return number of values converted
+__attribute__((target("avx512f"))) inline std::size_t half2float_avx512(const uint16 *src,
+                                                                        float *dst,
+                                                                        std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        if (any_signaling_nan(_mm256_castsi256_si128(h)) ||
+            any_signaling_nan(_mm256_extractf128_si256(h, 1))) {
+            for (std::size_t j = i; j < i + 16; ++j) dst[j] = half2float<float>(src[j]);
+        } else {
+            _mm512_storeu_ps(dst + i, _mm512_maskz_cvtph_ps(0xFFFF, h));
+        }
+    }
+    _mm256_zeroupper();
+    return i;
+}
+
+/// Convert the leading multiple of 8 half-precision values with F16C.
+/// \param src half-precision bits to convert
+/// \param dst storage for the single-precision values
+/// \param n number of values
+/// \return number of values converted
+__attribute__((target("avx,f16c"))) inline std::size_t half2float_f16c(const uint16 *src,
+                                                                       float *dst,
+                                                                       std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (any_signaling_nan(h)) {
+            for (std::size_t j = i; j < i + 8; ++j) dst[j] = half2float<float>(src[j]);
+        } else {
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+    }
+    _mm256_zeroupper();
+    return i;
+}
+#endif
+}  // namespace detail
+
+/// Convert an array of single-precision values to half-precision.
+/// The results are bit for bit those of converting each value on its own, rounded according to
+/// [HALF_ROUND_STYLE](\ref HALF_ROUND_STYLE), but the bulk of the array is converted 16 or 8
+/// values at a time where [HALF_ENABLE_BULK_SIMD](\ref HALF_ENABLE_BULK_SIMD) allows. With
+/// [exception handling](\ref HALF_ERRHANDLING_FLAGS) enabled every value takes the scalar path,
+/// so the exceptions are still raised.
+/// \param src values to convert
+/// \param dst storage for \a n half-precision values
+/// \param n number of values
+inline void convert(const float *src, half *dst, std::size_t n) {
+    std::size_t i = 0;
+#if HALF_ENABLE_BULK_SIMD && !HALF_ERRHANDLING
+#if HALF_ENABLE_CPP11_STATIC_ASSERT
+    static_assert(sizeof(half) == sizeof(detail::uint16), "bulk conversion needs a packed half");
+#endif
+    detail::uint16 *bits = reinterpret_cast<detail::uint16 *>(dst);
+    switch (detail::bulk_conversion_isa()) {
+        case detail::bulk_avx512:
+            i = detail::float2half_avx512<half::round_style>(src, bits, n);
+            break;
+        case detail::bulk_f16c:
+            i = detail::float2half_f16c<half::round_style>(src, bits, n);
+            break;
+        default: break;
+    }
+#endif
+    for (; i < n; ++i) dst[i].data_ = detail::float2half<half::round_style>(src[i]);
+}
+
+/// Convert an array of half-precision values to single-precision.
+/// The results are bit for bit those of converting each value on its own, signaling NaNs
+/// included; where
+/// [HALF_ENABLE_BULK_SIMD](\ref HALF_ENABLE_BULK_SIMD) allows, 16 or 8 values are converted at a
+/// time.
+/// \param src values to convert
+/// \param dst storage for \a n single-precision values
+/// \param n number of values
+inline void convert(const half *src, float *dst, std::size_t n) {
+    std::size_t i = 0;
+#if HALF_ENABLE_BULK_SIMD
+    const detail::uint16 *bits = reinterpret_cast<const detail::uint16 *>(src);
+    switch (detail::bulk_conversion_isa()) {
+        case detail::bulk_avx512: i = detail::half2float_avx512(bits, dst, n); break;
+        case detail::bulk_f16c: i = detail::half2float_f16c(bits, dst, n); break;
+        default: break;
+    }
+#endif
+    for (; i < n; ++i) dst[i] = detail::half2float<float>(src[i].data_);
+}
+/// \}
+
 /// \}
 /// \anchor errors
 /// \name Error handling
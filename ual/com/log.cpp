@@ -0,0 +1,202 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/com/log.h"
+#include <stdarg.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace tecoal {
+namespace ual {
+namespace common {
+
+#define LOG_QUEUE_SIZE 1024  // power of two
+#define LOG_MESSAGE_LEN 512
+
+static const char *const kLevelPrefix[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+
+struct LogSlot {
+    std::atomic<uint64_t> seq;
+    int level;
+    char text[LOG_MESSAGE_LEN];
+};
+
+// Bounded multi-producer queue drained by one background thread. A producer claims a slot by
+// advancing tail and publishes it through the slot's sequence number; nothing ever waits on the
+// writer thread.
+class LogSink {
+ public:
+    static LogSink &instance() {
+        static LogSink sink;
+        return sink;
+    }
+
+    LogSlot *claim() {
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            LogSlot *slot = &slots_[pos & (LOG_QUEUE_SIZE - 1)];
+            int64_t diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(LogSlot *slot) {
+        uint64_t seq = slot->seq.load(std::memory_order_relaxed);
+        slot->seq.store(seq + 1, std::memory_order_release);
+        cv_.notify_one();
+    }
+
+    void flush() {
+        uint64_t target = tail_.load(std::memory_order_acquire);
+        while (written_.load(std::memory_order_acquire) < target) {
+            cv_.notify_one();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+ private:
+    LogSink() {
+        for (uint64_t i = 0; i < LOG_QUEUE_SIZE; i++) slots_[i].seq.store(i);
+        worker_ = std::thread(&LogSink::drain, this);
+    }
+
+    ~LogSink() {
+        stop_.store(true, std::memory_order_release);
+        cv_.notify_one();
+        worker_.join();
+    }
+
+    // Write every published slot in order; returns false when the queue is empty
+    bool writeReady() {
+        bool wrote = false;
+        for (;;) {
+            uint64_t pos = written_.load(std::memory_order_relaxed);
+            LogSlot *slot = &slots_[pos & (LOG_QUEUE_SIZE - 1)];
+            if (slot->seq.load(std::memory_order_acquire) != pos + 1) break;
+            FILE *out = slot->level >= TECOAL_LOG_LEVEL_WARNING ? stderr : stdout;
+            fputs(slot->text, out);
+            slot->seq.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+            written_.store(pos + 1, std::memory_order_release);
+            wrote = true;
+        }
+        uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            fprintf(stderr, "WARNING: %llu log messages dropped, queue full\n",
+                    (unsigned long long)dropped);
+        }
+        if (wrote) {
+            fflush(stdout);
+            fflush(stderr);
+        }
+        return wrote;
+    }
+
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (!writeReady()) cv_.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        writeReady();
+    }
+
+    LogSlot slots_[LOG_QUEUE_SIZE];
+    std::atomic<uint64_t> tail_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;  // only for the writer's timed wait
+    std::condition_variable cv_;
+    std::thread worker_;
+};
+
+bool logAllow(LogSite *site, uint32_t *suppressed) {
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    int64_t window = site->window.load(std::memory_order_relaxed);
+    if (window != now &&
+        site->window.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        site->count.store(0, std::memory_order_relaxed);
+    }
+    if (site->count.fetch_add(1, std::memory_order_relaxed) < TECOAL_LOG_BURST) {
+        *suppressed = site->suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    site->suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void logWrite(int level, const char *file, int line, const char *func, uint32_t suppressed,
+              const char *format, ...) {
+    LogSink &sink = LogSink::instance();
+    LogSlot *slot = sink.claim();
+    if (slot == nullptr) return;
+
+    slot->level = level;
+    int len;
+    if (level >= TECOAL_LOG_LEVEL_ERROR) {
+        len = snprintf(slot->text, LOG_MESSAGE_LEN, "%s [%s %d]: %s => ", kLevelPrefix[level],
+                       file, line, func);
+    } else {
+        len = snprintf(slot->text, LOG_MESSAGE_LEN, "%s [%s %d]: => ", kLevelPrefix[level], func,
+                       line);
+    }
+    if (len >= 0 && len < LOG_MESSAGE_LEN) {
+        va_list args;
+        va_start(args, format);
+        int body = vsnprintf(slot->text + len, LOG_MESSAGE_LEN - len, format, args);
+        va_end(args);
+        if (body > 0) len = len + body < LOG_MESSAGE_LEN ? len + body : LOG_MESSAGE_LEN - 1;
+    }
+    if (len >= 0 && len < LOG_MESSAGE_LEN && suppressed > 0) {
+        len += snprintf(slot->text + len, LOG_MESSAGE_LEN - len,
+                        " (%u similar messages suppressed)", suppressed);
+    }
+    if (len < 0 || len >= LOG_MESSAGE_LEN - 1) len = LOG_MESSAGE_LEN - 2;
+    // messages used to carry their own trailing newline, keep exactly one
+    while (len > 0 && (slot->text[len - 1] == '\n' || slot->text[len - 1] == ' ')) len--;
+    slot->text[len] = '\n';
+    slot->text[len + 1] = '\0';
+    sink.publish(slot);
+}
+
+void logFlush() { LogSink::instance().flush(); }
+
+}  // namespace common
+}  // namespace ual
+}  // namespace tecoal
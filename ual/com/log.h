@@ -27,30 +27,75 @@
 #ifndef UAL_COM_LOG_H_
 #define UAL_COM_LOG_H_
 
-#include <cstdio>
+#include <stdint.h>
+#include <atomic>
+#include "ual/com/log_level.h"
 
-#define __LOG_INFO_PREFIX "INFO"
-#define __LOG_WARN_PREFIX "WARNING"
-#define __LOG_ERR_PREFIX "ERROR"
+namespace tecoal {
+namespace ual {
+namespace common {
 
-#define LOG(format, ...)                                                                  \
-    do {                                                                                  \
-        printf("%s [%s %d]: => " format " \n", __LOG_INFO_PREFIX, __FUNCTION__, __LINE__, \
-               ##__VA_ARGS__);                                                            \
-    } while (0)
+#define TECOAL_LOG_BURST 10  // messages per call site and second, the rest are counted and dropped
+
+// Rate limit state of one logging call site.
+struct LogSite {
+    std::atomic<int64_t> window{-1};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+bool logAllow(LogSite *site, uint32_t *suppressed);
+
+// Formats the message and queues it for the background writer; never blocks, drops the
+// message when the queue is full.
+void logWrite(int level, const char *file, int line, const char *func, uint32_t suppressed,
+              const char *format, ...) __attribute__((format(printf, 6, 7)));
+
+// Waits until everything queued so far has been written.
+void logFlush();
 
-#define WARNING(format, ...)                                                              \
-    do {                                                                                  \
-        printf("%s [%s %d]: => " format " \n", __LOG_WARN_PREFIX, __FUNCTION__, __LINE__, \
-               ##__VA_ARGS__);                                                            \
+}  // namespace common
+}  // namespace ual
+}  // namespace tecoal
+
+#define __LOG_AT(level, format, ...)                                                          \
+    do {                                                                                      \
+        static tecoal::ual::common::LogSite __log_site;                                       \
+        uint32_t __log_suppressed;                                                            \
+        if (tecoal::ual::common::logAllow(&__log_site, &__log_suppressed)) {                  \
+            tecoal::ual::common::logWrite(level, __FILE__, __LINE__, __FUNCTION__,            \
+                                          __log_suppressed, format, ##__VA_ARGS__);           \
+        }                                                                                     \
     } while (0)
 
-#define ERROR(format, ...)                                                              \
-    do {                                                                                \
-        printf("%s [%s %d]: %s => " format " \n", __LOG_ERR_PREFIX, __FILE__, __LINE__, \
-               __FUNCTION__, ##__VA_ARGS__);                                            \
+#define __LOG_NONE(format, ...) \
+    do {                        \
     } while (0)
 
+#if TECOAL_LOG_LEVEL <= TECOAL_LOG_LEVEL_DEBUG
+#define DLOG(format, ...) __LOG_AT(TECOAL_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define DLOG(format, ...) __LOG_NONE(format, ##__VA_ARGS__)
+#endif
+
+#if TECOAL_LOG_LEVEL <= TECOAL_LOG_LEVEL_INFO
+#define LOG(format, ...) __LOG_AT(TECOAL_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG(format, ...) __LOG_NONE(format, ##__VA_ARGS__)
+#endif
+
+#if TECOAL_LOG_LEVEL <= TECOAL_LOG_LEVEL_WARNING
+#define WARNING(format, ...) __LOG_AT(TECOAL_LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#else
+#define WARNING(format, ...) __LOG_NONE(format, ##__VA_ARGS__)
+#endif
+
+#if TECOAL_LOG_LEVEL <= TECOAL_LOG_LEVEL_ERROR
+#define ERROR(format, ...) __LOG_AT(TECOAL_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define ERROR(format, ...) __LOG_NONE(format, ##__VA_ARGS__)
+#endif
+
 #define ERROR_IF(cond, format, ...)         \
     do {                                    \
         if (cond) {                         \
@@ -0,0 +1,61 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_COM_SPE_COST_H_
+#define UAL_COM_SPE_COST_H_
+
+namespace tecoal {
+namespace ual {
+namespace common {
+
+#define SPE_SPM_BYTES (220 * 1024)  // SPM_MAX_BYTE of the kernels
+#define SPE_NUM 32                  // SPEs of one SPA
+
+// Cycle costs of one SPE, shared by the static model that ranks kernel candidates and the
+// emulator's timing model. The figures are rough placeholders meant to be calibrated against
+// hardware.
+struct SpeCost {
+    double clock_ghz = 1.5;
+    double dma_latency = 600;      // issue to completion of a global memory transfer
+    double dma_bytes = 32;         // per cycle of one SPE's DMA engine
+    double dma_burst = 64;         // every block of a transfer is rounded up to whole bursts
+    double global_bytes = 256;     // per cycle of global memory, shared by the launched SPEs
+    double noc_latency = 100;      // SPM to SPM: broadcast and RMA
+    double noc_bytes = 64;
+    double simd_cycles = 1;        // per vector op of 16 floats
+    double matmul_row_cycles = 1;  // per input row streamed through the 32x32 unit
+    double matmul_weight_cycles = 32;
+    double matmul_latency = 32;    // last row in to result out
+    double sync_cycles = 64;       // the last arrival at sync_threads to the release
+    double scalar_cycles = 2;      // per scalar multiply-add on SPM data
+    double global_access_cycles = 300;  // per scalar load or store straight to global memory
+};
+
+}  // namespace common
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_COM_SPE_COST_H_
@@ -0,0 +1,230 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_DMA_H_
+#define UAL_EMU_DMA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "ual/emu/spe.h"
+#include "ual/emu/timing.h"
+
+// DMA, broadcast, RMA and barriers of the SDAA runtime on emulated SPEs. Transfers are plain
+// memcpy and their data is in place when the call returns; what a wait does is move the
+// SPE's clock to the cycle the transfer would have landed, see timing.h.
+namespace sdaa {
+
+namespace emu = ::tecoal::ual::emu;
+
+enum MemcpyDirection { MemcpyGlobalToSpm, MemcpySpmToGlobal };
+enum BroadcastDirection { BroadcastGlobalToSpm, BroadcastSpmToSpm };
+enum RmaCompleteMode { RmaCustomizeMode };
+enum AddressMode { AddressLowToHigh, AddressHighToLow };
+
+// count blocks, gap bytes apart in global memory and packed in SPM
+struct Stride {
+    Stride() = default;
+    Stride(int count, int gap) : count(count), gap(gap) {}
+    int count = 0;
+    int gap = 0;
+};
+
+struct MemcpyHandle {
+    MemcpyHandle() = default;
+    explicit MemcpyHandle(Stride *stride) : stride(stride) {}
+    Stride *stride = nullptr;
+    uint64_t done = 0;  // cycle the last transfer on the handle lands
+};
+
+struct ThreadGroup {
+    explicit ThreadGroup(uint32_t mask) : mask(mask) {}
+    uint32_t mask;
+};
+
+// Without a group a broadcast reaches every SPE, without a stride it moves one block.
+struct BroadcastHandle {
+    explicit BroadcastHandle(ThreadGroup *group = nullptr, Stride *stride = nullptr)
+        : group(group), stride(stride), id(emu::newHandleId()) {}
+    explicit BroadcastHandle(Stride *stride) : BroadcastHandle(nullptr, stride) {}
+    ThreadGroup *group;
+    Stride *stride;
+    int id;
+    uint64_t done = 0;
+};
+
+struct RmaHandle {
+    RmaHandle() : id(emu::newHandleId()) {}
+    int target = -1;
+    int id;
+};
+
+// malloc inside a kernel, see sdaa_emu.h
+inline void *spm_malloc(size_t bytes, AddressMode mode = AddressLowToHigh) {
+    return emu::spmMalloc(bytes, mode == AddressHighToLow);
+}
+
+inline void stride_config(Stride &stride, int count, int gap) {  // NOLINT
+    stride.count = count;
+    stride.gap = gap;
+}
+
+// Returns the cycle the transfer lands.
+inline uint64_t dma_copy(void *dst, const void *src, size_t bytes, MemcpyDirection dir) {
+    if (bytes == 0) return emu::now();
+    if (dir == MemcpyGlobalToSpm) {
+        emu::checkSpm(dst, bytes, "memcpy_async destination");
+    } else {
+        emu::checkSpm(src, bytes, "memcpy_async source");
+    }
+    memcpy(dst, src, bytes);
+    return emu::dmaIssue(bytes, emu::LINK_GLOBAL);
+}
+
+inline void memcpy_async(void *dst, const void *src, size_t bytes, MemcpyDirection dir) {
+    dma_copy(dst, src, bytes, dir);
+}
+
+inline void memcpy_async(void *dst, const void *src, size_t bytes, MemcpyDirection dir,
+                         MemcpyHandle &handle) {  // NOLINT
+    handle.done = dma_copy(dst, src, bytes, dir);
+}
+
+inline void memcpy_wait() { emu::waitDma(); }
+inline void memcpy_wait(MemcpyHandle &handle) { emu::waitUntil(handle.done); }  // NOLINT
+
+// memcpy inside a kernel, see sdaa_emu.h: a blocking DMA, or an SPM to SPM copy.
+inline void *memcpy_sync(void *dst, const void *src, size_t bytes) {
+    memcpy(dst, src, bytes);
+    emu::Link link = emu::isSpm(dst) && emu::isSpm(src) ? emu::LINK_SPM : emu::LINK_GLOBAL;
+    emu::waitUntil(emu::dmaIssue(bytes, link));
+    return dst;
+}
+
+// Copies without timing and returns the packed size.
+inline size_t stride_copy(void *dst, const void *src, size_t block, const Stride &stride) {
+    size_t step = block + stride.gap;
+    size_t packed = block * stride.count;
+    if (packed == 0) return 0;
+    if (emu::isSpm(dst)) {
+        emu::checkSpm(dst, packed, "memcpy_stride destination");
+        for (int i = 0; i < stride.count; ++i) {
+            memcpy((char *)dst + i * block, (const char *)src + i * step, block);
+        }
+    } else {
+        emu::checkSpm(src, packed, "memcpy_stride source");
+        for (int i = 0; i < stride.count; ++i) {
+            memcpy((char *)dst + i * step, (const char *)src + i * block, block);
+        }
+    }
+    return packed;
+}
+
+// The SPM side, told apart by address, is packed; the global side skips stride.gap bytes
+// after every block. Blocks until done.
+inline void memcpy_stride(void *dst, const void *src, size_t block, const Stride &stride) {
+    size_t packed = stride_copy(dst, src, block, stride);
+    emu::waitUntil(emu::dmaIssue(packed, emu::LINK_GLOBAL, block));
+}
+
+// Global to SPM: the source SPE fetches once for the whole group; here every member fetches
+// its own copy, which leaves the same bytes in each SPM.
+inline void broadcast_async(void *dst, const void *src, size_t bytes, int thread,
+                            BroadcastDirection dir, BroadcastHandle &handle) {  // NOLINT
+    if (dir != BroadcastGlobalToSpm) {
+        emu::fault("broadcast from SPE %d is not global to SPM", thread);
+    }
+    if (handle.stride != nullptr) {
+        size_t packed = stride_copy(dst, src, bytes, *handle.stride);
+        handle.done = emu::dmaIssue(packed, emu::LINK_BROADCAST, bytes);
+    } else {
+        emu::checkSpm(dst, bytes, "broadcast destination");
+        memcpy(dst, src, bytes);
+        handle.done = emu::dmaIssue(bytes, emu::LINK_BROADCAST);
+    }
+}
+
+inline void broadcast(void *dst, const void *src, size_t bytes, int thread,
+                      BroadcastDirection dir, BroadcastHandle &handle) {  // NOLINT
+    broadcast_async(dst, src, bytes, thread, dir, handle);
+    emu::waitUntil(handle.done);
+}
+
+// SPM to SPM: copies src into dst of every group member, this SPE included when it is in the
+// group, and posts one completion to each.
+inline void broadcast_async(void *dst, const void *src, size_t bytes, BroadcastDirection dir,
+                            BroadcastHandle &handle) {  // NOLINT
+    if (dir != BroadcastSpmToSpm) emu::fault("broadcast without a source SPE is not SPM to SPM");
+    emu::checkSpm(src, bytes, "broadcast source");
+    uint32_t mask = handle.group != nullptr ? handle.group->mask : 0xFFFFFFFFu;
+    uint64_t done = emu::dmaIssue(bytes, emu::LINK_SPM);
+    for (int spe = 0; spe < emu::speNum(); ++spe) {
+        if (!(mask >> spe & 1)) continue;
+        memmove(emu::remoteSpm(dst, spe), src, bytes);
+        emu::post(spe, handle.id, done);
+    }
+}
+
+inline void broadcast_wait(BroadcastHandle &handle) { emu::waitUntil(handle.done); }  // NOLINT
+inline void broadcast_wait(BroadcastHandle &handle, int num) {  // NOLINT
+    emu::await(handle.id, num);
+}
+
+inline void rma_set_thread_id(RmaHandle &handle, int thread) {  // NOLINT
+    handle.target = thread;
+}
+
+// Both directions name the local buffer first; the remote one is the same SPM address on the
+// handle's target SPE.
+inline void rma_async_put(const void *local_src, void *remote_dst, size_t bytes,
+                          RmaHandle &handle) {  // NOLINT
+    emu::checkSpm(local_src, bytes, "rma_async_put source");
+    memcpy(emu::remoteSpm(remote_dst, handle.target), local_src, bytes);
+    emu::dmaIssue(bytes, emu::LINK_SPM);
+}
+
+inline void rma_async_get(void *local_dst, const void *remote_src, size_t bytes,
+                          RmaHandle &handle) {  // NOLINT
+    emu::checkSpm(local_dst, bytes, "rma_async_get destination");
+    memcpy(local_dst, emu::remoteSpm(remote_src, handle.target), bytes);
+    emu::dmaIssue(bytes, emu::LINK_SPM);
+}
+
+// The target sees the completion once every transfer queued so far has landed.
+inline void rma_complete(RmaHandle &handle, RmaCompleteMode mode) {  // NOLINT
+    emu::post(handle.target, handle.id, emu::dmaDone());
+}
+
+inline void rma_wait(RmaHandle &handle, int num) {  // NOLINT
+    emu::await(handle.id, num);
+}
+
+inline void sync_threads() { emu::barrier(0xFFFFFFFFu); }
+inline void sync_threads(const ThreadGroup &group) { emu::barrier(group.mask); }
+
+}  // namespace sdaa
+
+#endif  // UAL_EMU_DMA_H_
@@ -0,0 +1,135 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_INCLUDE_SDAA_MATMUL_H_
+#define UAL_EMU_INCLUDE_SDAA_MATMUL_H_
+
+#include <stdint.h>
+#include <vector>
+#include "ual/emu/spe.h"
+#include "ual/emu/timing.h"
+
+// The SPE matrix unit: a 32x32 half weight, input rows streamed through it and a float
+// accumulator of 32 columns per output row. Results are computed on the call; the unit's
+// clock only decides how long the waits and the store stall.
+namespace sdaa {
+
+enum MatmulType { MatmulHalfToHalf, MatmulHalfToFloat };
+enum MatmulK { MatmulK32 = 32 };
+enum MatmulN { MatmulN32 = 32 };
+enum MatmulRowOffsetMode { MatmulDisableOutputRowOffset, MatmulEnableOutputRowOffset };
+
+struct MatmulHandle {
+    MatmulType type = MatmulHalfToFloat;
+    float weight[MatmulK32][MatmulN32];
+    std::vector<float> acc;  // MatmulN32 floats per output row
+    int row_offset = 0;
+    bool flushing = false;  // the next store also clears the accumulator
+    uint64_t weight_loaded = 0;  // cycles at which the unit has taken the last weight and input
+    uint64_t input_loaded = 0;
+};
+
+inline void matmul_init(MatmulHandle &handle, MatmulType type) {  // NOLINT
+    handle.type = type;
+    handle.acc.clear();
+    handle.row_offset = 0;
+    handle.flushing = false;
+}
+
+// weight is k rows of n halves, packed
+inline void matmul_load_weight(MatmulHandle &handle, const void *weight, MatmulK k,
+                               MatmulN n) {  // NOLINT
+    ::tecoal::ual::emu::checkSpm(weight, k * n * sizeof(_Float16), "matmul weight");
+    const _Float16 *w = (const _Float16 *)weight;
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < n; ++j) handle.weight[i][j] = (float)w[i * n + j];
+    }
+    handle.weight_loaded =
+        ::tecoal::ual::emu::matmulIssue(::tecoal::ual::emu::costModel().matmul_weight_cycles);
+}
+
+inline void matmul_set_output_row_offset(MatmulHandle &handle, MatmulRowOffsetMode mode,
+                                         int offset) {  // NOLINT
+    handle.row_offset = mode == MatmulEnableOutputRowOffset ? offset : 0;
+}
+
+inline void matmul_set_flushing_output(MatmulHandle &handle, bool flushing) {  // NOLINT
+    handle.flushing = flushing;
+}
+
+// Input row r is k halves at input + r * (ld_blocks + 1) * 32 and accumulates into output
+// row row_offset + r.
+inline void matmul_compute(MatmulHandle &handle, const void *input, int rows, MatmulK k,
+                           int ld_blocks) {  // NOLINT
+    const int ld = (ld_blocks + 1) * MatmulK32;
+    const _Float16 *x = (const _Float16 *)input;
+    ::tecoal::ual::emu::checkSpm(x, ((rows - 1) * ld + k) * sizeof(_Float16), "matmul input");
+    size_t need = (size_t)(handle.row_offset + rows) * MatmulN32;
+    if (handle.acc.size() < need) handle.acc.resize(need, 0.0f);
+    for (int r = 0; r < rows; ++r) {
+        float *acc = handle.acc.data() + (size_t)(handle.row_offset + r) * MatmulN32;
+        for (int i = 0; i < k; ++i) {
+            float xv = (float)x[r * ld + i];
+            for (int j = 0; j < MatmulN32; ++j) acc[j] += xv * handle.weight[i][j];
+        }
+    }
+    handle.input_loaded =
+        ::tecoal::ual::emu::matmulIssue(rows * ::tecoal::ual::emu::costModel().matmul_row_cycles);
+}
+
+// Writes rows x n results, packed, as half or float depending on the handle type.
+inline void matmul_store(MatmulHandle &handle, void *output, int rows, MatmulN n) {  // NOLINT
+    size_t elem = handle.type == MatmulHalfToHalf ? sizeof(_Float16) : sizeof(float);
+    ::tecoal::ual::emu::checkSpm(output, rows * n * elem, "matmul output");
+    ::tecoal::ual::emu::waitMatmul();
+    size_t need = (size_t)rows * MatmulN32;
+    if (handle.acc.size() < need) handle.acc.resize(need, 0.0f);
+    for (int r = 0; r < rows; ++r) {
+        for (int j = 0; j < n; ++j) {
+            float v = handle.acc[(size_t)r * MatmulN32 + j];
+            if (handle.type == MatmulHalfToHalf) {
+                ((_Float16 *)output)[r * n + j] = (_Float16)v;
+            } else {
+                ((float *)output)[r * n + j] = v;
+            }
+        }
+    }
+    if (handle.flushing) handle.acc.assign(handle.acc.size(), 0.0f);
+}
+
+inline void matmul_wait(MatmulHandle &handle) {  // NOLINT
+    ::tecoal::ual::emu::waitMatmul();
+}
+inline void matmul_wait_loading_input(MatmulHandle &handle) {  // NOLINT
+    ::tecoal::ual::emu::waitUntil(handle.input_loaded);
+}
+inline void matmul_wait_loading_weight(MatmulHandle &handle) {  // NOLINT
+    ::tecoal::ual::emu::waitUntil(handle.weight_loaded);
+}
+
+}  // namespace sdaa
+
+#endif  // UAL_EMU_INCLUDE_SDAA_MATMUL_H_
@@ -0,0 +1,123 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_INCLUDE_SDAA_RUNTIME_H_
+#define UAL_EMU_INCLUDE_SDAA_RUNTIME_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+
+// The part of the SDAA runtime the library and its callers use, for builds against the
+// emulator. Device memory is host memory and kernels finish before their launch returns, so
+// streams carry no state. Events stamp the emulated device clock of the calling thread, which
+// advances by the predicted time of each launch, so the time between two events is what the
+// device would have spent on the launches in between.
+
+typedef struct sdaaStreamEmu *sdaaStream_t;
+struct sdaaEventEmu {
+    uint64_t ns;
+};
+typedef sdaaEventEmu *sdaaEvent_t;
+
+enum sdaaError_t { sdaaSuccess = 0, sdaaErrorMemoryAllocation = 2, sdaaErrorNotReady = 600 };
+
+// ual/emu/timing.cpp
+uint64_t sdaaEmuDeviceNs();
+
+enum sdaaMemcpyKind {
+    sdaaMemcpyHostToHost,
+    sdaaMemcpyHostToDevice,
+    sdaaMemcpyDeviceToHost,
+    sdaaMemcpyDeviceToDevice
+};
+
+inline sdaaError_t sdaaMalloc(void **ptr, size_t bytes) {
+    *ptr = malloc(bytes);
+    return *ptr != nullptr || bytes == 0 ? sdaaSuccess : sdaaErrorMemoryAllocation;
+}
+
+inline sdaaError_t sdaaFree(void *ptr) {
+    free(ptr);
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaMemcpy(void *dst, const void *src, size_t bytes, sdaaMemcpyKind kind) {
+    memcpy(dst, src, bytes);
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaMemset(void *ptr, int value, size_t bytes) {
+    memset(ptr, value, bytes);
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaStreamCreate(sdaaStream_t *stream) {
+    *stream = nullptr;
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaStreamDestroy(sdaaStream_t stream) { return sdaaSuccess; }
+inline sdaaError_t sdaaStreamSynchronize(sdaaStream_t stream) { return sdaaSuccess; }
+inline sdaaError_t sdaaDeviceSynchronize() { return sdaaSuccess; }
+
+inline sdaaError_t sdaaEventCreate(sdaaEvent_t *event) {
+    *event = new sdaaEventEmu{0};
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaEventDestroy(sdaaEvent_t event) {
+    delete event;
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaEventRecord(sdaaEvent_t event, sdaaStream_t stream) {
+    event->ns = sdaaEmuDeviceNs();
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaEventQuery(sdaaEvent_t event) { return sdaaSuccess; }
+inline sdaaError_t sdaaEventSynchronize(sdaaEvent_t event) { return sdaaSuccess; }
+
+inline sdaaError_t sdaaEventElapsedTime(float *ms, sdaaEvent_t start, sdaaEvent_t end) {
+    *ms = (float)((double)(int64_t)(end->ns - start->ns) / 1e6);
+    return sdaaSuccess;
+}
+
+inline sdaaError_t sdaaStreamWaitEvent(sdaaStream_t stream, sdaaEvent_t event,
+                                       unsigned int flags) {
+    return sdaaSuccess;
+}
+
+#define __global__
+#define __device__
+
+typedef _Float16 half;
+
+#endif  // UAL_EMU_INCLUDE_SDAA_RUNTIME_H_
@@ -0,0 +1,57 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_SDAA_EMU_H_
+#define UAL_EMU_SDAA_EMU_H_
+
+// Force-included ahead of every .scpp when the kernels are built as host C++ (UAL_BUILD_EMU),
+// with ual/emu/include on the include path for the SDK headers. Each SPE is a thread of
+// emu::run with a private SPM arena; malloc and free inside a kernel work on that arena and
+// memcpy is a blocking DMA on the SPE's clock.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <type_traits>
+#include <sdaa_runtime.h>
+#include "ual/emu/dma.h"
+#include "ual/emu/simd.h"
+#include "ual/emu/spe.h"
+
+#define __thread_local thread_local
+
+#define threadIdx (::tecoal::ual::emu::speId())
+#define threadDim (::tecoal::ual::emu::speNum())
+
+// every header that calls the C allocator or memcpy is included above
+#define malloc(...) ::sdaa::spm_malloc(__VA_ARGS__)
+#define free(ptr) ::tecoal::ual::emu::spmFree(ptr)
+#define memcpy(dst, src, bytes) ::sdaa::memcpy_sync(dst, src, bytes)
+
+#endif  // UAL_EMU_SDAA_EMU_H_
@@ -0,0 +1,171 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_SIMD_H_
+#define UAL_EMU_SIMD_H_
+
+#include <math.h>
+#include <string.h>
+#include <type_traits>
+#include "ual/emu/timing.h"
+
+// SIMD types of the SDAA compiler. A GCC vector can neither be built from a scalar nor
+// converted to another element type implicitly, both of which the kernels rely on, so the
+// vector is wrapped. The wrapper has the vector's size and layout and kernels may alias it.
+// Every arithmetic op, compare, conversion, load and store counts as one vector op for the
+// timing model.
+template <typename T, int N>
+class SimdVec {
+ public:
+    typedef T Raw __attribute__((vector_size(sizeof(T) * N)));
+
+    SimdVec() = default;
+    SimdVec(const Raw &raw) : raw_(raw) {}  // NOLINT
+    template <typename S,
+              typename = typename std::enable_if<std::is_convertible<S, T>::value>::type>
+    SimdVec(S scalar) : raw_(Raw{} + static_cast<T>(scalar)) {}  // NOLINT
+    template <typename U>
+    SimdVec(const SimdVec<U, N> &other)  // NOLINT
+        : raw_(__builtin_convertvector(other.raw(), Raw)) {
+        ::tecoal::ual::emu::simdOp();
+    }
+
+    const Raw &raw() const { return raw_; }
+    T operator[](int i) const { return raw_[i]; }
+
+    friend SimdVec operator+(const SimdVec &a, const SimdVec &b) { return op(a.raw_ + b.raw_); }
+    friend SimdVec operator-(const SimdVec &a, const SimdVec &b) { return op(a.raw_ - b.raw_); }
+    friend SimdVec operator*(const SimdVec &a, const SimdVec &b) { return op(a.raw_ * b.raw_); }
+    friend SimdVec operator/(const SimdVec &a, const SimdVec &b) { return op(a.raw_ / b.raw_); }
+    SimdVec operator-() const { return op(-raw_); }
+    SimdVec &operator+=(const SimdVec &b) { return *this = *this + b; }
+    SimdVec &operator-=(const SimdVec &b) { return *this = *this - b; }
+    SimdVec &operator*=(const SimdVec &b) { return *this = *this * b; }
+    SimdVec &operator/=(const SimdVec &b) { return *this = *this / b; }
+
+    // comparisons give 1 or 0 per lane, in the element type
+#define SIMD_EMU_COMPARE(op)                                      \
+    friend SimdVec operator op(const SimdVec &a, const SimdVec &b) { \
+        return lanes(a.raw_ op b.raw_);                           \
+    }
+    SIMD_EMU_COMPARE(==)
+    SIMD_EMU_COMPARE(!=)
+    SIMD_EMU_COMPARE(<)
+    SIMD_EMU_COMPARE(<=)
+    SIMD_EMU_COMPARE(>)
+    SIMD_EMU_COMPARE(>=)
+#undef SIMD_EMU_COMPARE
+
+ private:
+    template <typename Mask>
+    static SimdVec lanes(const Mask &mask) {
+        return op(__builtin_convertvector(-mask, Raw));
+    }
+
+    static SimdVec op(const Raw &result) {
+        ::tecoal::ual::emu::simdOp();
+        return result;
+    }
+
+    Raw raw_;
+};
+
+typedef SimdVec<float, 16> floatv16;
+typedef SimdVec<_Float16, 16> float16v16;
+typedef SimdVec<int, 16> intv16;
+typedef SimdVec<short, 32> shortv32;
+
+// Aligned and unaligned accesses are the same on the host.
+template <typename T, int N>
+inline void simd_load(SimdVec<T, N> &v, const void *src) {  // NOLINT
+    memcpy(&v, src, sizeof(v));
+    ::tecoal::ual::emu::simdOp();
+}
+
+template <typename T, int N>
+inline void simd_loadu(SimdVec<T, N> &v, const void *src) {  // NOLINT
+    memcpy(&v, src, sizeof(v));
+    ::tecoal::ual::emu::simdOp();
+}
+
+template <typename T, int N>
+inline void simd_store(const SimdVec<T, N> &v, void *dst) {
+    memcpy(dst, &v, sizeof(v));
+    ::tecoal::ual::emu::simdOp();
+}
+
+template <typename T, int N>
+inline void simd_storeu(const SimdVec<T, N> &v, void *dst) {
+    memcpy(dst, &v, sizeof(v));
+    ::tecoal::ual::emu::simdOp();
+}
+
+// one byte per lane in memory, bool or uint8_t
+template <typename T, int N, typename Byte>
+inline void simd_load_widen(SimdVec<T, N> &v, const Byte *src) {  // NOLINT
+    static_assert(sizeof(Byte) == 1, "simd_load_widen reads bytes");
+    typename SimdVec<T, N>::Raw raw;
+    for (int i = 0; i < N; ++i) raw[i] = static_cast<T>(src[i]);
+    v = raw;
+    ::tecoal::ual::emu::simdOp();
+}
+
+template <typename T, int N, typename Byte>
+inline void simd_store_narrow(const SimdVec<T, N> &v, Byte *dst) {
+    static_assert(sizeof(Byte) == 1, "simd_store_narrow writes bytes");
+    for (int i = 0; i < N; ++i) dst[i] = static_cast<Byte>(v[i]);
+    ::tecoal::ual::emu::simdOp();
+}
+
+// zero extends N narrower integers
+template <typename T, int N, typename S>
+inline void simd_load_u_ext(SimdVec<T, N> &v, const S *src) {  // NOLINT
+    typedef typename std::make_unsigned<S>::type U;
+    typename SimdVec<T, N>::Raw raw;
+    for (int i = 0; i < N; ++i) raw[i] = static_cast<T>(static_cast<U>(src[i]));
+    v = raw;
+    ::tecoal::ual::emu::simdOp();
+}
+
+// a where cond is 0, b elsewhere
+template <typename T, int N>
+inline SimdVec<T, N> simd_seleq(const SimdVec<T, N> &cond, const SimdVec<T, N> &a,
+                                const SimdVec<T, N> &b) {
+    ::tecoal::ual::emu::simdOp();
+    return cond.raw() == 0 ? a.raw() : b.raw();
+}
+
+inline float16v16 simd_cvt_f2h(const floatv16 &v) { return v; }
+inline float16v16 simd_vfcvtsh(const floatv16 &v) { return v; }
+inline floatv16 simd_vfcvths(const float16v16 &v) { return v; }
+
+// in place over 128 floats, timed as eight vector ops for each of the 8 vectors
+inline void simd_sigmoid128(float *x) {
+    for (int i = 0; i < 128; ++i) x[i] = 1.0f / (1.0f + expf(-x[i]));
+    ::tecoal::ual::emu::simdOp(64);
+}
+
+#endif  // UAL_EMU_SIMD_H_
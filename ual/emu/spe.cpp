@@ -0,0 +1,334 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/emu/spe.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "ual/com/log.h"
+#include "ual/emu/timing.h"
+
+namespace tecoal {
+namespace ual {
+namespace emu {
+
+#define EMU_TLS_WINDOW (64 * 1024)  // thread locals this close to the anchor count as SPM
+#define EMU_SPM_POISON 0xcd         // fresh SPM blocks are filled with this, as on device
+
+struct Launch;
+
+struct Spe {
+    int id = 0;
+    Launch *launch = nullptr;
+    std::unique_ptr<char[]> storage;
+    char *spm = nullptr;
+    std::map<size_t, size_t> blocks;  // live allocations, offset to size
+    const char *tls = nullptr;        // this thread's tls_anchor
+    int next_handle = 0;
+    std::map<int, std::multiset<uint64_t>> mailbox;  // arrival cycles of posted completions
+    SpeClock clock;
+    // what the SPE is blocked on, null while it runs
+    const std::function<bool()> *ready = nullptr;
+};
+
+struct Barrier {
+    int arrived = 0;
+    uint64_t generation = 0;
+    uint64_t latest = 0;   // the latest arrival of this generation, in cycles
+    uint64_t release = 0;  // when the previous generation left
+};
+
+struct Launch {
+    const char *name = nullptr;
+    int spe_num = 0;
+    std::vector<Spe> spes;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::map<uint32_t, Barrier> barriers;
+    int started = 0;
+    int alive = 0;
+    int blocked = 0;
+    bool faulted = false;
+};
+
+static thread_local Spe *current_spe = nullptr;
+static thread_local char tls_anchor;
+
+static Spe &self() {
+    if (current_spe == nullptr) {
+        ERROR("SDAA intrinsic called outside an emulated SPE");
+        throw Fault();
+    }
+    return *current_spe;
+}
+
+static uint32_t launchedMask(const Launch &l) {
+    return l.spe_num >= 32 ? 0xFFFFFFFFu : (1u << l.spe_num) - 1;
+}
+
+// Caller holds the launch mutex.
+static void raise(Launch *l) {
+    l->faulted = true;
+    l->cond.notify_all();
+}
+
+// Caller holds the launch mutex. A launch is stuck when every live SPE is blocked and none of
+// them can go on; on device it would hang.
+static bool stuck(const Launch &l) {
+    if (l.alive == 0 || l.blocked < l.alive) return false;
+    for (const Spe &spe : l.spes) {
+        if (spe.ready != nullptr && (*spe.ready)()) return false;
+    }
+    return true;
+}
+
+// Blocks the calling SPE until ready() holds. Throws Fault once the launch has faulted.
+static void block(Spe &spe, std::unique_lock<std::mutex> &lock, const std::function<bool()> &ready,
+                  const char *what) {
+    Launch *l = spe.launch;
+    if (l->faulted) throw Fault();
+    if (ready()) return;
+    spe.ready = &ready;
+    ++l->blocked;
+    if (stuck(*l)) {
+        ERROR("%s SPE %d: deadlock in %s, all %d live SPEs are blocked", l->name, spe.id, what,
+              l->alive);
+        raise(l);
+    }
+    l->cond.wait(lock, [&]() { return l->faulted || ready(); });
+    --l->blocked;
+    spe.ready = nullptr;
+    if (l->faulted) throw Fault();
+}
+
+void fault(const char *format, ...) {
+    char msg[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(msg, sizeof(msg), format, args);
+    va_end(args);
+    Spe &spe = self();
+    ERROR("%s SPE %d: %s", spe.launch->name, spe.id, msg);
+    std::lock_guard<std::mutex> lock(spe.launch->mutex);
+    raise(spe.launch);
+    throw Fault();
+}
+
+static void speMain(Launch *l, int id, const std::function<void()> *body) {
+    Spe &spe = l->spes[id];
+    current_spe = &spe;
+    {
+        // remoteSpm needs the thread locals of every SPE, so no kernel starts before all have
+        std::unique_lock<std::mutex> lock(l->mutex);
+        spe.tls = &tls_anchor;
+        if (++l->started == l->spe_num) l->cond.notify_all();
+        l->cond.wait(lock, [&]() { return l->started == l->spe_num; });
+    }
+    startClock(&spe.clock, l->spe_num);
+    try {
+        (*body)();
+    } catch (const Fault &) {
+    }
+    stopClock();
+    current_spe = nullptr;
+    std::lock_guard<std::mutex> lock(l->mutex);
+    --l->alive;
+    if (!l->faulted && stuck(*l)) {
+        ERROR("SPE %d returned while the other live SPEs are blocked", id);
+        raise(l);
+    }
+}
+
+int run(const std::function<void()> &body, int spe_num, const char *name) {
+    Launch l;
+    l.name = name;
+    l.spe_num = spe_num;
+    l.alive = spe_num;
+    l.spes.resize(spe_num);
+    for (int i = 0; i < spe_num; ++i) {
+        Spe &spe = l.spes[i];
+        spe.id = i;
+        spe.launch = &l;
+        spe.storage.reset(new char[EMU_SPM_BYTES + EMU_SPM_ALIGN]);
+        uintptr_t base = reinterpret_cast<uintptr_t>(spe.storage.get());
+        spe.spm = spe.storage.get() + (EMU_SPM_ALIGN - base % EMU_SPM_ALIGN) % EMU_SPM_ALIGN;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(spe_num);
+    for (int i = 0; i < spe_num; ++i) threads.emplace_back(speMain, &l, i, &body);
+    for (std::thread &t : threads) t.join();
+    std::vector<SpeClock *> clocks;
+    for (Spe &spe : l.spes) clocks.push_back(&spe.clock);
+    finishLaunch(name, clocks);
+    return l.faulted ? -1 : 0;
+}
+
+int speId() { return self().id; }
+
+int speNum() { return self().launch->spe_num; }
+
+// Offset for size bytes in the lowest or highest gap between live blocks, -1 if none fits
+static int64_t findGap(const std::map<size_t, size_t> &blocks, size_t size, bool from_top) {
+    int64_t offset = -1;
+    size_t begin = 0;
+    auto gap = [&](size_t end) {
+        if (end - begin < size || (offset >= 0 && !from_top)) return;
+        offset = from_top ? end - size : begin;
+    };
+    for (const auto &block : blocks) {
+        gap(block.first);
+        begin = block.first + block.second;
+    }
+    gap(EMU_SPM_BYTES);
+    return offset;
+}
+
+void *spmMalloc(size_t bytes, bool from_top) {
+    Spe &spe = self();
+    size_t size = (bytes + EMU_SPM_ALIGN - 1) / EMU_SPM_ALIGN * EMU_SPM_ALIGN;
+    int64_t offset = findGap(spe.blocks, size, from_top);
+    if (offset < 0) {
+        size_t used = 0;
+        for (const auto &block : spe.blocks) used += block.second;
+        fault("SPM overflow, malloc(%zu) with %zu of %d bytes in use", bytes, used,
+              EMU_SPM_BYTES);
+    }
+    spe.blocks[offset] = size;
+    memset(spe.spm + offset, EMU_SPM_POISON, size);
+    return spe.spm + offset;
+}
+
+void spmFree(void *ptr) {
+    if (ptr == nullptr) return;
+    Spe &spe = self();
+    char *p = static_cast<char *>(ptr);
+    auto it = p >= spe.spm ? spe.blocks.find(p - spe.spm) : spe.blocks.end();
+    if (it == spe.blocks.end()) {
+        WARNING("%s SPE %d: free(%p) is not the start of a live SPM block", spe.launch->name,
+                spe.id, ptr);
+        return;
+    }
+    spe.blocks.erase(it);
+}
+
+static bool inTls(const Spe &spe, const char *p) {
+    return p + EMU_TLS_WINDOW > spe.tls && p < spe.tls + EMU_TLS_WINDOW;
+}
+
+bool isSpm(const void *ptr) {
+    const Spe &spe = self();
+    const char *p = static_cast<const char *>(ptr);
+    return (p >= spe.spm && p < spe.spm + EMU_SPM_BYTES) || inTls(spe, p);
+}
+
+void checkSpm(const void *ptr, size_t bytes, const char *what) {
+    const Spe &spe = self();
+    const char *p = static_cast<const char *>(ptr);
+    if (inTls(spe, p) && inTls(spe, p + bytes - 1)) return;
+    if (p >= spe.spm && p < spe.spm + EMU_SPM_BYTES) {
+        size_t offset = p - spe.spm;
+        auto it = spe.blocks.upper_bound(offset);
+        if (it != spe.blocks.begin()) {
+            --it;
+            if (offset + bytes <= it->first + it->second) return;
+        }
+    }
+    fault("%s of %zu bytes at %p is outside any live SPM block", what, bytes, ptr);
+}
+
+void *remoteSpm(const void *ptr, int spe) {
+    const Spe &from = self();
+    const Launch &l = *from.launch;
+    if (spe < 0 || spe >= l.spe_num) fault("SPE %d is not part of the launch", spe);
+    const Spe &to = l.spes[spe];
+    const char *p = static_cast<const char *>(ptr);
+    if (p >= from.spm && p < from.spm + EMU_SPM_BYTES) return to.spm + (p - from.spm);
+    if (inTls(from, p)) {
+        if (to.tls == nullptr) fault("SPE %d has not started yet", spe);
+        return const_cast<char *>(to.tls + (p - from.tls));
+    }
+    fault("%p is not an SPM address", ptr);
+}
+
+int newHandleId() { return self().next_handle++; }
+
+void post(int spe, int handle_id, uint64_t cycle) {
+    Launch *l = self().launch;
+    if (spe < 0 || spe >= l->spe_num) fault("SPE %d is not part of the launch", spe);
+    std::lock_guard<std::mutex> lock(l->mutex);
+    l->spes[spe].mailbox[handle_id].insert(cycle);
+    l->cond.notify_all();
+}
+
+void await(int handle_id, int n) {
+    Spe &spe = self();
+    std::unique_lock<std::mutex> lock(spe.launch->mutex);
+    std::multiset<uint64_t> &arrivals = spe.mailbox[handle_id];
+    std::function<bool()> ready = [&]() { return arrivals.size() >= (size_t)n; };
+    block(spe, lock, ready, "a broadcast or RMA wait");
+    if (n <= 0) return;
+    // the n earliest completions are the ones waited for
+    auto last = std::next(arrivals.begin(), n);
+    waitUntil(*std::prev(last));
+    arrivals.erase(arrivals.begin(), last);
+}
+
+void barrier(uint32_t mask) {
+    Spe &spe = self();
+    Launch *l = spe.launch;
+    mask &= launchedMask(*l);
+    if (!(mask >> spe.id & 1)) fault("sync_threads on a group without this SPE");
+    std::unique_lock<std::mutex> lock(l->mutex);
+    Barrier &b = l->barriers[mask];
+    b.latest = std::max(b.latest, now());
+    if (++b.arrived == __builtin_popcount(mask)) {
+        b.arrived = 0;
+        ++b.generation;
+        b.release = b.latest + (uint64_t)costModel().sync_cycles;
+        b.latest = 0;
+        l->cond.notify_all();
+        syncUntil(b.release);
+        return;
+    }
+    uint64_t generation = b.generation;
+    std::function<bool()> ready = [&]() { return b.generation != generation; };
+    block(spe, lock, ready, "sync_threads");
+    // nobody can arrive for the next generation before this SPE has, so release still holds
+    syncUntil(b.release);
+}
+
+}  // namespace emu
+}  // namespace ual
+}  // namespace tecoal
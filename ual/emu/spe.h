@@ -0,0 +1,94 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_SPE_H_
+#define UAL_EMU_SPE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+namespace tecoal {
+namespace ual {
+namespace emu {
+
+#define EMU_SPE_NUM 32              // SPEs of one SPA, the width of a launch
+// Private SPM of one SPE, SPM_MAX_BYTE of the kernels. The rest of the hardware SPM is not
+// theirs to use, so a kernel that needs more faults here instead of running.
+#define EMU_SPM_BYTES (220 * 1024)
+#define EMU_SPM_ALIGN 64
+
+// Thrown on the SPE threads when a launch faults; run() catches it.
+struct Fault {};
+
+// Runs body on spe_num threads, one per emulated SPE, each with a private SPM arena, and
+// returns once all of them have finished. Returns 0, or -1 when an SPE faulted: SPM overflow,
+// a DMA into memory that is not SPM, or all live SPEs blocked on each other. The fault is
+// logged with name, the kernel that caused it. The predicted
+// device time is left in lastTiming() under name, see timing.h.
+int run(const std::function<void()> &body, int spe_num, const char *name);
+
+template <typename ArgsType>
+int launch(void (*kernel)(ArgsType), const ArgsType &arg, const char *name = "kernel",
+           int spe_num = EMU_SPE_NUM) {
+    return run([&]() { kernel(arg); }, spe_num, name);
+}
+
+// Everything below is called from an SPE thread and acts on that SPE.
+int speId();
+int speNum();
+
+// First-fit allocator over the SPM arena, EMU_SPM_ALIGN aligned, searching upwards from the
+// bottom or downwards from the top. Running out faults instead of returning null, the kernels
+// do not check.
+void *spmMalloc(size_t bytes, bool from_top);
+void spmFree(void *ptr);
+
+// True for the SPE's arena and its thread locals, which live in SPM on device.
+bool isSpm(const void *ptr);
+// Faults unless [ptr, ptr + bytes) lies in one live SPM block or in the thread locals.
+void checkSpm(const void *ptr, size_t bytes, const char *what);
+// Where ptr, an address in this SPE's SPM, sits in the SPM of spe.
+void *remoteSpm(const void *ptr, int spe);
+
+// Completion mailboxes of broadcast and RMA handles. SPEs create their handles in the same
+// order, so the n-th handle of one SPE pairs up with the n-th handle of every other. A post
+// carries the cycle its data lands; await moves the clock to the latest of the n it takes.
+int newHandleId();
+void post(int spe, int handle_id, uint64_t cycle);
+void await(int handle_id, int n);
+
+// Blocks until every launched SPE in mask has arrived; all of them leave at the clock of the
+// last arrival.
+void barrier(uint32_t mask);
+
+[[noreturn]] void fault(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+}  // namespace emu
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_EMU_SPE_H_
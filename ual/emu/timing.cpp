@@ -0,0 +1,342 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/emu/timing.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include "ual/com/log.h"
+#include "ual/emu/spe.h"
+
+namespace tecoal {
+namespace ual {
+namespace emu {
+
+struct CostField {
+    const char *name;
+    double CostModel::*member;
+};
+
+static const CostField cost_fields[] = {
+    {"clock_ghz", &CostModel::clock_ghz},
+    {"dma_latency", &CostModel::dma_latency},
+    {"dma_bytes", &CostModel::dma_bytes},
+    {"dma_burst", &CostModel::dma_burst},
+    {"global_bytes", &CostModel::global_bytes},
+    {"noc_latency", &CostModel::noc_latency},
+    {"noc_bytes", &CostModel::noc_bytes},
+    {"simd_cycles", &CostModel::simd_cycles},
+    {"matmul_row_cycles", &CostModel::matmul_row_cycles},
+    {"matmul_weight_cycles", &CostModel::matmul_weight_cycles},
+    {"matmul_latency", &CostModel::matmul_latency},
+    {"sync_cycles", &CostModel::sync_cycles},
+};
+
+static CostModel parseCostModel(const char *spec) {
+    CostModel model;
+    std::string rest = spec != nullptr ? spec : "";
+    while (!rest.empty()) {
+        size_t comma = rest.find(',');
+        std::string item = rest.substr(0, comma);
+        rest = comma == std::string::npos ? "" : rest.substr(comma + 1);
+        if (item.empty()) continue;
+        size_t eq = item.find('=');
+        std::string key = item.substr(0, eq);
+        const CostField *field = nullptr;
+        for (const CostField &f : cost_fields) {
+            if (key == f.name) field = &f;
+        }
+        char *end = nullptr;
+        double value = eq == std::string::npos ? 0 : strtod(item.c_str() + eq + 1, &end);
+        if (field == nullptr || end == nullptr || *end != '\0' || !(value > 0)) {
+            WARNING("TECOAL_EMU_COST: ignoring %s", item.c_str());
+            continue;
+        }
+        model.*field->member = value;
+    }
+    return model;
+}
+
+CostModel &costModel() {
+    static CostModel model = parseCostModel(getenv("TECOAL_EMU_COST"));
+    return model;
+}
+
+// Launches kept for TECOAL_EMU_TIMELINE=<trace.json>, written at exit.
+class Timeline {
+ public:
+    static Timeline &instance() {
+        static Timeline timeline;
+        return timeline;
+    }
+
+    bool enabled() const { return path_ != nullptr; }
+
+    void record(const LaunchTiming &timing, std::vector<SpeClock> clocks) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        launches_.push_back({timing, std::move(clocks)});
+    }
+
+ private:
+    struct Entry {
+        LaunchTiming timing;
+        std::vector<SpeClock> clocks;
+    };
+
+    Timeline() : path_(getenv("TECOAL_EMU_TIMELINE")) {}
+    ~Timeline() {
+        if (path_ != nullptr) dump();
+    }
+    void dump();
+
+    const char *path_;
+    std::mutex mutex_;
+    std::vector<Entry> launches_;
+};
+
+static double toUs(uint64_t cycles) { return cycles / (costModel().clock_ghz * 1e3); }
+
+// Chrome trace, one process per launch and three threads per SPE: the instruction stream
+// with its SIMD work and stalls, the DMA engine and the matrix unit.
+void Timeline::dump() {
+    FILE *fp = fopen(path_, "w");
+    if (fp == nullptr) {
+        ERROR("can not open timeline file %s", path_);
+        return;
+    }
+    const char *sep = "";
+    auto span = [&](int pid, int tid, const char *name, const Span &s) {
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,"
+                "\"dur\":%.3f}", sep, name, pid, tid, toUs(s.begin), toUs(s.end - s.begin));
+        sep = ",";
+    };
+    auto label = [&](const char *kind, int pid, int tid, const std::string &name) {
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s\"}}", sep, kind, pid, tid, name.c_str());
+        sep = ",";
+    };
+
+    fprintf(fp, "{\"traceEvents\":[");
+    for (size_t pid = 0; pid < launches_.size(); ++pid) {
+        const LaunchTiming &t = launches_[pid].timing;
+        label("process_name", pid, 0, std::to_string(pid) + " " + t.name);
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%zu,\"tid\":0,\"ts\":0,"
+                "\"dur\":%.3f,\"args\":{\"spe_num\":%d,\"compute_us\":%.3f,\"matmul_us\":%.3f,"
+                "\"dma_us\":%.3f,\"overlap_us\":%.3f,\"sync_idle_us\":%.3f,"
+                "\"wait_idle_us\":%.3f}}",
+                sep, t.name, pid, toUs(t.cycles), t.spe_num, toUs(t.compute), toUs(t.matmul),
+                toUs(t.dma), toUs(t.overlap), toUs(t.sync_idle), toUs(t.wait_idle));
+        sep = ",";
+        const std::vector<SpeClock> &clocks = launches_[pid].clocks;
+        for (size_t spe = 0; spe < clocks.size(); ++spe) {
+            const SpeClock &c = clocks[spe];
+            int tid = 1 + spe * 3;
+            label("thread_name", pid, tid, "SPE " + std::to_string(spe));
+            label("thread_name", pid, tid + 1, "SPE " + std::to_string(spe) + " dma");
+            label("thread_name", pid, tid + 2, "SPE " + std::to_string(spe) + " matmul");
+            for (const Span &s : c.compute) span(pid, tid, "simd", s);
+            for (const Span &s : c.sync) span(pid, tid, "sync_threads", s);
+            for (const Span &s : c.wait) span(pid, tid, "wait", s);
+            for (const Span &s : c.dma) span(pid, tid + 1, "dma", s);
+            for (const Span &s : c.matmul) span(pid, tid + 2, "matmul", s);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    if (fclose(fp) != 0) ERROR("can not write timeline file %s", path_);
+}
+
+static thread_local SpeClock *current_clock = nullptr;
+static thread_local LaunchTiming last_timing = {"", 0, 0, 0, 0, 0, 0, 0, 0, 0};
+static thread_local uint64_t device_ns = 0;  // the thread's launches back to back
+
+const LaunchTiming &lastTiming() { return last_timing; }
+
+// Spans are appended in time order; one that touches the previous extends it.
+static void append(std::vector<Span> *spans, uint64_t begin, uint64_t end) {
+    if (end <= begin) return;
+    if (!spans->empty() && begin <= spans->back().end) {
+        spans->back().end = std::max(spans->back().end, end);
+        return;
+    }
+    spans->push_back({begin, end});
+}
+
+// The SPE's clock with the SIMD work retired since it last moved.
+static SpeClock &advance() {
+    if (current_clock == nullptr) fault("SDAA intrinsic called outside an emulated SPE");
+    SpeClock &c = *current_clock;
+    uint64_t &ops = simdOps();
+    if (ops != 0) {
+        uint64_t begin = c.now;
+        c.now += (uint64_t)ceil(ops * costModel().simd_cycles);
+        ops = 0;
+        append(&c.compute, begin, c.now);
+    }
+    return c;
+}
+
+void startClock(SpeClock *clock, int spe_num) {
+    *clock = SpeClock();
+    clock->spe_num = spe_num;
+    current_clock = clock;
+    simdOps() = 0;
+}
+
+// A kernel ends once its last transfer has landed.
+void stopClock() {
+    SpeClock &c = advance();
+    waitUntil(std::max(c.dma_done, c.matmul_done));
+    current_clock = nullptr;
+}
+
+uint64_t now() { return advance().now; }
+
+uint64_t dmaIssue(size_t bytes, Link link, size_t block) {
+    SpeClock &c = advance();
+    if (bytes == 0) return c.now;
+    const CostModel &m = costModel();
+    if (block == 0 || block > bytes) block = bytes;
+    double charged = ceil(block / m.dma_burst) * m.dma_burst * ((bytes + block - 1) / block);
+    double bandwidth = m.dma_bytes;
+    double latency = m.dma_latency;
+    if (link == LINK_GLOBAL) {
+        bandwidth = std::min(bandwidth, m.global_bytes / c.spe_num);
+    } else if (link == LINK_SPM) {
+        bandwidth = m.noc_bytes;
+        latency = m.noc_latency;
+    }
+    uint64_t start = std::max(c.now, c.dma_free);
+    c.dma_free = start + (uint64_t)ceil(charged / bandwidth);
+    uint64_t done = c.dma_free + (uint64_t)latency;
+    c.dma_done = std::max(c.dma_done, done);
+    append(&c.dma, start, done);
+    return done;
+}
+
+uint64_t dmaDone() { return advance().dma_done; }
+
+uint64_t matmulIssue(double cycles) {
+    SpeClock &c = advance();
+    uint64_t start = std::max(c.now, c.matmul_free);
+    c.matmul_free = start + (uint64_t)ceil(cycles);
+    c.matmul_done = c.matmul_free + (uint64_t)costModel().matmul_latency;
+    append(&c.matmul, start, c.matmul_free);
+    return c.matmul_free;
+}
+
+void waitUntil(uint64_t cycle) {
+    SpeClock &c = advance();
+    if (cycle <= c.now) return;
+    append(&c.wait, c.now, cycle);
+    c.now = cycle;
+}
+
+void waitDma() { waitUntil(advance().dma_done); }
+
+void waitMatmul() { waitUntil(advance().matmul_done); }
+
+void syncUntil(uint64_t cycle) {
+    SpeClock &c = advance();
+    if (cycle <= c.now) return;
+    append(&c.sync, c.now, cycle);
+    c.now = cycle;
+}
+
+static uint64_t length(const std::vector<Span> &spans) {
+    uint64_t sum = 0;
+    for (const Span &s : spans) sum += s.end - s.begin;
+    return sum;
+}
+
+static std::vector<Span> unite(const std::vector<Span> &a, const std::vector<Span> &b) {
+    std::vector<Span> all(a);
+    all.insert(all.end(), b.begin(), b.end());
+    std::sort(all.begin(), all.end(),
+              [](const Span &x, const Span &y) { return x.begin < y.begin; });
+    std::vector<Span> merged;
+    for (const Span &s : all) append(&merged, s.begin, s.end);
+    return merged;
+}
+
+// Both sorted and disjoint
+static uint64_t intersect(const std::vector<Span> &a, const std::vector<Span> &b) {
+    uint64_t sum = 0;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        uint64_t begin = std::max(a[i].begin, b[j].begin);
+        uint64_t end = std::min(a[i].end, b[j].end);
+        if (end > begin) sum += end - begin;
+        if (a[i].end < b[j].end) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return sum;
+}
+
+void finishLaunch(const char *name, const std::vector<SpeClock *> &clocks) {
+    LaunchTiming t = {name, (int)clocks.size(), 0, 0, 0, 0, 0, 0, 0, 0};
+    for (const SpeClock *c : clocks) {
+        t.cycles = std::max(t.cycles, c->now);
+        t.compute += length(c->compute);
+        t.matmul += length(c->matmul);
+        t.dma += length(c->dma);
+        t.overlap += intersect(c->dma, unite(c->compute, c->matmul));
+        t.sync_idle += length(c->sync);
+        t.wait_idle += length(c->wait);
+    }
+    if (!clocks.empty()) {
+        uint64_t n = clocks.size();
+        t.compute /= n;
+        t.matmul /= n;
+        t.dma /= n;
+        t.overlap /= n;
+        t.sync_idle /= n;
+        t.wait_idle /= n;
+    }
+    t.ns = (uint64_t)(t.cycles / costModel().clock_ghz);
+    last_timing = t;
+    device_ns += t.ns;
+
+    Timeline &timeline = Timeline::instance();
+    if (timeline.enabled()) {
+        std::vector<SpeClock> kept;
+        kept.reserve(clocks.size());
+        for (SpeClock *c : clocks) kept.push_back(std::move(*c));
+        timeline.record(t, std::move(kept));
+    }
+}
+
+}  // namespace emu
+}  // namespace ual
+}  // namespace tecoal
+
+uint64_t sdaaEmuDeviceNs() { return tecoal::ual::emu::device_ns; }
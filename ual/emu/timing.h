@@ -0,0 +1,121 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_EMU_TIMING_H_
+#define UAL_EMU_TIMING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "ual/com/spe_cost.h"
+
+namespace tecoal {
+namespace ual {
+namespace emu {
+
+// The SPE figures of ual/com/spe_cost.h. TECOAL_EMU_COST="dma_latency=800,global_bytes=128"
+// overrides any of those the emulator uses, by field name.
+typedef common::SpeCost CostModel;
+
+CostModel &costModel();
+
+// Where a transfer goes: global memory at the bandwidth share of one SPE, global memory
+// fetched once for a broadcast group, or SPM to SPM.
+enum Link { LINK_GLOBAL, LINK_BROADCAST, LINK_SPM };
+
+struct Span {
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Virtual clock of one SPE. now is its instruction stream; the DMA engine and the matrix
+// unit run ahead of it and are only waited for where the kernel waits.
+struct SpeClock {
+    int spe_num = 0;
+    uint64_t now = 0;
+    uint64_t dma_free = 0;  // the engine takes the next transfer
+    uint64_t dma_done = 0;  // the last issued transfer has landed
+    uint64_t matmul_free = 0;
+    uint64_t matmul_done = 0;
+    // busy spans per unit and the spans now spent blocked, in issue order
+    std::vector<Span> compute;
+    std::vector<Span> matmul;
+    std::vector<Span> dma;
+    std::vector<Span> sync;  // at sync_threads
+    std::vector<Span> wait;  // on DMA, matmul, broadcast and RMA completion
+};
+
+// Prediction for one launch. Busy and idle times are averages over the SPEs, overlap is the
+// DMA time hidden under SIMD or matmul work.
+struct LaunchTiming {
+    const char *name;
+    int spe_num;
+    uint64_t cycles;  // the slowest SPE
+    uint64_t ns;
+    uint64_t compute;
+    uint64_t matmul;
+    uint64_t dma;
+    uint64_t overlap;
+    uint64_t sync_idle;
+    uint64_t wait_idle;
+};
+
+// The last launch run by the calling host thread.
+const LaunchTiming &lastTiming();
+
+// Vector ops retired by the SPE since its clock last advanced. Scalar code and loads straight
+// from global memory are not modelled, so kernels that work that way predict close to zero.
+inline uint64_t &simdOps() {
+    static thread_local uint64_t ops = 0;
+    return ops;
+}
+inline void simdOp(uint64_t n = 1) { simdOps() += n; }
+
+// Called by the SPE thread around the kernel body and by run() once all SPEs are done.
+void startClock(SpeClock *clock, int spe_num);
+void stopClock();
+void finishLaunch(const char *name, const std::vector<SpeClock *> &clocks);
+
+// Everything below acts on the calling SPE.
+uint64_t now();
+// Queues bytes, in blocks of block bytes, on the DMA engine and returns when they land.
+uint64_t dmaIssue(size_t bytes, Link link, size_t block = 0);
+// When everything queued so far has landed.
+uint64_t dmaDone();
+// Queues work on the matrix unit and returns when the unit has taken it in; its results
+// are ready matmul_latency later, which is what waitMatmul waits for.
+uint64_t matmulIssue(double cycles);
+void waitUntil(uint64_t cycle);
+void waitDma();
+void waitMatmul();
+// Like waitUntil, but booked as time spent at a barrier.
+void syncUntil(uint64_t cycle);
+
+}  // namespace emu
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_EMU_TIMING_H_
@@ -0,0 +1,76 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/activation_backward.h"
+
+#include <math.h>
+#include <algorithm>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include "ual/host/elementwise.hpp"
+#include "ual/host/thread_pool.h"
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// dx = alpha * dy * silu'(x) + beta * dx
+template <typename T>
+static void activationBackwardSilu(const ActivationBwdArgs &arg) {
+    const T *x = (const T *)arg.x;
+    const T *dy = (const T *)arg.dy;
+    T *dx = (T *)arg.dx;
+    const bool use_beta = fabsf(arg.beta) > 1e-5f;
+    parallelFor(arg.data_num, 4096, [&](int64_t begin, int64_t end) {
+        float xf[HOST_EW_BLOCK], dyf[HOST_EW_BLOCK], dxf[HOST_EW_BLOCK];
+        for (int64_t i = begin; i < end; i += HOST_EW_BLOCK) {
+            const int64_t n = std::min<int64_t>(HOST_EW_BLOCK, end - i);
+            widen(x + i, xf, n);
+            widen(dy + i, dyf, n);
+            if (use_beta) widen(dx + i, dxf, n);
+            for (int64_t j = 0; j < n; j++) {
+                const float s = 1.0f / (1.0f + expf(-xf[j]));
+                float res = arg.alpha * dyf[j] * s * (1.0f + xf[j] * (1.0f - s));
+                dxf[j] = use_beta ? res + arg.beta * dxf[j] : res;
+            }
+            narrow(dxf, dx + i, n);
+        }
+    });
+}
+
+void tecoHostActivationBackwardSiluFT16(ActivationBwdArgs arg) {
+    activationBackwardSilu<half_float::half>(arg);
+}
+
+void tecoHostActivationBackwardSiluBF16(ActivationBwdArgs arg) {
+    activationBackwardSilu<bfloat16>(arg);
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
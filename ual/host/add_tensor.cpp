@@ -0,0 +1,76 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/add_tensor.h"
+
+#include <algorithm>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include "ual/host/broadcast.hpp"
+#include "ual/host/elementwise.hpp"
+#include "ual/host/thread_pool.h"
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// C = alpha * A + beta * C over the broadcast plan, C = operand 0, A = operand 1
+template <typename T>
+static void addTensor(const AddTensorArgs &arg) {
+    const T *a = (const T *)arg.A;
+    T *c = (T *)arg.C;
+    const BroadcastPlan *plan = &arg.plan;
+    const int c_step = broadcastInnerStride(plan, 0), a_step = broadcastInnerStride(plan, 1);
+    parallelFor(broadcastElemNum(plan), 4096, [&](int64_t begin, int64_t end) {
+        float cf[HOST_EW_BLOCK], af[HOST_EW_BLOCK];
+        forEachBroadcast(plan, begin, end, [&](const int64_t *offset, int64_t len) {
+            T *dst = c + offset[0];
+            const T *src = a + offset[1];
+            const float scaled = arg.alpha * (float)*src;
+            for (int64_t j = 0; j < len; j += HOST_EW_BLOCK) {
+                const int64_t n = std::min<int64_t>(HOST_EW_BLOCK, len - j);
+                widen(dst + j * c_step, c_step, cf, n);
+                if (a_step == 0) {
+                    for (int64_t i = 0; i < n; i++) cf[i] = arg.beta * cf[i] + scaled;
+                } else {
+                    widen(src + j * a_step, a_step, af, n);
+                    for (int64_t i = 0; i < n; i++) cf[i] = arg.beta * cf[i] + arg.alpha * af[i];
+                }
+                narrow(cf, dst + j * c_step, c_step, n);
+            }
+        });
+    });
+}
+
+void tecoHostAddTensorHalf(AddTensorArgs arg) { addTensor<half_float::half>(arg); }
+
+void tecoHostAddTensorBF16(AddTensorArgs arg) { addTensor<bfloat16>(arg); }
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,73 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/arg_max.h"
+
+#include <math.h>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include "ual/host/thread_pool.h"
+
+using half_float::half;
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// y[h][l] = first index along the axis holding the maximum of x[h][:][l]
+// lowest is where the scan starts, so an all -inf (or all NaN) slice reports index 0
+template <typename T>
+static void argmax(const ArgMaxArgs &arg, float lowest) {
+    const T *x = (const T *)arg.x;
+    int64_t *y = (int64_t *)arg.y;
+    const int64_t axis_num = arg.axis_num, low_num = arg.low_num;
+    parallelFor((int64_t)arg.high_num * low_num, 256, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            const int64_t h = i / low_num, l = i % low_num;
+            const T *src = x + h * axis_num * low_num + l;
+            float max = lowest;
+            int64_t index = 0;
+            for (int64_t a = 0; a < axis_num; a++) {
+                const float v = (float)src[a * low_num];
+                if (v > max) {
+                    max = v;
+                    index = a;
+                }
+            }
+            y[i] = index;
+        }
+    });
+}
+
+void tecoHostArgmaxFT16(ArgMaxArgs arg) { argmax<half>(arg, -65504.0f); }
+
+// bf16 shares the float exponent range, so its lowest finite value would not bound it
+void tecoHostArgmaxBF16(ArgMaxArgs arg) { argmax<bfloat16>(arg, -INFINITY); }
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,90 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_HOST_BROADCAST_HPP_
+#define UAL_HOST_BROADCAST_HPP_
+
+#include <stdint.h>
+#include "ual/com/broadcast.h"
+
+using tecoal::ual::common::BroadcastPlan;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+static inline int64_t broadcastElemNum(const BroadcastPlan *plan) {
+    int64_t num = 1;
+    for (int i = 0; i < plan->nb_dims; i++) num *= plan->dims[i];
+    return num;
+}
+
+// Element step of an operand along the innermost dim, 0 where it is broadcast.
+static inline int broadcastInnerStride(const BroadcastPlan *plan, int operand) {
+    return plan->strides[operand][plan->nb_dims - 1];
+}
+
+// Calls func(offset, len) for the runs covering the logical elements [begin, end) of a plan,
+// as BroadcastRunIter does on the device: a run is len elements along the innermost dim, operand
+// k starting at element offset[k] and stepping by broadcastInnerStride(plan, k). A body loads an
+// operand of stride 0 once per run.
+template <typename Func>
+static inline void forEachBroadcast(const BroadcastPlan *plan, int64_t begin, int64_t end,
+                                    Func func) {
+    const int nb_dims = plan->nb_dims;
+    const int operand_num = plan->operand_num;
+    int coord[UAL_BROADCAST_DIM_MAX];
+    int64_t offset[UAL_BROADCAST_OPERAND_MAX] = {0};
+    int64_t rest = begin;
+    for (int d = nb_dims - 1; d >= 0; d--) {
+        coord[d] = (int)(rest % plan->dims[d]);
+        rest /= plan->dims[d];
+        for (int k = 0; k < operand_num; k++) offset[k] += (int64_t)coord[d] * plan->strides[k][d];
+    }
+
+    for (int64_t i = begin; i < end;) {
+        int d = nb_dims - 1;
+        int64_t len = plan->dims[d] - coord[d];
+        if (len > end - i) len = end - i;
+        func((const int64_t *)offset, len);
+        i += len;
+        coord[d] += (int)len;
+        for (int k = 0; k < operand_num; k++) offset[k] += len * plan->strides[k][d];
+        while (d > 0 && coord[d] == plan->dims[d]) {
+            for (int k = 0; k < operand_num; k++) {
+                offset[k] += plan->strides[k][d - 1] - (int64_t)plan->dims[d] * plan->strides[k][d];
+            }
+            coord[d] = 0;
+            coord[--d]++;
+        }
+    }
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_HOST_BROADCAST_HPP_
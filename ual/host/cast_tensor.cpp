@@ -0,0 +1,71 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/cast_tensor.h"
+
+#include <algorithm>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include "ual/host/thread_pool.h"
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// every chunk hands whole row pieces to the vectorized bulk convert
+template <typename X, typename Y>
+static void castTensor(const CastTensorArgs &arg) {
+    const X *x = (const X *)arg.x;
+    Y *y = (Y *)arg.y;
+    const int64_t data_num = arg.data_num;
+    parallelFor((int64_t)arg.row_num * data_num, 16384, [&](int64_t begin, int64_t end) {
+        while (begin < end) {
+            const int64_t row = begin / data_num, col = begin % data_num;
+            const int64_t len = std::min(data_num - col, end - begin);
+            common::convert(x + row * arg.x_row_stride + col, y + row * arg.y_row_stride + col,
+                            (size_t)len);
+            begin += len;
+        }
+    });
+}
+
+void tecoHostCastTensorFT32ToBF16(CastTensorArgs arg) { castTensor<float, bfloat16>(arg); }
+
+void tecoHostCastTensorBF16ToFT32(CastTensorArgs arg) { castTensor<bfloat16, float>(arg); }
+
+void tecoHostCastTensorFT16ToBF16(CastTensorArgs arg) {
+    castTensor<half_float::half, bfloat16>(arg);
+}
+
+void tecoHostCastTensorBF16ToFT16(CastTensorArgs arg) {
+    castTensor<bfloat16, half_float::half>(arg);
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
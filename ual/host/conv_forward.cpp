@@ -0,0 +1,77 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/conv_forward.h"
+
+#include <algorithm>
+#include <vector>
+#include "ual/com/half.hpp"
+#include "ual/host/thread_pool.h"
+
+using half_float::half;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// x NHWC, w CRSM, y NEFM, accumulated in float
+void tecoHostConvFwdFT16(ConvFwdArgs arg) {
+    const half *x = (const half *)arg.x;
+    // w rows and y pixels go through the bulk conversions, which take half_float's type whatever
+    // half names under the device compiler
+    const half_float::half *w = (const half_float::half *)arg.w;
+    half_float::half *y = (half_float::half *)arg.y;
+    const int C = arg.C, H = arg.H, W = arg.W, M = arg.M, R = arg.R, S = arg.S;
+    const int E = arg.E, F = arg.F;
+    parallelFor((int64_t)arg.N * E * F, 16, [&](int64_t begin, int64_t end) {
+        std::vector<float> acc(M), wrow(M);
+        for (int64_t p = begin; p < end; p++) {
+            const int n = (int)(p / ((int64_t)E * F));
+            const int e = (int)(p / F % E), f = (int)(p % F);
+            std::fill(acc.begin(), acc.end(), 0.0f);
+            for (int r = 0; r < R; r++) {
+                const int h = e * arg.stride_h - arg.pad_h + r * arg.dilation_h;
+                if (h < 0 || h >= H) continue;
+                for (int s = 0; s < S; s++) {
+                    const int wi = f * arg.stride_w - arg.pad_w + s * arg.dilation_w;
+                    if (wi < 0 || wi >= W) continue;
+                    const half *xp = x + (((int64_t)n * H + h) * W + wi) * C;
+                    for (int c = 0; c < C; c++) {
+                        const float xv = (float)xp[c];
+                        half_float::convert(w + (((int64_t)c * R + r) * S + s) * M, wrow.data(),
+                                            M);
+                        for (int m = 0; m < M; m++) acc[m] += xv * wrow[m];
+                    }
+                }
+            }
+            half_float::convert(acc.data(), y + p * M, M);
+        }
+    });
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
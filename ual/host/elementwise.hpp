@@ -0,0 +1,88 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_HOST_ELEMENTWISE_HPP_
+#define UAL_HOST_ELEMENTWISE_HPP_
+
+#include <stdint.h>
+#include <string.h>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// Elements an elementwise kernel widens to float at a time, 2 KB of stack per operand
+#define HOST_EW_BLOCK 512
+
+// Widening of len elements to float: F16C/AVX-512 for half and shifts for bfloat16 via the bulk
+// conversions, a plain copy for float. The kernels name half_float's half, whatever half names
+// under the device compiler.
+static inline void widen(const half_float::half *src, float *dst, int64_t len) {
+    half_float::convert(src, dst, (size_t)len);
+}
+static inline void widen(const common::bfloat16 *src, float *dst, int64_t len) {
+    common::convert(src, dst, (size_t)len);
+}
+static inline void widen(const float *src, float *dst, int64_t len) {
+    memcpy(dst, src, len * sizeof(float));
+}
+
+static inline void narrow(const float *src, half_float::half *dst, int64_t len) {
+    half_float::convert(src, dst, (size_t)len);
+}
+static inline void narrow(const float *src, common::bfloat16 *dst, int64_t len) {
+    common::convert(src, dst, (size_t)len);
+}
+static inline void narrow(const float *src, float *dst, int64_t len) {
+    memcpy(dst, src, len * sizeof(float));
+}
+
+// The same over elements step apart, as along a broadcast run; only step 1 converts in bulk
+template <typename T>
+static inline void widen(const T *src, int64_t step, float *dst, int64_t len) {
+    if (step == 1) {
+        widen(src, dst, len);
+        return;
+    }
+    for (int64_t j = 0; j < len; j++) dst[j] = (float)src[j * step];
+}
+
+template <typename T>
+static inline void narrow(const float *src, T *dst, int64_t step, int64_t len) {
+    if (step == 1) {
+        narrow(src, dst, len);
+        return;
+    }
+    for (int64_t j = 0; j < len; j++) dst[j * step] = T(src[j]);
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_HOST_ELEMENTWISE_HPP_
@@ -0,0 +1,643 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/gemm.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "ual/com/bfloat16.h"
+#include "ual/com/half.hpp"
+#include "ual/host/elementwise.hpp"
+#include "ual/host/thread_pool.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HOST_GEMM_X86 1
+#include <immintrin.h>
+#else
+#define HOST_GEMM_X86 0
+#endif
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// Blocked GEMM in the usual packed form, looping over nc columns of C, then kc of k, then mc
+// rows. Per (jc, pc) the kc x nc block of op(B) is packed once into nr-column micro-panels and
+// shared by all mc blocks; each mc block packs its mc x kc of op(A) into mr-row micro-panels,
+// both widened to float. The microkernel computes an mr x nr block of C from one A and one B
+// micro-panel: the B micro-panel (kc x nr) stays in L1 while the A panel sweeps past it from
+// L2. A float C is accumulated in place, with beta applied on the first kc slice; a half or
+// bfloat16 C is summed in a float buffer of at most GEMM_ACC_BYTES and narrowed after the last.
+#define GEMM_KC 256
+#define GEMM_ACC_BYTES (4 << 20)
+#define GEMM_MR_MAX 14
+#define GEMM_NR_MAX 32
+#define GEMM_ALIGN 64  // packed panels start on a cache line, so no vector load splits one
+
+// c[mr x nr] (row stride ldc) = alpha * a (kc x mr, column by column) * b (kc x nr, row by row)
+// + beta * c; c is not read when beta is 0
+typedef void (*GemmMicroKernel)(int kc, const float *a, const float *b, float *c, int ldc,
+                                float alpha, float beta);
+// c[nr] += a * b for one row of the block, for the partial panel at the bottom of C; a steps
+// by mr
+typedef void (*GemmRowKernel)(int kc, const float *a, const float *b, float *c);
+
+struct GemmKernelInfo {
+    GemmMicroKernel run;
+    GemmRowKernel row;
+    int mr;
+    int nr;
+    int mc;
+    int nc;
+    bool avx512;  // packPanels may use AVX-512
+};
+
+template <int MR, int NR>
+static void microKernelGeneric(int kc, const float *a, const float *b, float *c, int ldc,
+                               float alpha, float beta) {
+    float acc[MR][NR] = {};
+    for (int p = 0; p < kc; p++) {
+        for (int i = 0; i < MR; i++) {
+            const float av = a[i];
+            for (int j = 0; j < NR; j++) acc[i][j] += av * b[j];
+        }
+        a += MR;
+        b += NR;
+    }
+    for (int i = 0; i < MR; i++) {
+        float *ci = c + i * ldc;
+        for (int j = 0; j < NR; j++) {
+            ci[j] = beta == 0.0f ? alpha * acc[i][j] : alpha * acc[i][j] + beta * ci[j];
+        }
+    }
+}
+
+template <int MR, int NR>
+static void rowKernelGeneric(int kc, const float *a, const float *b, float *c) {
+    for (int p = 0; p < kc; p++) {
+        const float av = a[(int64_t)p * MR];
+        for (int j = 0; j < NR; j++) c[j] += av * b[j];
+        b += NR;
+    }
+}
+
+#if HOST_GEMM_X86
+// The rows are spelled out so the accumulators stay in registers at any optimization level.
+// The C block is prefetched first; it is mostly out of cache and the k loop hides the fetch.
+// GCC leaves out vzeroupper below -O2, so the kernels clear the upper state themselves before
+// returning to SSE code.
+#define GEMM_ROWS6(X) X(0) X(1) X(2) X(3) X(4) X(5)
+#define GEMM_ROWS14(X) GEMM_ROWS6(X) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13)
+
+// 14 x 32: 28 accumulators, two B vectors and the A broadcast fill 31 of the 32 zmm registers
+__attribute__((target("avx512f"))) static void microKernelAvx512(int kc, const float *a,
+                                                                 const float *b, float *c,
+                                                                 int ldc, float alpha,
+                                                                 float beta) {
+#define GEMM_ZERO(i)                                                      \
+    __m512 c##i##_0 = _mm512_setzero_ps(), c##i##_1 = _mm512_setzero_ps(); \
+    _mm_prefetch((const char *)(c + (i) * ldc), _MM_HINT_T1);               \
+    _mm_prefetch((const char *)(c + (i) * ldc + 16), _MM_HINT_T1);
+#define GEMM_FMA(i)                                         \
+    {                                                       \
+        const __m512 av = _mm512_set1_ps(a[i]);             \
+        c##i##_0 = _mm512_fmadd_ps(av, b0, c##i##_0);       \
+        c##i##_1 = _mm512_fmadd_ps(av, b1, c##i##_1);       \
+    }
+#define GEMM_STORE(i)                                                     \
+    _mm512_storeu_ps(c + (i) * ldc, _mm512_mul_ps(va, c##i##_0));         \
+    _mm512_storeu_ps(c + (i) * ldc + 16, _mm512_mul_ps(va, c##i##_1));
+#define GEMM_UPDATE(i)                                                                 \
+    _mm512_storeu_ps(c + (i) * ldc,                                                    \
+                     _mm512_fmadd_ps(va, c##i##_0,                                     \
+                                     _mm512_mul_ps(vb, _mm512_loadu_ps(c + (i) * ldc)))); \
+    _mm512_storeu_ps(                                                                  \
+        c + (i) * ldc + 16,                                                            \
+        _mm512_fmadd_ps(va, c##i##_1, _mm512_mul_ps(vb, _mm512_loadu_ps(c + (i) * ldc + 16))));
+    GEMM_ROWS14(GEMM_ZERO)
+    for (int p = 0; p < kc; p++) {
+        const __m512 b0 = _mm512_loadu_ps(b), b1 = _mm512_loadu_ps(b + 16);
+        GEMM_ROWS14(GEMM_FMA)
+        a += 14;
+        b += 32;
+    }
+    const __m512 va = _mm512_set1_ps(alpha), vb = _mm512_set1_ps(beta);
+    if (beta == 0.0f) {
+        GEMM_ROWS14(GEMM_STORE)
+    } else {
+        GEMM_ROWS14(GEMM_UPDATE)
+    }
+    _mm256_zeroupper();
+#undef GEMM_ZERO
+#undef GEMM_FMA
+#undef GEMM_STORE
+#undef GEMM_UPDATE
+}
+
+__attribute__((target("avx512f"))) static void rowKernelAvx512(int kc, const float *a,
+                                                               const float *b, float *c) {
+    __m512 c0 = _mm512_loadu_ps(c), c1 = _mm512_loadu_ps(c + 16);
+    for (int p = 0; p < kc; p++) {
+        const __m512 av = _mm512_set1_ps(a[(int64_t)p * 14]);
+        c0 = _mm512_fmadd_ps(av, _mm512_loadu_ps(b), c0);
+        c1 = _mm512_fmadd_ps(av, _mm512_loadu_ps(b + 16), c1);
+        b += 32;
+    }
+    _mm512_storeu_ps(c, c0);
+    _mm512_storeu_ps(c + 16, c1);
+    _mm256_zeroupper();
+}
+
+// 6 x 16: 12 accumulators, two B vectors and the A broadcast fill 15 of the 16 ymm registers
+__attribute__((target("avx2,fma"))) static void microKernelAvx2(int kc, const float *a,
+                                                               const float *b, float *c,
+                                                               int ldc, float alpha,
+                                                               float beta) {
+#define GEMM_ZERO(i)                                                      \
+    __m256 c##i##_0 = _mm256_setzero_ps(), c##i##_1 = _mm256_setzero_ps(); \
+    _mm_prefetch((const char *)(c + (i) * ldc), _MM_HINT_T1);               \
+    _mm_prefetch((const char *)(c + (i) * ldc + 15), _MM_HINT_T1);
+#define GEMM_FMA(i)                                         \
+    {                                                       \
+        const __m256 av = _mm256_broadcast_ss(a + (i));     \
+        c##i##_0 = _mm256_fmadd_ps(av, b0, c##i##_0);       \
+        c##i##_1 = _mm256_fmadd_ps(av, b1, c##i##_1);       \
+    }
+#define GEMM_STORE(i)                                                     \
+    _mm256_storeu_ps(c + (i) * ldc, _mm256_mul_ps(va, c##i##_0));         \
+    _mm256_storeu_ps(c + (i) * ldc + 8, _mm256_mul_ps(va, c##i##_1));
+#define GEMM_UPDATE(i)                                                                 \
+    _mm256_storeu_ps(c + (i) * ldc,                                                    \
+                     _mm256_fmadd_ps(va, c##i##_0,                                     \
+                                     _mm256_mul_ps(vb, _mm256_loadu_ps(c + (i) * ldc)))); \
+    _mm256_storeu_ps(                                                                  \
+        c + (i) * ldc + 8,                                                             \
+        _mm256_fmadd_ps(va, c##i##_1, _mm256_mul_ps(vb, _mm256_loadu_ps(c + (i) * ldc + 8))));
+    GEMM_ROWS6(GEMM_ZERO)
+    for (int p = 0; p < kc; p++) {
+        const __m256 b0 = _mm256_loadu_ps(b), b1 = _mm256_loadu_ps(b + 8);
+        GEMM_ROWS6(GEMM_FMA)
+        a += 6;
+        b += 16;
+    }
+    const __m256 va = _mm256_set1_ps(alpha), vb = _mm256_set1_ps(beta);
+    if (beta == 0.0f) {
+        GEMM_ROWS6(GEMM_STORE)
+    } else {
+        GEMM_ROWS6(GEMM_UPDATE)
+    }
+    _mm256_zeroupper();
+#undef GEMM_ZERO
+#undef GEMM_FMA
+#undef GEMM_STORE
+#undef GEMM_UPDATE
+}
+
+__attribute__((target("avx2,fma"))) static void rowKernelAvx2(int kc, const float *a,
+                                                              const float *b, float *c) {
+    __m256 c0 = _mm256_loadu_ps(c), c1 = _mm256_loadu_ps(c + 8);
+    for (int p = 0; p < kc; p++) {
+        const __m256 av = _mm256_broadcast_ss(a + (int64_t)p * 6);
+        c0 = _mm256_fmadd_ps(av, _mm256_loadu_ps(b), c0);
+        c1 = _mm256_fmadd_ps(av, _mm256_loadu_ps(b + 8), c1);
+        b += 16;
+    }
+    _mm256_storeu_ps(c, c0);
+    _mm256_storeu_ps(c + 8, c1);
+    _mm256_zeroupper();
+}
+
+// 16 elements from src widened to float
+__attribute__((target("avx512f"))) static inline __m512 load16(const half_float::half *src) {
+    return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)));
+}
+__attribute__((target("avx512f"))) static inline __m512 load16(const bfloat16 *src) {
+    const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(bits), 16));
+}
+__attribute__((target("avx512f"))) static inline __m512 load16(const float *src) {
+    return _mm512_loadu_ps(src);
+}
+
+__attribute__((target("avx512f"))) static inline void transpose16(__m512 *v) {
+    __m512 t[16];
+    for (int i = 0; i < 16; i += 2) {
+        t[i] = _mm512_unpacklo_ps(v[i], v[i + 1]);
+        t[i + 1] = _mm512_unpackhi_ps(v[i], v[i + 1]);
+    }
+    for (int i = 0; i < 16; i += 4) {
+        for (int j = 0; j < 2; j++) {
+            const __m512d lo = _mm512_castps_pd(t[i + j]), hi = _mm512_castps_pd(t[i + j + 2]);
+            v[i + 2 * j] = _mm512_castpd_ps(_mm512_unpacklo_pd(lo, hi));
+            v[i + 2 * j + 1] = _mm512_castpd_ps(_mm512_unpackhi_pd(lo, hi));
+        }
+    }
+    for (int i = 0; i < 16; i += 8) {
+        for (int j = 0; j < 4; j++) {
+            t[i + j] = _mm512_shuffle_f32x4(v[i + j], v[i + j + 4], 0x88);
+            t[i + j + 4] = _mm512_shuffle_f32x4(v[i + j], v[i + j + 4], 0xdd);
+        }
+    }
+    for (int j = 0; j < 8; j++) {
+        v[j] = _mm512_shuffle_f32x4(t[j], t[j + 8], 0x88);
+        v[j + 8] = _mm512_shuffle_f32x4(t[j], t[j + 8], 0xdd);
+    }
+}
+
+// packPanels with AVX-512: by rows, a panel is read 16 rows by 16 elements at a time and
+// transposed in registers; otherwise each row of src is widened straight into the panels
+template <typename T>
+__attribute__((target("avx512f"))) static void packPanelsAvx512(const T *src, int64_t ld,
+                                                                bool by_rows, int len, int kc,
+                                                                int w, float *dst) {
+    const int panels = (len + w - 1) / w;
+    if (!by_rows) {
+        // source rows are read front to back so the hardware prefetcher can follow them
+        for (int p = 0; p < kc; p++) {
+            const T *in = src + p * ld;
+            float *out = dst + p * w;
+            for (int j = 0; j < panels * w; j += w, in += w, out += (int64_t)w * kc) {
+                for (int g = 0; g < w; g += 16) {
+                    const int lanes = std::min(16, w - g);
+                    if (j + g + 16 <= len) {
+                        _mm512_mask_storeu_ps(out + g, (__mmask16)((1u << lanes) - 1),
+                                              load16(in + g));
+                        continue;
+                    }
+                    for (int i = 0; i < lanes; i++) {
+                        out[g + i] = j + g + i < len ? static_cast<float>(in[g + i]) : 0.0f;
+                    }
+                }
+            }
+        }
+        _mm256_zeroupper();
+        return;
+    }
+    for (int ip = 0; ip < panels; ip++) {
+        float *panel = dst + (int64_t)ip * w * kc;
+        for (int g = 0; g < w; g += 16) {
+            const int lanes = std::min(16, w - g);
+            const int valid = std::max(0, std::min(lanes, len - ip * w - g));
+            float *out = panel + g;
+            const T *in = src + (int64_t)(ip * w + g) * ld;
+            const __mmask16 mask = (__mmask16)((1u << lanes) - 1);
+            int p = 0;
+            for (; p + 16 <= kc; p += 16) {
+                __m512 v[16];
+                for (int r = 0; r < 16; r++) {
+                    v[r] = r < valid ? load16(in + r * ld + p) : _mm512_setzero_ps();
+                }
+                transpose16(v);
+                for (int j = 0; j < 16; j++) _mm512_mask_storeu_ps(out + (p + j) * w, mask, v[j]);
+            }
+            for (; p < kc; p++) {
+                for (int r = 0; r < lanes; r++) {
+                    out[p * w + r] = r < valid ? static_cast<float>(in[r * ld + p]) : 0.0f;
+                }
+            }
+        }
+    }
+    _mm256_zeroupper();
+}
+#endif
+
+// mc x kc of A takes about a tenth of L2, kc x nc of B about half of it
+static const GemmKernelInfo &gemmKernel() {
+    static const GemmKernelInfo info = []() -> GemmKernelInfo {
+#if HOST_GEMM_X86
+        if (__builtin_cpu_supports("avx512f")) {
+            return {microKernelAvx512, rowKernelAvx512, 14, 32, 14 * 16, 32 * 32, true};
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return {microKernelAvx2, rowKernelAvx2, 6, 16, 6 * 32, 16 * 64, false};
+        }
+#endif
+        return {microKernelGeneric<4, 16>, rowKernelGeneric<4, 16>, 4, 16, 4 * 32, 16 * 16,
+                false};
+    }();
+    return info;
+}
+
+// Grows and never shrinks, so a thread sizes it once for the largest GEMM it meets
+class GemmBuffer {
+ public:
+    float *reserve(size_t len) {
+        const size_t pad = GEMM_ALIGN / sizeof(float);
+        if (data_.size() < len + pad) data_.resize(len + pad);
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(data_.data());
+        return data_.data() + (GEMM_ALIGN - addr % GEMM_ALIGN) % GEMM_ALIGN / sizeof(float);
+    }
+
+ private:
+    std::vector<float> data_;
+};
+
+// b and acc belong to the thread walking jc and pc, a and row to every thread running mc
+// blocks; the walking thread runs blocks too, which is why they are separate
+struct GemmScratch {
+    GemmBuffer a;
+    GemmBuffer b;
+    GemmBuffer acc;
+    GemmBuffer row;
+};
+
+static GemmScratch &gemmScratch() {
+    static thread_local GemmScratch scratch;
+    return scratch;
+}
+
+// widening scratch of packPanels
+static size_t packRowLen(const GemmKernelInfo &kernel) {
+    return std::max<size_t>(GEMM_NR_MAX * GEMM_KC, std::max(kernel.mc, kernel.nc) + GEMM_NR_MAX);
+}
+
+// len x kc of op(A) or the transpose of op(B) into w-wide micro-panels stored p by p, zero
+// padded to whole panels. Element (i, p) is src[i * ld + p] when by_rows, else src[p * ld + i],
+// so a transposed operand is packed from its rows as well and costs no extra pass. row is
+// scratch of packRowLen floats.
+template <typename T>
+static void packPanels(const GemmKernelInfo &kernel, const T *src, int64_t ld, bool by_rows,
+                       int len, int kc, int w, float *dst, float *row) {
+#if HOST_GEMM_X86
+    if (kernel.avx512) {
+        packPanelsAvx512(src, ld, by_rows, len, kc, w, dst);
+        return;
+    }
+#endif
+    const int panels = (len + w - 1) / w;
+    if (by_rows) {
+        // a panel's w rows are widened side by side, then interleaved p by p
+        for (int ip = 0; ip < panels; ip++) {
+            const int rows = std::min(w, len - ip * w);
+            for (int r = 0; r < rows; r++) widen(src + (ip * w + r) * ld, row + r * kc, kc);
+            float *out = dst + (int64_t)ip * w * kc;
+            for (int p = 0; p < kc; p++, out += w) {
+                for (int r = 0; r < rows; r++) out[r] = row[r * kc + p];
+                for (int r = rows; r < w; r++) out[r] = 0.0f;
+            }
+        }
+        return;
+    }
+    for (int i = len; i < panels * w; i++) row[i] = 0.0f;
+    for (int p = 0; p < kc; p++) {
+        widen(src + p * ld, row, len);
+        for (int ip = 0; ip < panels; ip++) {
+            memcpy(dst + ((int64_t)ip * kc + p) * w, row + ip * w, w * sizeof(float));
+        }
+    }
+}
+
+// c (row stride ldc) = alpha * a * b + beta * c for rows x cols of C, over the packed panels
+// [jr0, jr1) of b; blocks cut by the edge of C go through an mr x nr buffer
+static void macroKernel(const GemmKernelInfo &kernel, int kc, int rows, int cols, int jr0,
+                        int jr1, const float *pa, const float *pb, float *c, int ldc,
+                        float alpha, float beta) {
+    alignas(GEMM_ALIGN) float edge[GEMM_MR_MAX * GEMM_NR_MAX];
+    for (int jr = jr0; jr < jr1; jr++) {
+        const float *b = pb + (int64_t)jr * kernel.nr * kc;
+        const int w = std::min(kernel.nr, cols - jr * kernel.nr);
+        for (int ir = 0; ir * kernel.mr < rows; ir++) {
+            const float *a = pa + (int64_t)ir * kernel.mr * kc;
+            float *block = c + (int64_t)ir * kernel.mr * ldc + jr * kernel.nr;
+            const int h = std::min(kernel.mr, rows - ir * kernel.mr);
+            if (h == kernel.mr && w == kernel.nr) {
+                kernel.run(kc, a, b, block, ldc, alpha, beta);
+                continue;
+            }
+            if (h == kernel.mr) {
+                kernel.run(kc, a, b, edge, kernel.nr, 1.0f, 0.0f);
+            } else {
+                // skinny m (decode) would otherwise pay for a whole padded panel
+                memset(edge, 0, h * kernel.nr * sizeof(float));
+                for (int r = 0; r < h; r++) kernel.row(kc, a + r, b, edge + r * kernel.nr);
+            }
+            for (int r = 0; r < h; r++) {
+                float *dst = block + (int64_t)r * ldc;
+                const float *src = edge + r * kernel.nr;
+                for (int j = 0; j < w; j++) {
+                    dst[j] = beta == 0.0f ? alpha * src[j] : alpha * src[j] + beta * dst[j];
+                }
+            }
+        }
+    }
+}
+
+// C itself when it is float, so it is accumulated in place
+static float *floatC(float *C) { return C; }
+template <typename TYPE_C>
+static float *floatC(TYPE_C *) {
+    return nullptr;
+}
+
+static void gemmFor(bool parallel, int64_t n, const RangeFunc &func) {
+    if (parallel) {
+        parallelFor(n, 1, func);
+    } else {
+        func(0, n);
+    }
+}
+
+// C = alpha * op(A) * op(B) + beta * C for one matrix, on the calling thread alone or, when
+// parallel, with B packed over the pool and the mc blocks spread over it. Few mc blocks (skinny
+// m) are split along n as well, each part packing the block's A again.
+template <typename TYPE_AB, typename TYPE_C>
+static void gemmMatrix(const GEMMArgs &arg, const TYPE_AB *A, const TYPE_AB *B, TYPE_C *C,
+                       bool parallel) {
+    if (arg.m <= 0 || arg.n <= 0) return;
+    const GemmKernelInfo &kernel = gemmKernel();
+    const bool use_beta = arg.beta != 0.0f;
+    if (arg.k <= 0) {
+        gemmFor(parallel, arg.m, [&](int64_t begin, int64_t end) {
+            float *row = gemmScratch().row.reserve(arg.n);
+            for (int64_t i = begin; i < end; i++) {
+                TYPE_C *c = C + i * arg.ldc;
+                widen(c, row, arg.n);
+                for (int j = 0; j < arg.n; j++) row[j] = use_beta ? arg.beta * row[j] : 0.0f;
+                narrow(row, c, arg.n);
+            }
+        });
+        return;
+    }
+    const bool trans_a = arg.transa != UALOperation::UAL_OP_N;
+    const bool trans_b = arg.transb != UALOperation::UAL_OP_N;
+    float *const c_float = floatC(C);
+    const int chunk =
+        c_float != nullptr
+            ? arg.m
+            : std::max(kernel.mc, GEMM_ACC_BYTES / 4 / kernel.nc / kernel.mc * kernel.mc);
+    GemmScratch &own = gemmScratch();
+    float *const packed_b = own.b.reserve((size_t)kernel.nc * GEMM_KC);
+    float *const acc =
+        c_float != nullptr ? nullptr : own.acc.reserve((size_t)std::min(chunk, arg.m) * kernel.nc);
+    const int threads = parallel ? ThreadPool::current().concurrency() : 1;
+
+    for (int jc = 0; jc < arg.n; jc += kernel.nc) {
+        const int nc = std::min(kernel.nc, arg.n - jc);
+        const int np = (nc + kernel.nr - 1) / kernel.nr;
+        for (int i0 = 0; i0 < arg.m; i0 += chunk) {
+            const int m_chunk = std::min(chunk, arg.m - i0);
+            const int mb = (m_chunk + kernel.mc - 1) / kernel.mc;
+            const int splits = std::min(np, (threads + mb - 1) / mb);
+            for (int pc = 0; pc < arg.k; pc += GEMM_KC) {
+                const int kc = std::min(GEMM_KC, arg.k - pc);
+                const bool last = pc + kc >= arg.k;
+                const TYPE_AB *src_b =
+                    trans_b ? B + (int64_t)jc * arg.ldb + pc : B + (int64_t)pc * arg.ldb + jc;
+                gemmFor(parallel, np, [&](int64_t begin, int64_t end) {
+                    const int64_t col = begin * kernel.nr;
+                    packPanels(kernel, trans_b ? src_b + col * arg.ldb : src_b + col, arg.ldb,
+                               trans_b, (int)(std::min<int64_t>(end * kernel.nr, nc) - col), kc,
+                               kernel.nr, packed_b + col * kc,
+                               gemmScratch().row.reserve(packRowLen(kernel)));
+                });
+                gemmFor(parallel, (int64_t)mb * splits, [&](int64_t begin, int64_t end) {
+                    GemmScratch &scratch = gemmScratch();
+                    float *pa = scratch.a.reserve((size_t)kernel.mc * GEMM_KC);
+                    float *row = scratch.row.reserve(packRowLen(kernel));
+                    int64_t packed = -1;
+                    for (int64_t t = begin; t < end; t++) {
+                        const int64_t ib = t / splits, part = t % splits;
+                        const int r0 = (int)ib * kernel.mc;
+                        const int rows = std::min(kernel.mc, m_chunk - r0);
+                        const int jr0 = (int)(np * part / splits);
+                        const int jr1 = (int)(np * (part + 1) / splits);
+                        if (ib != packed) {
+                            const int64_t i = i0 + r0;
+                            packPanels(kernel, trans_a ? A + (int64_t)pc * arg.lda + i
+                                               : A + i * arg.lda + pc,
+                                       arg.lda, !trans_a, rows, kc, kernel.mr, pa, row);
+                            packed = ib;
+                        }
+                        if (c_float != nullptr) {
+                            float *c = c_float + (int64_t)(i0 + r0) * arg.ldc + jc;
+                            macroKernel(kernel, kc, rows, nc, jr0, jr1, pa, packed_b, c, arg.ldc,
+                                        arg.alpha, pc == 0 ? arg.beta : 1.0f);
+                            continue;
+                        }
+                        float *c = acc + (int64_t)r0 * nc;
+                        macroKernel(kernel, kc, rows, nc, jr0, jr1, pa, packed_b, c, nc,
+                                    arg.alpha, pc == 0 ? 0.0f : 1.0f);
+                        if (!last) continue;
+                        const int col = jr0 * kernel.nr;
+                        const int width = std::min(jr1 * kernel.nr, nc) - col;
+                        for (int r = 0; r < rows; r++) {
+                            TYPE_C *dst = C + (int64_t)(i0 + r0 + r) * arg.ldc + jc + col;
+                            const float *src = c + (int64_t)r * nc + col;
+                            if (use_beta) {
+                                widen(dst, row, width);
+                                for (int j = 0; j < width; j++) row[j] = src[j] + arg.beta * row[j];
+                                src = row;
+                            }
+                            narrow(src, dst, width);
+                        }
+                    }
+                });
+            }
+        }
+    }
+}
+
+// C = alpha * op(A) * op(B) + beta * C for every batch: with at least as many batches as
+// threads each matrix runs on one thread, otherwise the matrices take the pool in turn
+template <typename TYPE_AB, typename TYPE_C>
+static void gemmBatches(const GEMMArgs &arg) {
+    const int batch = arg.batch > 0 ? arg.batch : 1;
+    auto matrix = [&](int64_t b, bool parallel) {
+        const TYPE_AB *A = arg.Aarray ? (const TYPE_AB *)arg.Aarray[b]
+                                      : (const TYPE_AB *)arg.A + b * arg.strideA;
+        const TYPE_AB *B = arg.Barray ? (const TYPE_AB *)arg.Barray[b]
+                                      : (const TYPE_AB *)arg.B + b * arg.strideB;
+        TYPE_C *C = arg.Carray ? (TYPE_C *)arg.Carray[b] : (TYPE_C *)arg.C + b * arg.strideC;
+        gemmMatrix(arg, A, B, C, parallel);
+    };
+    if (batch >= ThreadPool::current().concurrency()) {
+        parallelFor(batch, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t b = begin; b < end; b++) matrix(b, false);
+        });
+        return;
+    }
+    for (int b = 0; b < batch; b++) matrix(b, true);
+}
+
+// C is TYPE_AB or float as given by Ctype
+template <typename TYPE_AB>
+static void gemmDispatchC(const GEMMArgs &arg) {
+    if (arg.Ctype == UALDataType::UAL_DTYPE_FLOAT) {
+        gemmBatches<TYPE_AB, float>(arg);
+    } else {
+        gemmBatches<TYPE_AB, TYPE_AB>(arg);
+    }
+}
+
+// the groups are spread over the pool as the batches of gemmBatches are
+template <typename TYPE_AB, typename TYPE_C>
+static void gemmGroups(const GEMMGroupedArgs &arg) {
+    auto group = [&](int64_t g, bool parallel) {
+        const GEMMGroupShape &shape = arg.shapes[g];
+        GEMMArgs args;
+        memset(&args, 0, sizeof(args));
+        args.m = shape.m;
+        args.n = shape.n;
+        args.k = shape.k;
+        args.lda = shape.lda;
+        args.ldb = shape.ldb;
+        args.ldc = shape.ldc;
+        args.alpha = arg.alpha;
+        args.beta = arg.beta;
+        args.transa = arg.transa;
+        args.transb = arg.transb;
+        args.Ctype = arg.Ctype;
+        gemmMatrix(args, (const TYPE_AB *)arg.A[g], (const TYPE_AB *)arg.B[g], (TYPE_C *)arg.C[g],
+                   parallel);
+    };
+    if (arg.group_count >= ThreadPool::current().concurrency()) {
+        parallelFor(arg.group_count, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t g = begin; g < end; g++) group(g, false);
+        });
+        return;
+    }
+    for (int g = 0; g < arg.group_count; g++) group(g, true);
+}
+
+void tecoHostGemmFT16(GEMMArgs arg) { gemmDispatchC<half_float::half>(arg); }
+
+void tecoHostGemmBF16(GEMMArgs arg) { gemmDispatchC<bfloat16>(arg); }
+
+void tecoHostGemmFT32(GEMMArgs arg) { gemmBatches<float, float>(arg); }
+
+void tecoHostGemmGroupedFT16(GEMMGroupedArgs arg) {
+    if (arg.Ctype == UALDataType::UAL_DTYPE_FLOAT) {
+        gemmGroups<half_float::half, float>(arg);
+    } else {
+        gemmGroups<half_float::half, half_float::half>(arg);
+    }
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
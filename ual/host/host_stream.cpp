@@ -0,0 +1,85 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/host_stream.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+HostStream::HostStream() : thread_(&HostStream::loop, this) {}
+
+HostStream::~HostStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void HostStream::enqueue(StreamTask task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        enqueued_++;
+    }
+    wake_.notify_one();
+}
+
+void HostStream::synchronize() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = enqueued_;
+    done_.wait(lock, [&]() { return finished_ >= target; });
+}
+
+common::Status HostStream::takeError() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    common::Status error = error_;
+    error_ = common::Status::SUCCESS;
+    return error;
+}
+
+// the task runs outside the lock so enqueue never waits for a kernel
+void HostStream::loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;  // stopping with nothing left
+        StreamTask task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        common::Status status = task();
+        lock.lock();
+        if (error_ == common::Status::SUCCESS) error_ = status;
+        finished_++;
+        done_.notify_all();
+    }
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
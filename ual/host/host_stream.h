@@ -0,0 +1,79 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_HOST_HOST_STREAM_H_
+#define UAL_HOST_HOST_STREAM_H_
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "ual/com/def.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+typedef std::function<common::Status()> StreamTask;
+
+// In-order queue of host work. A thread of its own takes the tasks one after another, so work
+// on different streams overlaps while each stream keeps its order; the kernels a task runs
+// still spread over a ThreadPool. The destructor finishes what is queued.
+class HostStream {
+ public:
+    HostStream();
+    ~HostStream();
+
+    HostStream(const HostStream &) = delete;
+    HostStream &operator=(const HostStream &) = delete;
+
+    void enqueue(StreamTask task);
+    // returns once every task enqueued before the call has run
+    void synchronize();
+    // first failure of a task since the previous call, SUCCESS if none
+    common::Status takeError();
+
+ private:
+    void loop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;  // a task was queued or the stream stops
+    std::condition_variable done_;  // a task finished
+    std::deque<StreamTask> tasks_;
+    uint64_t enqueued_ = 0;
+    uint64_t finished_ = 0;
+    common::Status error_ = common::Status::SUCCESS;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_HOST_HOST_STREAM_H_
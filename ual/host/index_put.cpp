@@ -0,0 +1,102 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/index_put.h"
+
+#include <string.h>
+#include <algorithm>
+#include "ual/com/half.hpp"
+#include "ual/host/broadcast.hpp"
+#include "ual/host/elementwise.hpp"
+#include "ual/host/thread_pool.h"
+
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// output[indices[0][k], ..., indices[I-1][k], :] (+)= value[k, :]. Every range walks all index
+// tuples and keeps the output rows it owns, so repeated indices resolve in index order.
+void tecoHostIndexPutInt64Indices(IndexPutArgs arg) {
+    const int list_length = arg.list_length;
+    const int sz_type = arg.sz_type;
+    const int64_t **indices = (const int64_t **)arg.indices;
+    const char *value = (const char *)arg.value;
+    char *output = (char *)arg.output;
+
+    const int mid_pos = arg.dim_ln - list_length;
+    const int *dim_mid = arg.dim_output + mid_pos;
+    int64_t lo_cnt = 1, row_cnt = 1;
+    for (int i = 0; i < mid_pos; i++) lo_cnt *= arg.dim_output[i];
+    for (int i = 0; i < list_length; i++) row_cnt *= dim_mid[i];
+    const int64_t K = broadcastElemNum(&arg.index_plan);
+    int index_step[MAX_DIM];
+    for (int i = 0; i < list_length; i++) index_step[i] = broadcastInnerStride(&arg.index_plan, i);
+    const int value_step = broadcastInnerStride(&arg.value_plan, 1);
+
+    parallelFor(row_cnt, 1, [&](int64_t row_begin, int64_t row_end) {
+        int64_t pos[MAX_DIM] = {0};
+        int64_t k = 0;
+        forEachBroadcast(&arg.index_plan, 0, K, [&](const int64_t *offset, int64_t len) {
+            for (int64_t j = 0; j < len; j++, k++) {
+                for (int i = 0; i < list_length; i++) {
+                    pos[list_length - 1 - i] = indices[i][offset[i] + j * index_step[i]];
+                }
+                int64_t row = 0;
+                for (int i = list_length - 1; i >= 0; i--) row = row * dim_mid[i] + pos[i];
+                if (row < row_begin || row >= row_end) continue;
+                char *dst = output + sz_type * row * lo_cnt;
+                forEachBroadcast(&arg.value_plan, k * lo_cnt, (k + 1) * lo_cnt,
+                                 [&](const int64_t *value_offset, int64_t value_len) {
+                    const char *src = value + sz_type * value_offset[1];
+                    if (!arg.accumulate && value_step == 1) {
+                        memcpy(dst, src, sz_type * value_len);
+                    } else if (!arg.accumulate) {
+                        for (int64_t v = 0; v < value_len; v++) {
+                            memcpy(dst + sz_type * v, src + sz_type * value_step * v, sz_type);
+                        }
+                    } else {
+                        half_float::half *acc = (half_float::half *)dst;
+                        const half_float::half *add = (const half_float::half *)src;
+                        float accf[HOST_EW_BLOCK], addf[HOST_EW_BLOCK];
+                        for (int64_t v = 0; v < value_len; v += HOST_EW_BLOCK) {
+                            const int64_t n = std::min<int64_t>(HOST_EW_BLOCK, value_len - v);
+                            widen(acc + v, accf, n);
+                            widen(add + v * value_step, value_step, addf, n);
+                            for (int64_t j = 0; j < n; j++) accf[j] += addf[j];
+                            narrow(accf, acc + v, n);
+                        }
+                    }
+                    dst += sz_type * value_len;
+                });
+            }
+        });
+    });
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,90 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/masked_fill.h"
+
+#include <string.h>
+#include <algorithm>
+#include "ual/com/bfloat16.h"
+#include "ual/host/broadcast.hpp"
+#include "ual/host/thread_pool.h"
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// output = mask ? value : input over the plan, output = operand 0, input = 1, mask = 2
+template <typename T>
+static void maskedFill(const MaskedFillArgs &arg) {
+    const T *input = (const T *)arg.input;
+    const uint8_t *mask = (const uint8_t *)arg.mask;
+    T *output = (T *)arg.output;
+    const T value = T(arg.value);
+    const BroadcastPlan *plan = &arg.plan;
+    const int out_step = broadcastInnerStride(plan, 0), in_step = broadcastInnerStride(plan, 1);
+    const int mask_step = broadcastInnerStride(plan, 2);
+    parallelFor(broadcastElemNum(plan), 8192, [&](int64_t begin, int64_t end) {
+        forEachBroadcast(plan, begin, end, [&](const int64_t *offset, int64_t len) {
+            T *dst = output + offset[0];
+            const T *src = input + offset[1];
+            const uint8_t *m = mask + offset[2];
+            if (mask_step == 0) {
+                // one mask byte decides the whole run
+                if (*m && out_step == 1) {
+                    std::fill(dst, dst + len, value);
+                } else if (*m) {
+                    for (int64_t j = 0; j < len; j++) dst[j * out_step] = value;
+                } else if (out_step == 1 && in_step == 1) {
+                    if (dst != src) memmove(dst, src, len * sizeof(T));
+                } else {
+                    for (int64_t j = 0; j < len; j++) dst[j * out_step] = src[j * in_step];
+                }
+                return;
+            }
+            if (out_step == 1 && in_step == 1 && mask_step == 1) {
+                // picked by index rather than branched on, a random mask mispredicts half the time
+                for (int64_t j = 0; j < len; j++) {
+                    const T pick[2] = {src[j], value};
+                    dst[j] = pick[m[j] != 0];
+                }
+                return;
+            }
+            for (int64_t j = 0; j < len; j++) {
+                dst[j * out_step] = m[j * mask_step] ? value : src[j * in_step];
+            }
+        });
+    });
+}
+
+void tecoHostMaskedFillFT32(MaskedFillArgs arg) { maskedFill<float>(arg); }
+
+void tecoHostMaskedFillBF16(MaskedFillArgs arg) { maskedFill<bfloat16>(arg); }
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
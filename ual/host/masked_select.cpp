@@ -0,0 +1,95 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/masked_select.h"
+
+#include <algorithm>
+#include <vector>
+#include "ual/host/broadcast.hpp"
+#include "ual/host/thread_pool.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+#define MASKED_SELECT_HOST_BLOCK 16384
+
+// Counts the selected elements of each block, then every block writes at its prefix sum, which
+// keeps the output in logical order. input = operand 0, mask = 1.
+void tecoHostMaskedSelectB32(MaskedSelectArgs arg) {
+    const uint32_t *input = (const uint32_t *)arg.input;
+    const uint8_t *mask = (const uint8_t *)arg.mask;
+    uint32_t *output = (uint32_t *)arg.output;
+    const BroadcastPlan *plan = &arg.plan;
+    const int in_step = broadcastInnerStride(plan, 0), mask_step = broadcastInnerStride(plan, 1);
+    const int64_t total = broadcastElemNum(plan);
+    const int64_t block_num = (total + MASKED_SELECT_HOST_BLOCK - 1) / MASKED_SELECT_HOST_BLOCK;
+
+    std::vector<int64_t> start(block_num + 1, 0);
+    parallelFor(block_num, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+            int64_t count = 0;
+            forEachBroadcast(plan, b * MASKED_SELECT_HOST_BLOCK,
+                             std::min(total, (b + 1) * MASKED_SELECT_HOST_BLOCK),
+                             [&](const int64_t *offset, int64_t len) {
+                const uint8_t *m = mask + offset[1];
+                if (mask_step == 0) {
+                    count += *m != 0 ? len : 0;
+                    return;
+                }
+                for (int64_t j = 0; j < len; j++) count += m[j * mask_step] != 0;
+            });
+            start[b + 1] = count;
+        }
+    });
+    for (int64_t b = 0; b < block_num; b++) start[b + 1] += start[b];
+
+    parallelFor(block_num, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+            uint32_t *dst = output + start[b];
+            forEachBroadcast(plan, b * MASKED_SELECT_HOST_BLOCK,
+                             std::min(total, (b + 1) * MASKED_SELECT_HOST_BLOCK),
+                             [&](const int64_t *offset, int64_t len) {
+                const uint32_t *src = input + offset[0];
+                const uint8_t *m = mask + offset[1];
+                if (mask_step == 0) {
+                    if (*m) {
+                        for (int64_t j = 0; j < len; j++) *dst++ = src[j * in_step];
+                    }
+                    return;
+                }
+                for (int64_t j = 0; j < len; j++) {
+                    if (m[j * mask_step]) *dst++ = src[j * in_step];
+                }
+            });
+        }
+    });
+    *(int64_t *)arg.selectcount = start[block_num];
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,64 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/scale_tensor.h"
+
+#include <algorithm>
+#include "ual/com/bfloat16.h"
+#include "ual/host/elementwise.hpp"
+#include "ual/host/thread_pool.h"
+
+using tecoal::ual::common::bfloat16;
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+template <typename T>
+static void scaleTensor(const ScaleTensorArgs &arg) {
+    T *y = (T *)arg.y;
+    const int64_t data_num = arg.data_num;
+    parallelFor((int64_t)arg.row_num * data_num, 8192, [&](int64_t begin, int64_t end) {
+        float yf[HOST_EW_BLOCK];
+        for (int64_t i = begin; i < end;) {
+            const int64_t col = i % data_num;
+            const int64_t n = std::min<int64_t>({HOST_EW_BLOCK, data_num - col, end - i});
+            T *yrow = y + i / data_num * arg.y_row_stride + col;
+            widen(yrow, yf, n);
+            for (int64_t j = 0; j < n; j++) yf[j] *= arg.x;
+            narrow(yf, yrow, n);
+            i += n;
+        }
+    });
+}
+
+void tecoHostScaleTensorFT32(ScaleTensorArgs arg) { scaleTensor<float>(arg); }
+
+void tecoHostScaleTensorBF16(ScaleTensorArgs arg) { scaleTensor<bfloat16>(arg); }
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
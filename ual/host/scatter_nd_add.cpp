@@ -0,0 +1,77 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/scatter_nd_add.h"
+
+#include "ual/com/half.hpp"
+#include "ual/host/thread_pool.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+static inline int calindex(const int *arrayi, const int *arrayx, int n) {
+    int res = 0;
+    for (int i = 0; i < n - 1; i++) {
+        res = (res + arrayi[i]) * arrayx[i + 1];
+    }
+    res += arrayi[n - 1];
+    return res;
+}
+
+// out = x, then out[calindex(index[i])] += updates[i] for every index row. Ranges own rows of
+// out and scan all indices, as the device kernel does per SPE.
+template <typename TYPE>
+void tecoHostScatterNdAddIndex32(ScatterNdAddArgs arg) {
+    const int dim_index0 = arg.dim_index[0];
+    const int dim_index1 = arg.dim_index[1];
+    const int64_t dim_x1 = arg.dim_x[1];
+    const TYPE *x = (const TYPE *)arg.x;
+    const int *index = (const int *)arg.index;
+    const TYPE *updates = (const TYPE *)arg.updates;
+    TYPE *out = (TYPE *)arg.out;
+
+    parallelFor(arg.dim_x[0], 1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin * dim_x1; i < end * dim_x1; i++) out[i] = x[i];
+        for (int i = 0; i < dim_index0; i++) {
+            const int64_t row = calindex(index + (int64_t)i * dim_index1, arg.dim_x8, dim_index1);
+            if (row < begin || row >= end) continue;
+            TYPE *dst = out + row * dim_x1;
+            const TYPE *src = updates + (int64_t)i * dim_x1;
+            for (int64_t j = 0; j < dim_x1; j++) dst[j] = (TYPE)(dst[j] + src[j]);
+        }
+    });
+}
+
+template void tecoHostScatterNdAddIndex32<float>(ScatterNdAddArgs arg);
+template void tecoHostScatterNdAddIndex32<double>(ScatterNdAddArgs arg);
+template void tecoHostScatterNdAddIndex32<int>(ScatterNdAddArgs arg);
+template void tecoHostScatterNdAddIndex32<half_float::half>(ScatterNdAddArgs arg);
+template void tecoHostScatterNdAddIndex32<int64_t>(ScatterNdAddArgs arg);
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,96 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/scatter_out.h"
+
+#include "ual/host/thread_pool.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+enum {
+    REDUCE_NONE = 0,
+    REDUCE_ADD = 1,
+    REDUCE_MUL = 2,
+};
+
+// dims are innermost first. Each position of the index outside the axis scatters its K entries
+// in order; positions are independent only when they hit distinct outputs, which holds for
+// every non-axis position, so they are spread over the pool.
+void tecoHostScatterOutFT32(ScatterOutArgs arg) {
+    const int axis = arg.axis;
+    const int dim_ln = arg.dim_ln;
+    const float *input = (const float *)arg.input;
+    const int64_t *index = (const int64_t *)arg.index;
+    float *output = (float *)arg.output;
+
+    int dim_loop[MAX_DIM];
+    int64_t loop_cnt = 1, low_input = 1, low_index = 1, low_output = 1;
+    for (int i = 0; i < dim_ln; i++) {
+        dim_loop[i] = i == axis ? 1 : arg.dim_index[i];
+        loop_cnt *= dim_loop[i];
+        if (i < axis) {
+            low_input *= arg.dim_input[i];
+            low_index *= arg.dim_index[i];
+            low_output *= arg.dim_output[i];
+        }
+    }
+    const int K = arg.dim_index[axis];
+
+    parallelFor(loop_cnt, 64, [&](int64_t begin, int64_t end) {
+        for (int64_t l = begin; l < end; l++) {
+            int64_t offset_input = 0, offset_index = 0, offset_output = 0;
+            int64_t rest = l, scale_input = 1, scale_index = 1, scale_output = 1;
+            for (int i = 0; i < dim_ln; i++) {
+                const int64_t pos = rest % dim_loop[i];
+                rest /= dim_loop[i];
+                offset_input += pos * scale_input;
+                offset_index += pos * scale_index;
+                offset_output += pos * scale_output;
+                scale_input *= arg.dim_input[i];
+                scale_index *= arg.dim_index[i];
+                scale_output *= arg.dim_output[i];
+            }
+            for (int k = 0; k < K; k++) {
+                const int64_t idx = index[offset_index + k * low_index];
+                const float val = arg.is_scalar ? arg.alpha : input[offset_input + k * low_input];
+                float &dst = output[offset_output + idx * low_output];
+                if (arg.func_opcode == REDUCE_NONE) {
+                    dst = val;
+                } else if (arg.func_opcode == REDUCE_ADD) {
+                    dst += val;
+                } else {
+                    dst *= val;
+                }
+            }
+        }
+    });
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,255 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "ual/com/log.h"
+#include "ual/com/spe_cost.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+#define HOST_RANGES_PER_THREAD 8  // ranges per thread at most, slack for uneven costs
+#define HOST_SPIN_US 50           // an idle thread polls this long before it sleeps
+
+struct ParallelJob {
+    const RangeFunc *func;
+    int64_t grain;
+    std::atomic<int64_t> remaining;  // items not run yet, 0 once the job is done
+    std::atomic<int64_t> queued{0};  // ranges of the job sitting in the queues
+    std::atomic<bool> waiting{false};  // the caller sleeps on done_ until remaining or queued
+};
+
+static thread_local bool in_range = false;
+static thread_local ThreadPool *current_pool = nullptr;
+
+// Polls until cond holds or the spin budget is spent, returns cond
+template <typename Cond>
+static bool spinUntil(Cond cond) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(HOST_SPIN_US);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+static void pinThread(std::thread *thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(thread->native_handle(), sizeof(set), &set) != 0) {
+        WARNING("host thread can not be pinned to cpu %d", cpu);
+    }
+#else
+    (void)thread;
+    WARNING("host thread pinning is not supported, cpu %d ignored", cpu);
+#endif
+}
+
+ThreadPool::ThreadPool(int thread_num, const std::vector<int> &cpus)
+    : thread_num_(std::max(thread_num, 1)),
+      queue_num_(thread_num_ - 1 + HOST_CALLER_MAX),
+      queues_(new WorkQueue[queue_num_]) {
+    for (int i = queue_num_ - 1; i >= thread_num_ - 1; i--) free_slots_.push_back(i);
+    for (int i = 0; i + 1 < thread_num_; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        if (!cpus.empty()) pinThread(&workers_.back(), cpus[i % cpus.size()]);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool(SPE_NUM, std::vector<int>());
+    return pool;
+}
+
+ThreadPool &ThreadPool::current() { return current_pool ? *current_pool : shared(); }
+
+void ThreadPool::push(int slot, const RangeTask &task) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[slot].mutex);
+        queues_[slot].tasks.push_back(task);
+    }
+    task.job->queued.fetch_add(1);
+    pending_.fetch_add(1);
+    if (sleepers_.load() > 0 || task.job->waiting.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+        if (task.job->waiting.load()) done_.notify_all();
+    }
+}
+
+// A caller's queue only ever holds ranges of its job, so only stealing has to look at the job
+bool ThreadPool::findTask(int slot, const ParallelJob *only, RangeTask *task) {
+    if (pending_.load() == 0) return false;
+    if (only != nullptr && only->queued.load() == 0) return false;
+    {
+        WorkQueue &own = queues_[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            *task = own.tasks.back();
+            own.tasks.pop_back();
+            task->job->queued.fetch_sub(1);
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    for (int i = 1; i < queue_num_; i++) {
+        WorkQueue &victim = queues_[(slot + i) % queue_num_];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) continue;
+        auto it = victim.tasks.begin();
+        while (it != victim.tasks.end() && only != nullptr && it->job != only) ++it;
+        if (it != victim.tasks.end()) {
+            *task = *it;
+            victim.tasks.erase(it);
+            task->job->queued.fetch_sub(1);
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+int ThreadPool::acquireCallerSlot() {
+    std::lock_guard<std::mutex> lock(slot_mutex_);
+    if (free_slots_.empty()) return -1;
+    int slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+}
+
+void ThreadPool::releaseCallerSlot(int slot) {
+    std::lock_guard<std::mutex> lock(slot_mutex_);
+    free_slots_.push_back(slot);
+}
+
+void ThreadPool::runTask(int slot, RangeTask task) {
+    ParallelJob *job = task.job;
+    while (task.end - task.begin > job->grain) {
+        int64_t mid = task.begin + (task.end - task.begin) / 2;
+        push(slot, RangeTask{job, mid, task.end});
+        task.end = mid;
+    }
+    bool saved = in_range;
+    in_range = true;
+    (*job->func)(task.begin, task.end);
+    in_range = saved;
+
+    // the job may be gone once remaining reaches 0, only the pool is touched after it
+    int64_t size = task.end - task.begin;
+    if (job->remaining.fetch_sub(size) == size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(int slot) {
+    for (;;) {
+        RangeTask task;
+        if (findTask(slot, nullptr, &task)) {
+            runTask(slot, task);
+            continue;
+        }
+        if (spinUntil([&]() { return pending_.load() > 0; })) continue;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1);
+        wake_.wait(lock, [&]() { return stop_ || pending_.load() > 0; });
+        sleepers_.fetch_sub(1);
+        if (stop_) return;
+    }
+}
+
+void ThreadPool::parallelFor(int64_t n, int64_t grain, const RangeFunc &func) {
+    if (n <= 0) return;
+    const int64_t range_max = (int64_t)thread_num_ * HOST_RANGES_PER_THREAD;
+    grain = std::max(std::max<int64_t>(grain, 1), (n + range_max - 1) / range_max);
+    if (n <= grain || thread_num_ == 1 || in_range) {
+        func(0, n);
+        return;
+    }
+
+    const int caller = acquireCallerSlot();
+    if (caller < 0) {
+        DLOG("host pool has %d callers already, running inline", HOST_CALLER_MAX);
+        func(0, n);
+        return;
+    }
+    ParallelJob job;
+    job.func = &func;
+    job.grain = grain;
+    job.remaining = n;
+
+    // every thread starts on a slice of its own and steals once that is used up; the busy
+    // ones leave theirs to the others
+    const int64_t slice = (n + thread_num_ - 1) / thread_num_;
+    for (int i = 0; i < thread_num_ && i * slice < n; i++) {
+        int slot = i < thread_num_ - 1 ? i : caller;
+        push(slot, RangeTask{&job, i * slice, std::min(n, (i + 1) * slice)});
+    }
+
+    RangeTask task;
+    while (job.remaining.load() > 0) {
+        if (findTask(caller, &job, &task)) {
+            runTask(caller, task);
+            continue;
+        }
+        auto ready = [&]() { return job.remaining.load() == 0 || job.queued.load() > 0; };
+        if (spinUntil(ready)) continue;
+        std::unique_lock<std::mutex> lock(mutex_);
+        job.waiting.store(true);
+        done_.wait(lock, ready);
+        job.waiting.store(false);
+    }
+    releaseCallerSlot(caller);
+}
+
+PoolScope::PoolScope(ThreadPool *pool) : saved_(current_pool) {
+    if (pool != nullptr) current_pool = pool;
+}
+
+PoolScope::~PoolScope() { current_pool = saved_; }
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,129 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_HOST_THREAD_POOL_H_
+#define UAL_HOST_THREAD_POOL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+#define HOST_CALLER_MAX 8  // parallelFor calls in flight at once on one pool
+
+typedef std::function<void(int64_t begin, int64_t end)> RangeFunc;
+
+struct ParallelJob;
+
+struct RangeTask {
+    ParallelJob *job;
+    int64_t begin;
+    int64_t end;
+};
+
+// One deque per thread: the owner pushes and pops at the back, thieves take from the front,
+// where the largest ranges sit.
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<RangeTask> tasks;
+};
+
+// Work-stealing pool that runs the host kernels. parallelFor hands every thread a slice of
+// [0, n); a thread splits its slice in halves down to the grain, keeps the front half and
+// leaves the back half for idle threads to steal. Every range carries its job, so jobs of
+// several callers share the queues: workers take ranges of any job, while a caller only runs
+// ranges of its own job and returns once all of its [0, n) is done. Work of at most one grain,
+// parallelFor issued from inside a range, and callers beyond HOST_CALLER_MAX at a time run
+// inline on the caller.
+class ThreadPool {
+ public:
+    // thread_num threads take ranges, the caller included. Worker i is pinned to
+    // cpus[i % cpus.size()] when cpus is not empty.
+    ThreadPool(int thread_num, const std::vector<int> &cpus);
+    ~ThreadPool();
+
+    // SPE_NUM threads, as many as a handle's spe_num, used by every handle without a pool of
+    // its own
+    static ThreadPool &shared();
+    // the pool a PoolScope installed on this thread, else shared()
+    static ThreadPool &current();
+
+    int concurrency() const { return thread_num_; }
+
+    void parallelFor(int64_t n, int64_t grain, const RangeFunc &func);
+
+ private:
+    void workerLoop(int slot);
+    void push(int slot, const RangeTask &task);
+    // only: take ranges of this job alone, null: of any job
+    bool findTask(int slot, const ParallelJob *only, RangeTask *task);
+    void runTask(int slot, RangeTask task);
+    int acquireCallerSlot();
+    void releaseCallerSlot(int slot);
+
+    const int thread_num_;
+    const int queue_num_;  // a queue per worker, then one per caller slot
+    std::unique_ptr<WorkQueue[]> queues_;
+    std::mutex slot_mutex_;
+    std::vector<int> free_slots_;  // caller queues not owned by a running parallelFor
+    std::atomic<int64_t> pending_{0};  // tasks sitting in the queues
+    std::atomic<int> sleepers_{0};
+    std::mutex mutex_;  // guards the sleeps on wake_ and done_
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
+
+// Routes the host kernels launched on this thread to pool for the scope's lifetime; a null
+// pool keeps the current one.
+class PoolScope {
+ public:
+    explicit PoolScope(ThreadPool *pool);
+    ~PoolScope();
+
+ private:
+    ThreadPool *saved_;
+};
+
+static inline void parallelFor(int64_t n, int64_t grain, const RangeFunc &func) {
+    ThreadPool::current().parallelFor(n, grain, func);
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_HOST_THREAD_POOL_H_
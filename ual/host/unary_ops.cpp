@@ -0,0 +1,55 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/unary_ops.h"
+
+#include "ual/host/thread_pool.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// y = x + alpha (mode 11) or y = x * alpha (mode 13)
+template <typename T>
+static void unaryOpsWithAlpha(const UnaryOpsArgs &arg, T alpha) {
+    const T *x = (const T *)arg.x;
+    T *y = (T *)arg.y;
+    const bool add = arg.mode == UALUnaryOpsMode::UAL_BATCH_ADD_A;
+    if (!add && arg.mode != UALUnaryOpsMode::UAL_BATCH_MUL_A) return;
+    parallelFor(arg.n, 16384, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) y[i] = add ? x[i] + alpha : x[i] * alpha;
+    });
+}
+
+void tecoHostUnaryOpsWithAlphaFT32(UnaryOpsArgs arg) { unaryOpsWithAlpha(arg, arg.alpha_f32); }
+
+void tecoHostUnaryOpsWithAlphaINT32(UnaryOpsArgs arg) {
+    unaryOpsWithAlpha(arg, arg.alpha_int32);
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
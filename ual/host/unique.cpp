@@ -0,0 +1,76 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/host/unique.h"
+
+#include <algorithm>
+#include <vector>
+#include "ual/host/thread_pool.h"
+
+namespace tecoal {
+namespace ual {
+namespace host {
+
+// y = sorted distinct values of x, inverse[i] = position of x[i] in y, counts = occurrences
+void tecoHostUniqueSortedInt64(UniqueArgs arg) {
+    const int64_t *x = (const int64_t *)arg.x;
+    int64_t *y = (int64_t *)arg.y;
+    int64_t *counts = (int64_t *)arg.counts;
+    const int64_t data_len = arg.data_len;
+
+    // the copy to sort lives in the handle's workspace when it has room
+    std::vector<int64_t> local;
+    int64_t *sorted = (int64_t *)arg.sort_buf;
+    if (sorted == nullptr) {
+        local.resize(data_len);
+        sorted = local.data();
+    }
+    std::copy(x, x + data_len, sorted);
+    std::sort(sorted, sorted + data_len);
+    int64_t out_size = 0;
+    for (int64_t i = 0; i < data_len; i++) {
+        if (i == 0 || sorted[i] != sorted[i - 1]) {
+            y[out_size] = sorted[i];
+            if (arg.return_counts) counts[out_size] = 0;
+            out_size++;
+        }
+        if (arg.return_counts) counts[out_size - 1]++;
+    }
+
+    if (arg.return_inverse) {
+        int64_t *inverse = (int64_t *)arg.inverse;
+        parallelFor(data_len, 4096, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; i++) {
+                inverse[i] = std::lower_bound(y, y + out_size, x[i]) - y;
+            }
+        });
+    }
+    *(int64_t *)arg.out_size = out_size;
+}
+
+}  // namespace host
+}  // namespace ual
+}  // namespace tecoal
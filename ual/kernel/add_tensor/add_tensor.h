@@ -39,6 +39,7 @@ __global__ void tecoKernelAddTensorHalfSingleThreadImpl(AddTensorArgs arg);
 __global__ void tecoKernelAddTensorHalfMultiThreadsImpl(AddTensorArgs arg);
 __global__ void tecoKernelAddTensorHalfDoubleBufferImpl(AddTensorArgs arg);
 __global__ void tecoKernelAddTensorHalfSIMDImpl(AddTensorArgs arg);
+__global__ void tecoKernelAddTensorHalfBroadcastImpl(AddTensorArgs arg);
 
 }  // namespace kernel
 }  // namespace ual
@@ -0,0 +1,134 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_KERNEL_BROADCAST_HPP_
+#define UAL_KERNEL_BROADCAST_HPP_
+
+#include "ual/com/broadcast.h"
+
+using tecoal::ual::common::BroadcastPlan;
+
+__device__ inline int64_t broadcastElemNum(const BroadcastPlan *plan) {
+    int64_t num = 1;
+    for (int i = 0; i < plan->nb_dims; i++) num *= plan->dims[i];
+    return num;
+}
+
+// Walks the elements [start, ...) of a BroadcastPlan in runs along the innermost dim. Inside a
+// run each operand advances by its innermost stride, so an operand with stride 0 there is one
+// element for the whole run and is loaded once instead of once per element.
+struct BroadcastRunIter {
+    const BroadcastPlan *plan;
+    int coord[UAL_BROADCAST_DIM_MAX];
+    int64_t offset[UAL_BROADCAST_OPERAND_MAX];
+
+    __device__ inline void init(const BroadcastPlan *p, int64_t start) {
+        plan = p;
+        for (int k = 0; k < p->operand_num; k++) offset[k] = 0;
+        for (int d = p->nb_dims - 1; d >= 0; d--) {
+            coord[d] = (int)(start % p->dims[d]);
+            start /= p->dims[d];
+            for (int k = 0; k < p->operand_num; k++) {
+                offset[k] += (int64_t)coord[d] * p->strides[k][d];
+            }
+        }
+    }
+
+    __device__ inline int innerStride(int operand) const {
+        return plan->strides[operand][plan->nb_dims - 1];
+    }
+
+    // length of the run starting at the current element, capped at max_len
+    __device__ inline int runLength(int max_len) const {
+        int rest = plan->dims[plan->nb_dims - 1] - coord[plan->nb_dims - 1];
+        return rest < max_len ? rest : max_len;
+    }
+
+    __device__ inline void advance(int len) {
+        int d = plan->nb_dims - 1;
+        coord[d] += len;
+        for (int k = 0; k < plan->operand_num; k++) offset[k] += (int64_t)len * plan->strides[k][d];
+        while (d > 0 && coord[d] == plan->dims[d]) {
+            for (int k = 0; k < plan->operand_num; k++) {
+                offset[k] += plan->strides[k][d - 1] - (int64_t)plan->dims[d] * plan->strides[k][d];
+            }
+            coord[d] = 0;
+            coord[--d]++;
+        }
+    }
+};
+
+// Gathers count elements of operand, starting at logical element start, into spm. Unit-stride
+// runs go by dma; broadcast runs read their single element once and replicate it in spm, so
+// the expanded operand never exists in global memory.
+template <typename T>
+__device__ inline void broadcastLoad(T *spm, const T *src, const BroadcastPlan *plan, int operand,
+                                     int64_t start, int count) {
+    BroadcastRunIter it;
+    it.init(plan, start);
+    const int stride = it.innerStride(operand);
+    sdaa::MemcpyHandle handle;
+    for (int pos = 0; pos < count;) {
+        int len = it.runLength(count - pos);
+        const T *run = src + it.offset[operand];
+        if (stride == 1) {
+            sdaa::memcpy_async(spm + pos, run, len * sizeof(T), sdaa::MemcpyGlobalToSpm, handle);
+        } else if (stride == 0) {
+            const T value = *run;
+            for (int j = 0; j < len; j++) spm[pos + j] = value;
+        } else {
+            for (int j = 0; j < len; j++) spm[pos + j] = run[(int64_t)j * stride];
+        }
+        pos += len;
+        it.advance(len);
+    }
+    sdaa::memcpy_wait(handle);
+}
+
+// Scatters count elements from spm back to an operand without broadcast dims, the output.
+template <typename T>
+__device__ inline void broadcastStore(T *dst, const T *spm, const BroadcastPlan *plan, int operand,
+                                      int64_t start, int count) {
+    BroadcastRunIter it;
+    it.init(plan, start);
+    const int stride = it.innerStride(operand);
+    sdaa::MemcpyHandle handle;
+    for (int pos = 0; pos < count;) {
+        int len = it.runLength(count - pos);
+        T *run = dst + it.offset[operand];
+        if (stride == 1) {
+            sdaa::memcpy_async(run, (T *)spm + pos, len * sizeof(T), sdaa::MemcpySpmToGlobal,
+                               handle);
+        } else {
+            for (int j = 0; j < len; j++) run[(int64_t)j * stride] = spm[pos + j];
+        }
+        pos += len;
+        it.advance(len);
+    }
+    sdaa::memcpy_wait(handle);
+}
+
+#endif  // UAL_KERNEL_BROADCAST_HPP_
@@ -36,6 +36,7 @@ namespace ual {
 namespace kernel {
 
 __global__ void tecoKernelMaskedFillFT32(MaskedFillArgs arg);
+__global__ void tecoKernelMaskedFillBroadcastFT32(MaskedFillArgs arg);
 
 }  // namespace kernel
 }  // namespace ual
@@ -38,6 +38,9 @@ namespace kernel {
 template <typename TYPE_A, typename TYPE_B>
 __global__ void tecoKernelMaskedSelectNobroadcast(MaskedSelectArgs arg);
 
+template <typename TYPE_A, typename TYPE_B>
+__global__ void tecoKernelMaskedSelectBroadcast(MaskedSelectArgs arg);
+
 }  // namespace kernel
 }  // namespace ual
 }  // namespace tecoal
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/activation_backward_args.h"
 #include "ual/com/def.h"
+#include "ual/host/activation_backward.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/activation_backward/find_activation_backward.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::ActivationBwdArgs;
 using tecoal::ual::args::ActivationBwdPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,14 @@ struct ActivationBackwardType {
     using PatchType = ActivationBwdPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, x), offsetof(ArgsType, dy), offsetof(ArgsType, y),
+            offsetof(ArgsType, dx)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ActivationBackwardType::PImplType ActivationBackwardAlgos[] = {
@@ -69,6 +79,16 @@ struct ActivationBwdOp : public BaseOp<ActivationBwdOp, ActivationBackwardType>
 
     static const char *name() { return "activation_backward"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "n=%d", arg->data_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // half on device, half or bfloat16 on host; x, dy and y are read
+        uint64_t n = arg->data_num;
+        *cost = {3 * n * 2, n * 2, n};
+    }
+
     Status findImpl(const PatchType *args) {
         ActivationBackwardBranch branch = findActivationBackwardBranch(args);
         if (branch == ActivationBackwardBranch::ACTIVATION_BACKWARD_END) {
@@ -76,9 +96,21 @@ struct ActivationBwdOp : public BaseOp<ActivationBwdOp, ActivationBackwardType>
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ActivationBackwardAlgos[index], ActivationBackwardDiscription[index]);
+        setInstance(ActivationBackwardAlgos[index], ActivationBackwardDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_HALF && args->abarg->mode == 13) {
+            setInstance(tecoHostActivationBackwardSiluFT16, "tecoHostActivationBackwardSiluFT16");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16 && args->abarg->mode == 13) {
+            setInstance(tecoHostActivationBackwardSiluBF16, "tecoHostActivationBackwardSiluBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -37,7 +37,7 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 ActivationBackwardBranch findActivationBackwardBranch(const ActivationBwdPatchArgs *arg) {
     if (arg->data_type == UALDataType::UAL_DTYPE_HALF && arg->abarg->mode == 13) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ActivationBackwardBranch::ACTIVATION_BACKWARD_HALF;
         }
     }
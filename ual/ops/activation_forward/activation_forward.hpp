@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/activation_forward_args.h"
 #include "ual/com/def.h"
+#include "ual/host/activation_forward.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/activation_forward/find_activation_forward.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::ActivationFwdArgs;
 using tecoal::ual::args::ActivationFwdPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,14 @@ struct ActivationForwardType {
     using PatchType = ActivationFwdPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, x), offsetof(ArgsType, y), offsetof(ArgsType, table_a),
+            offsetof(ArgsType, table_b)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ActivationForwardType::PImplType ActivationForwardAlgos[] = {
@@ -69,6 +79,16 @@ struct ActivationFwdOp : public BaseOp<ActivationFwdOp, ActivationForwardType> {
 
     static const char *name() { return "activation_forward"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "rows=%d n=%d", arg->row_num, arg->data_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // half on device, half or bfloat16 on host
+        uint64_t n = (uint64_t)arg->row_num * arg->data_num;
+        *cost = {n * 2, n * 2, n};
+    }
+
     Status findImpl(const PatchType *args) {
         ActivationForwardBranch branch = findActivationForwardBranch(args);
         if (branch == ActivationForwardBranch::ACTIVATION_FORWARD_END) {
@@ -76,9 +96,21 @@ struct ActivationFwdOp : public BaseOp<ActivationFwdOp, ActivationForwardType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ActivationForwardAlgos[index], ActivationForwardDiscription[index]);
+        setInstance(ActivationForwardAlgos[index], ActivationForwardDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_HALF && args->afarg->mode == 13) {
+            setInstance(tecoHostActivationForwardFT16, "tecoHostActivationForwardFT16");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16 && args->afarg->mode == 13) {
+            setInstance(tecoHostActivationForwardBF16, "tecoHostActivationForwardBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -36,9 +36,13 @@ namespace ops {
 
 // Define a function to determine the best algorithm branch based on given arguments.
 ActivationForwardBranch findActivationForwardBranch(const ActivationFwdPatchArgs *arg) {
-    if (arg->data_type == UALDataType::UAL_DTYPE_HALF && arg->afarg->data_num % 2 == 0 &&
-        arg->afarg->mode == 13) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+    // every row has to start 4B aligned for the dma, same as the row length
+    const ActivationFwdArgs *afarg = arg->afarg;
+    bool even_rows = afarg->data_num % 2 == 0 &&
+                     (afarg->row_num == 1 || (afarg->x_row_stride % 2 == 0 &&
+                                              afarg->y_row_stride % 2 == 0));
+    if (arg->data_type == UALDataType::UAL_DTYPE_HALF && even_rows && afarg->mode == 13) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ActivationForwardBranch::ACTIVATION_FORWARD_HALF;
         }
     }
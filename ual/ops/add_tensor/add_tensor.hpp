@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/add_tensor_args.h"
 #include "ual/com/def.h"
+#include "ual/host/add_tensor.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/add_tensor/find_add_tensor.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::AddTensorArgs;
 using tecoal::ual::args::AddTensorPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,17 +50,25 @@ struct AddTensorType {
     using PatchType = AddTensorPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, A), offsetof(ArgsType, C)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static AddTensorType::PImplType AddTensorAlgos[] = {
     tecoKernelAddTensorHalfSingleThreadImpl, tecoKernelAddTensorHalfMultiThreadsImpl,
     tecoKernelAddTensorHalfDoubleBufferImpl, tecoKernelAddTensorHalfSIMDImpl,
+    tecoKernelAddTensorHalfBroadcastImpl,
     // more branches
 };
 
 static const char *AddTensorDiscription[] = {
     "tecoKernelAddTensorHalfSingleThreadImpl", "tecoKernelAddTensorHalfMultiThreadsImpl",
     "tecoKernelAddTensorHalfDoubleBufferImpl", "tecoKernelAddTensorHalfSIMDImpl",
+    "tecoKernelAddTensorHalfBroadcastImpl",
     // more branches
 };
 
@@ -71,15 +81,39 @@ struct AddTensorOp : public BaseOp<AddTensorOp, AddTensorType> {
 
     static const char *name() { return "add_tensor"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "a=%dx%dx%d c=%dx%dx%d", arg->a_n_num, arg->a_c_num, arg->a_hw_num,
+                 arg->c_n_num, arg->a_c_num, arg->c_hw_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // half on device, half or bfloat16 on host; C = alpha * A + beta * C
+        uint64_t a = (uint64_t)arg->a_n_num * arg->a_c_num * arg->a_hw_num;
+        uint64_t c = (uint64_t)arg->c_n_num * arg->a_c_num * arg->c_hw_num;
+        *cost = {(a + c) * 2, c * 2, 3 * c};
+    }
+
     Status findImpl(const PatchType *args) {
         int index = findAddTensorBranch(args);
         if (index == -1) {
             ERROR("add_tensor branch is not exit!");
             return Status::NOT_IMPLEMENTED;
         }
-        setInstance(AddTensorAlgos[index], AddTensorDiscription[index]);
+        setInstance(AddTensorAlgos[index], AddTensorDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_HALF) {
+            setInstance(tecoHostAddTensorHalf, "tecoHostAddTensorHalf");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16) {
+            setInstance(tecoHostAddTensorBF16, "tecoHostAddTensorBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
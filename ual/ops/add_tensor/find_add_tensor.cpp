@@ -34,22 +34,36 @@ namespace tecoal {
 namespace ual {
 namespace ops {
 
+// index of tecoKernelAddTensorHalfBroadcastImpl in AddTensorAlgos
+#define ADD_TENSOR_BROADCAST_ALGO 4
+// the row kernel UAL_ALGO_BEST runs, tecoKernelAddTensorHalfSIMDImpl
+#define ADD_TENSOR_DEFAULT_ALGO 3
+
 // Define a function to determine the best algorithm branch for adding tensors based on given
 // arguments.
 int findAddTensorBranch(const AddTensorPatchArgs *arg) {
     // Convert the algorithm type from the arguments to an index for internal use.
-    int algo = common::convertAlgoToIndex(arg->algo);
-
-    // Check if the product of 'n' and 'hw' dimensions for tensors A and C are equal.
-    if (arg->atargs->a_n_num * arg->atargs->a_hw_num ==
-        arg->atargs->c_n_num * arg->atargs->c_hw_num) {
-        // If the data type is half-precision floating-point (FP16),
-        // and the total number of elements (n * hw * c) in tensor A is even,
-        if (arg->data_type == UALDataType::UAL_DTYPE_HALF &&
-            (arg->atargs->a_n_num * arg->atargs->a_hw_num * arg->atargs->a_c_num) % 2 == 0) {
-            // An optimal kernel for half-precision addition is selected.
-            return algo;
-        }
+    int algo = arg->algo == UALAlgoType::UAL_ALGO_BEST ? ADD_TENSOR_DEFAULT_ALGO
+                                                       : common::convertAlgoToIndex(arg->algo);
+    if (algo < 0 || algo > ADD_TENSOR_BROADCAST_ALGO) return -1;
+
+    // Every kernel variant is half-precision floating-point (FP16).
+    const AddTensorArgs *atargs = arg->atargs;
+    if (arg->data_type != UALDataType::UAL_DTYPE_HALF) return -1;
+
+    // A and C coalesce to unit-stride rows, A possibly repeated per row (row_num is 0
+    // otherwise). If every row is an even number of elements starting at an even offset,
+    bool even_rows = atargs->data_num % 2 == 0 &&
+                     (atargs->row_num == 1 ||
+                      (atargs->a_row_stride % 2 == 0 && atargs->c_row_stride % 2 == 0));
+    if (atargs->row_num > 0 && even_rows) {
+        // An optimal kernel for half-precision addition is selected.
+        return algo;
+    }
+
+    // Any other layout, including A broadcast along inner dims, walks the broadcast plan.
+    if (atargs->plan.nb_dims > 0) {
+        return ADD_TENSOR_BROADCAST_ALGO;
     }
     // If none of the above conditions are met, return -1 indicating no specialized branch was
     // found.
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/arg_max_args.h"
 #include "ual/com/def.h"
+#include "ual/host/arg_max.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/arg_max/find_arg_max.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::ArgMaxArgs;
 using tecoal::ual::args::ArgMaxPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,12 @@ struct ArgMaxType {
     using PatchType = ArgMaxPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, x), offsetof(ArgsType, y)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ArgMaxType::PImplType ArgMaxAlgos[] = {
@@ -69,6 +77,16 @@ struct ArgMaxOp : public BaseOp<ArgMaxOp, ArgMaxType> {
 
     static const char *name() { return "arg_max"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "high=%d axis=%d low=%d", arg->high_num, arg->axis_num, arg->low_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t n = (uint64_t)arg->high_num * arg->axis_num * arg->low_num;
+        uint64_t out = (uint64_t)arg->high_num * arg->low_num;
+        *cost = {n * arg->dtype_size, out * sizeof(int64_t), n};
+    }
+
     Status findImpl(const PatchType *args) {
         ArgMaxBranch branch = findArgMaxBranch(args);
         if (branch == ArgMaxBranch::ARG_MAX_END) {
@@ -76,9 +94,21 @@ struct ArgMaxOp : public BaseOp<ArgMaxOp, ArgMaxType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ArgMaxAlgos[index], ArgMaxDiscription[index]);
+        setInstance(ArgMaxAlgos[index], ArgMaxDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_HALF) {
+            setInstance(tecoHostArgmaxFT16, "tecoHostArgmaxFT16");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16) {
+            setInstance(tecoHostArgmaxBF16, "tecoHostArgmaxBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
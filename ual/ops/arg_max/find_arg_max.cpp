@@ -37,7 +37,7 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 ArgMaxBranch findArgMaxBranch(const ArgMaxPatchArgs *arg) {
     if (arg->data_type == (UALDataType::UAL_DTYPE_HALF)) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ArgMaxBranch::ARG_MAX_HALF;
         }
     }
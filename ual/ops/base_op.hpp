@@ -29,17 +29,31 @@
 
 #include <type_traits>
 #include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include "ual/com/def.h"
 #include "ual/com/log.h"
+#include "ual/ops/profiler.h"
+#include "ual/ops/op_stats.h"
+#ifdef UAL_HOST_EMU
+#include "ual/emu/spe.h"
+#include "ual/emu/timing.h"
+#endif
 
 namespace tecoal {
 namespace ual {
 namespace ops {
 
-#define RUN_KERNEL(func_ptr, stream_id, arg) \
-    ({                                       \
-        func_ptr<<<1, stream_id>>>(arg);     \
-        0;                                   \
+#ifdef UAL_HOST_EMU
+// kernels built as host C++ run on the SPE emulator, the launch returns once they finished
+#define RUN_KERNEL(func_ptr, stream_id, arg, name) tecoal::ual::emu::launch(func_ptr, arg, name)
+#else
+#define RUN_KERNEL(func_ptr, stream_id, arg, name) \
+    ({                                             \
+        func_ptr<<<1, stream_id>>>(arg);           \
+        0;                                         \
     })
+#endif
 
 template <typename T, typename Ty>
 struct BaseOp {
@@ -56,25 +70,150 @@ struct BaseOp {
     BaseOp &operator=(const BaseOp &other) = delete;
     BaseOp &operator=(BaseOp &&other) = delete;
 
-    Status find(const PatchType *args) { return static_cast<T *>(this)->findImpl(args); }
+    // Host kernels take the same args and are picked by findHostImpl
+    Status find(const PatchType *args) {
+        if (backend_ == UALBackend::UAL_BACKEND_HOST) {
+            return static_cast<T *>(this)->findHostImpl(args);
+        }
+        return static_cast<T *>(this)->findImpl(args);
+    }
+
+    // Re-apply what find() patched into the kernel args, taken from a cached find() result.
+    void restore(const ArgsType *cached, ArgsType *arg) {
+        static_cast<T *>(this)->restoreImpl(cached, arg);
+    }
 
     __attribute__((noinline, used)) Status run(const ArgsType *arg, sdaaStream_t stream_id) {
         if (instance_ == nullptr || discription_ == nullptr) {
             ERROR("input args is bad param!");
             return Status::BAD_PARAMETER;
         }
-        RUN_KERNEL(instance_, stream_id, *arg);
-        return Status::SUCCESS;
+        if (__builtin_expect(Profiler::enabled() || OpStats::enabled(), 0)) {
+            return instrumentedRun(arg, stream_id);
+        }
+        return launch(arg, stream_id);
     }
 
-    void setInstance(PImplType instance, const char *discription) {
+    void setBackend(UALBackend backend) { backend_ = backend; }
+    UALBackend backend() const { return backend_; }
+
+    // Counters of the handle the launch goes through, null: not counted
+    void setStats(OpStats *stats) { stats_ = stats; }
+    OpStats *stats() const { return stats_; }
+
+    // algo is the index of the kernel in the op's Algos table, -1 if unknown
+    void setInstance(PImplType instance, const char *discription, int algo = -1) {
         instance_ = instance;
         discription_ = discription;
+        algo_ = algo;
+    }
+
+    // Offsets of the device pointer fields in ArgsType, so recorded args can be rebound
+    static const size_t *pointers(int *count) { return Ty::pointers(count); }
+
+    // Bytes those fields point past the caller's buffers, e.g. the slice of a pointer array one
+    // launch covers; rebinding a caller buffer keeps the offset
+    static size_t pointerOffset(const ArgsType *arg) { return T::pointerOffsetImpl(arg); }
+
+    PImplType instance() const { return instance_; }
+    const char *discription() const { return discription_; }
+    int algo() const { return algo_; }
+
+    // Short text of the problem size for traces, e.g. "m=256 n=256 k=512"
+    static void shape(const ArgsType *arg, char *buf, size_t size) { T::shapeImpl(arg, buf, size); }
+
+    // Bytes and FLOPs of one launch, for the op statistics
+    static void cost(const ArgsType *arg, OpCost *cost) { T::costImpl(arg, cost); }
+
+    // most find() implementations only pick a kernel and leave the args untouched
+    void restoreImpl(const ArgsType *cached, ArgsType *arg) {}
+
+    Status findHostImpl(const PatchType *args) {
+        ERROR("%s has no host kernel for these args!", T::name());
+        return Status::NOT_SUPPORTED;
     }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) { buf[0] = '\0'; }
+    static void costImpl(const ArgsType *arg, OpCost *cost) { *cost = {0, 0, 0}; }
+    static size_t pointerOffsetImpl(const ArgsType *arg) { return 0; }
+
  private:
+    // a host kernel has finished when it returns, the stream only orders device kernels
+    Status launch(const ArgsType *arg, sdaaStream_t stream_id) {
+        if (backend_ == UALBackend::UAL_BACKEND_HOST) {
+            instance_(*arg);
+            return Status::SUCCESS;
+        }
+        if (RUN_KERNEL(instance_, stream_id, *arg, discription_) != 0) {
+            ERROR("%s failed to run", discription_);
+            return Status::RUNTIME_ERROR;
+        }
+        return Status::SUCCESS;
+    }
+
+    // A trace needs the kernel's start and end, so while tracing this waits for the kernel.
+    // Statistics alone bracket a device kernel with events and never wait.
+    __attribute__((noinline)) Status instrumentedRun(const ArgsType *arg,
+                                                     sdaaStream_t stream_id) {
+        bool count = OpStats::enabled() && stats_ != nullptr;
+        if (!Profiler::enabled() && count && backend_ == UALBackend::UAL_BACKEND_DEVICE) {
+            return countedRun(arg, stream_id);
+        }
+        uint64_t start_ns = Profiler::now();
+        Status status = launch(arg, stream_id);
+        if (status != Status::SUCCESS) return status;
+        if (backend_ == UALBackend::UAL_BACKEND_DEVICE) sdaaStreamSynchronize(stream_id);
+        uint64_t end_ns = Profiler::now();
+#ifdef UAL_HOST_EMU
+        // what the emulator predicts for the device, not how long the host took to emulate
+        if (backend_ == UALBackend::UAL_BACKEND_DEVICE) {
+            end_ns = start_ns + tecoal::ual::emu::lastTiming().ns;
+        }
+#endif
+
+        if (Profiler::enabled()) {
+            TraceRecord record;
+            record.name = T::name();
+            record.discription = discription_;
+            record.algo = algo_;
+            record.start_ns = start_ns;
+            record.end_ns = end_ns;
+            shape(arg, record.shape, sizeof(record.shape));
+            Profiler::instance().record(record);
+        }
+        if (count) {
+            OpCost op_cost;
+            cost(arg, &op_cost);
+            stats_->record(T::name(), discription_, algo_, end_ns - start_ns, op_cost);
+        }
+        return Status::SUCCESS;
+    }
+
+    Status countedRun(const ArgsType *arg, sdaaStream_t stream_id) {
+        sdaaEvent_t start, end;
+        stats_->takeEvents(&start, &end);
+        if (start == nullptr || end == nullptr) {
+            stats_->releaseEvents(start, end);
+            return launch(arg, stream_id);
+        }
+        sdaaEventRecord(start, stream_id);
+        Status status = launch(arg, stream_id);
+        if (status != Status::SUCCESS) {
+            stats_->releaseEvents(start, end);
+            return status;
+        }
+        sdaaEventRecord(end, stream_id);
+        OpCost op_cost;
+        cost(arg, &op_cost);
+        stats_->recordDevice(T::name(), discription_, algo_, start, end, op_cost);
+        return Status::SUCCESS;
+    }
+
     PImplType instance_ = nullptr;
     const char *discription_ = nullptr;
+    int algo_ = -1;
+    UALBackend backend_ = UALBackend::UAL_BACKEND_DEVICE;
+    OpStats *stats_ = nullptr;
 };
 
 }  // namespace ops
@@ -0,0 +1,137 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_CAST_TENSOR_CAST_TENSOR_HPP_
+#define UAL_OPS_CAST_TENSOR_CAST_TENSOR_HPP_
+
+#include "ual/kernel/cast_tensor/cast_tensor.h"
+#include "ual/com/log.h"
+#include "ual/args/cast_tensor_args.h"
+#include "ual/com/def.h"
+#include "ual/host/cast_tensor.h"
+#include "ual/ops/base_op.hpp"
+#include "ual/ops/cast_tensor/find_cast_tensor.h"
+
+using tecoal::ual::args::CastTensorArgs;
+using tecoal::ual::args::CastTensorPatchArgs;
+using namespace tecoal::ual::common;
+using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+struct CastTensorType {
+    using ArgsType = CastTensorArgs;        // using implement kernel args
+    using PatchType = CastTensorPatchArgs;  // using patch args
+    using RetType = void;
+    using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, x), offsetof(ArgsType, y)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
+};
+
+// indexed by CastTensorBranch
+static CastTensorType::PImplType CastTensorAlgos[] = {
+    tecoKernelCastTensorFT32ToBF16,
+    tecoKernelCastTensorBF16ToFT32,
+    tecoKernelCastTensorFT16ToBF16,
+    tecoKernelCastTensorBF16ToFT16,
+    // more branches
+};
+
+static const char *CastTensorDiscription[] = {
+    "tecoKernelCastTensorFT32ToBF16",
+    "tecoKernelCastTensorBF16ToFT32",
+    "tecoKernelCastTensorFT16ToBF16",
+    "tecoKernelCastTensorBF16ToFT16",
+    // more branches
+};
+
+static CastTensorType::PImplType CastTensorHostAlgos[] = {
+    tecoHostCastTensorFT32ToBF16,
+    tecoHostCastTensorBF16ToFT32,
+    tecoHostCastTensorFT16ToBF16,
+    tecoHostCastTensorBF16ToFT16,
+};
+
+static const char *CastTensorHostDiscription[] = {
+    "tecoHostCastTensorFT32ToBF16",
+    "tecoHostCastTensorBF16ToFT32",
+    "tecoHostCastTensorFT16ToBF16",
+    "tecoHostCastTensorBF16ToFT16",
+};
+
+struct CastTensorOp : public BaseOp<CastTensorOp, CastTensorType> {
+ public:
+    using ArgsType = typename CastTensorType::ArgsType;    // using implement kernel args
+    using PatchType = typename CastTensorType::PatchType;  // using dispatch args
+    using RetType = typename CastTensorType::RetType;
+    using PImplType = typename CastTensorType::PImplType;
+
+    static const char *name() { return "cast_tensor"; }
+
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "rows=%d n=%d %d->%d bytes", arg->row_num, arg->data_num, arg->x_size,
+                 arg->y_size);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t n = (uint64_t)arg->row_num * arg->data_num;
+        *cost = {n * arg->x_size, n * arg->y_size, n};
+    }
+
+    Status findImpl(const PatchType *args) {
+        CastTensorBranch branch = findCastTensorBranch(args);
+        if (branch == CastTensorBranch::CAST_TENSOR_END) {
+            ERROR("cast_tensor branch is not exit!");
+            return Status::NOT_IMPLEMENTED;
+        }
+        int index = static_cast<int>(branch);
+        setInstance(CastTensorAlgos[index], CastTensorDiscription[index], index);
+        return Status::SUCCESS;
+    }
+
+    Status findHostImpl(const PatchType *args) {
+        // the host kernels have no algo choice, only the type pair picks one
+        PatchType host_args = *args;
+        host_args.algo = UALAlgoType::UAL_ALGO_0;
+        CastTensorBranch branch = findCastTensorBranch(&host_args);
+        if (branch == CastTensorBranch::CAST_TENSOR_END) return Status::NOT_SUPPORTED;
+        int index = static_cast<int>(branch);
+        setInstance(CastTensorHostAlgos[index], CastTensorHostDiscription[index]);
+        return Status::SUCCESS;
+    }
+};
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_CAST_TENSOR_CAST_TENSOR_HPP_
@@ -29,13 +29,16 @@
 
 #include "ual/kernel/conv_forward/conv_forward.h"
 #include "ual/com/log.h"
+#include "ual/com/convert.hpp"
 #include "ual/args/conv_args.h"
+#include "ual/host/conv_forward.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/conv_forward/find_conv_forward.h"
 
 using tecoal::ual::args::ConvFwdArgs;
 using tecoal::ual::args::ConvFwdPatchArgs;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -49,6 +52,14 @@ struct ConvFType {
     using RetType = void;
     using PImplType = void (*)(ArgsType);
     using AlgoType = ConvType;
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, x), offsetof(ArgsType, w), offsetof(ArgsType, y),
+            offsetof(ArgsType, workSpace)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ConvFType::PImplType ConvFwdAlgos[] = {
@@ -90,6 +101,22 @@ struct ConvFwdOp : public BaseOp<ConvFwdOp, ConvFType> {
 
     static const char *name() { return "Conv forward"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "N=%d C=%d H=%d W=%d M=%d R=%d S=%d E=%d F=%d", arg->N, arg->C,
+                 arg->H, arg->W, arg->M, arg->R, arg->S, arg->E, arg->F);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t x = (uint64_t)arg->N * arg->H * arg->W * arg->C;
+        uint64_t w = (uint64_t)arg->M * arg->R * arg->S * arg->C;
+        uint64_t y = (uint64_t)arg->N * arg->E * arg->F * arg->M;
+        uint64_t y_size = convertDataTypeSize(arg->out_data_type);
+        // x and w are half precision in every kernel variant
+        cost->bytes_read = (x + w) * 2 + (arg->beta != 0 ? y * y_size : 0);
+        cost->bytes_written = y * y_size;
+        cost->flops = 2 * y * arg->C * arg->R * arg->S;
+    }
+
     Status getWorkspace(const PatchType *args, size_t *size) {
         *size = findConvForwardWorkspace(args);
         return Status::SUCCESS;
@@ -101,9 +128,19 @@ struct ConvFwdOp : public BaseOp<ConvFwdOp, ConvFType> {
             ERROR("conv_forward branch is not exit!");
             return Status::NOT_IMPLEMENTED;
         }
-        setInstance(ConvFwdAlgos[index], convFwdDiscription[index]);
+        setInstance(ConvFwdAlgos[index], convFwdDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->x_data_type == UALDataType::UAL_DTYPE_HALF &&
+            args->w_data_type == UALDataType::UAL_DTYPE_HALF &&
+            args->y_data_type == UALDataType::UAL_DTYPE_HALF) {
+            setInstance(tecoHostConvFwdFT16, "tecoHostConvFwdFT16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -26,6 +26,9 @@
 
 #include "ual/ops/conv_forward/find_conv_forward.h"
 #include "ual/com/convert.hpp"
+#include "ual/com/log.h"
+#include "ual/ops/cost_model.h"
+#include "ual/ops/tuning_db.h"
 
 using namespace tecoal::ual::common;
 using tecoal::ual::args::ConvFwdArgs;
@@ -34,59 +37,132 @@ namespace tecoal {
 namespace ual {
 namespace ops {
 
-#define DB_MAX_USED_SPM_SIZE 225280  // 220K for double buffer
-#define FLOAT16_BYTE_SIZE 2
-#define MOD32(a) (((size_t)(a)&31) == 0)
+#define CONV_FWD_ALGO_NUM 7  // entries of ConvFwdAlgos
+// tiles of the matmul kernels: output pixels x output channels, input channels per step
+#define CONV_FWD_BEF 128
+#define CONV_FWD_BM 32
+#define CONV_FWD_BC 32
 
 size_t findConvForwardWorkspace(const ConvFwdPatchArgs *arg) { return 0; }
 
-int findConvForwardBranch(const ConvFwdPatchArgs *arg) {
-    const int N = arg->convf->N;
-    const int C = arg->convf->C;
-    const int H = arg->convf->H;
-    const int W = arg->convf->W;
-    const int E = arg->convf->E;
-    const int F = arg->convf->F;
-    const int M = arg->convf->M;
-    const int R = arg->convf->R;
-    const int S = arg->convf->S;
-    const int PH = arg->convf->pad_h;
-    const int PW = arg->convf->pad_w;
-    const int SH = arg->convf->stride_h;
-    const int SW = arg->convf->stride_w;
-    const int DH = arg->convf->dilation_h;
-    const int DW = arg->convf->dilation_w;
-    const int spe_num = arg->convf->spe_num;
-
-    const int size_y =
-        N * E * F * M *
-        (arg->y_data_type == UALDataType::UAL_DTYPE_FLOAT ? sizeof(float) : FLOAT16_BYTE_SIZE);
-
-    // Convert the algorithm type to its corresponding index.
-    int algo = common::convertAlgoToIndex(arg->algo);
-
-    // Check if the data types for input, weights, and output tensors are all half precision
-    // floating points (FP16).
-    if (arg->x_data_type == UALDataType::UAL_DTYPE_HALF &&
-        arg->w_data_type == UALDataType::UAL_DTYPE_HALF &&
-        arg->y_data_type == UALDataType::UAL_DTYPE_HALF) {
-        // Check for specific conditions where optimizations can be applied:
-        // 1. N, C, and M are all multiples of 32.
-        // 2. The kernel size is 1x1 (R=1, S=1).
-        // 3. There's no padding (PH=0, PW=0), and the stride is 1x1 (SH=1, SW=1).
-        // 4. The dilation is 1x1 (DH=1, DW=1).
-        if (MOD32(C) && MOD32(M) && R == 1 && S == 1 && PH == 0 && PW == 0 && SH == 1 && SW == 1 &&
-            DH == 1 && DW == 1) {
-            // Calculate if the memory required fits within the SPM limits.
-            if ((H * W * C + C * R * S * M + E * F * M * 2) * FLOAT16_BYTE_SIZE <
-                DB_MAX_USED_SPM_SIZE) {
-                // If all conditions are met return the algorithm index for execution.
-                return algo;
+uint64_t getConvForwardTuningKey(const ConvFwdPatchArgs *arg) {
+    const ConvFwdArgs *convf = arg->convf;
+    TuningKey key("conv_forward");
+    key.add(arg->x_data_type);
+    key.add(arg->w_data_type);
+    key.add(arg->y_data_type);
+    key.add(convf->N);
+    key.add(convf->C);
+    key.add(convf->H);
+    key.add(convf->W);
+    key.add(convf->M);
+    key.add(convf->R);
+    key.add(convf->S);
+    key.add(convf->E);
+    key.add(convf->F);
+    key.add(convf->pad_h);
+    key.add(convf->pad_w);
+    key.add(convf->stride_h);
+    key.add(convf->stride_w);
+    key.add(convf->dilation_h);
+    key.add(convf->dilation_w);
+    return key.value();
+}
+
+static inline bool isPointwise(const ConvFwdArgs *c) {
+    return c->R == 1 && c->S == 1 && c->pad_h == 0 && c->pad_w == 0 && c->stride_h == 1 &&
+           c->stride_w == 1 && c->dilation_h == 1 && c->dilation_w == 1;
+}
+
+// Shape rules of each kernel in convolution_forward_ft16.scpp; the SPM budget is checked by
+// the cost model. Algos 0 to 2 run any convolution, 3 to 6 only 1x1 ones.
+static bool checkConvForwardAlgo(int algo, const ConvFwdArgs *c) {
+    if (algo <= 2) return true;
+    if (!isPointwise(c) || c->C % CONV_FWD_BC != 0) return false;
+    if (algo == 3) return true;
+    return c->M % CONV_FWD_BM == 0 && (c->E * c->F) % CONV_FWD_BEF == 0;
+}
+
+// Per-SPE work of algo on the busiest SPE, which gets ceil(N / spe_num) images.
+static KernelCost getConvForwardCost(int algo, const ConvFwdArgs *c) {
+    const uint64_t EFM = (uint64_t)c->E * c->F * c->M;
+    const uint64_t x_bytes = (uint64_t)c->H * c->W * c->C * sizeof(uint16_t);
+    const uint64_t w_bytes = (uint64_t)c->C * c->R * c->S * c->M * sizeof(uint16_t);
+    const uint64_t y_bytes = EFM * sizeof(uint16_t);
+    const uint64_t macs = EFM * c->R * c->S * c->C;
+    const uint64_t images = algo == 0 ? c->N : (c->N + c->spe_num - 1) / c->spe_num;
+
+    KernelCost cost = {};
+    cost.flops = images * 2 * macs;
+    switch (algo) {
+        case 0:
+        case 1:
+            cost.global_accesses = images * (2 * macs + EFM);
+            cost.unit = ComputeUnit::SCALAR;
+            break;
+        case 2:
+        case 3:
+            cost.spm_bytes = x_bytes + w_bytes + y_bytes;
+            cost.dma_bytes = w_bytes + images * (x_bytes + y_bytes);
+            cost.dma_transfers = 1 + 2 * images;
+            cost.unit = algo == 2 ? ComputeUnit::SCALAR : ComputeUnit::SIMD;
+            // the SIMD kernel sums the 16 lanes of every output one by one
+            if (algo == 3) cost.scalar_ops = images * EFM * 16;
+            break;
+        default: {
+            const uint64_t w_rows = (c->C / CONV_FWD_BC) * (c->M / CONV_FWD_BM);
+            // the weights are broadcast once to all SPEs by algos 5 and 6
+            cost.spm_bytes = (algo == 6 ? 2 : 1) * x_bytes + w_bytes + 2 * y_bytes;
+            cost.dma_bytes = (algo == 4 ? w_bytes : w_bytes / c->spe_num) +
+                             images * (x_bytes + y_bytes);
+            cost.dma_transfers = w_rows + 2 * images;
+            // y is regrouped one 32-channel row at a time unless M is a single block
+            if (c->M != CONV_FWD_BM) {
+                cost.spm_copies = images * EFM / CONV_FWD_BM;
+                cost.spm_copy_bytes = images * y_bytes;
             }
+            cost.unit = ComputeUnit::MATMUL;
+            cost.overlapped = algo == 6;
+            break;
         }
     }
+    return cost;
+}
 
-    return -1;
+// Ranks every legal algo with the static cost model. An explicit algo is returned only when it
+// is legal; a tuned record wins whenever it is still legal.
+int findConvForwardBranch(const ConvFwdPatchArgs *arg) {
+    const ConvFwdArgs *convf = arg->convf;
+
+    // Every kernel reads and writes half data.
+    if (arg->x_data_type != UALDataType::UAL_DTYPE_HALF ||
+        arg->w_data_type != UALDataType::UAL_DTYPE_HALF ||
+        arg->y_data_type != UALDataType::UAL_DTYPE_HALF) {
+        return -1;
+    }
+
+    int first = 0, last = CONV_FWD_ALGO_NUM - 1;
+    if (arg->algo != UALAlgoType::UAL_ALGO_BEST) {
+        first = last = common::convertAlgoToIndex(arg->algo);
+        if (first < 0 || first >= CONV_FWD_ALGO_NUM) return -1;
+    }
+
+    TuningRecord record;
+    if (TuningDatabase::instance().lookup(getConvForwardTuningKey(arg), &record) &&
+        record.algo >= first && record.algo <= last &&
+        checkConvForwardAlgo(record.algo, convf) &&
+        fitsSpm(getConvForwardCost(record.algo, convf))) {
+        return record.algo;
+    }
+
+    CostRanker ranker("conv_forward");
+    for (int algo = first; algo <= last; ++algo) {
+        if (checkConvForwardAlgo(algo, convf)) ranker.offer(algo, getConvForwardCost(algo, convf));
+    }
+    if (ranker.best() >= 0) {
+        DLOG("conv_forward picks algo %d, %.2f us estimated", ranker.best(), ranker.bestUs());
+    }
+    return ranker.best();
 }
 
 }  // namespace ops
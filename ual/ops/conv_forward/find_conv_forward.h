@@ -27,6 +27,7 @@
 #ifndef UAL_OPS_CONV_FORWARD_FIND_CONV_FORWARD_H_
 #define UAL_OPS_CONV_FORWARD_FIND_CONV_FORWARD_H_
 
+#include <stdint.h>
 #include "ual/args/conv_args.h"
 
 using tecoal::ual::args::ConvFwdPatchArgs;
@@ -36,6 +37,7 @@ namespace ual {
 namespace ops {
 
 size_t findConvForwardWorkspace(const ConvFwdPatchArgs *arg);
+uint64_t getConvForwardTuningKey(const ConvFwdPatchArgs *arg);
 int findConvForwardBranch(const ConvFwdPatchArgs *arg);
 
 }  // namespace ops
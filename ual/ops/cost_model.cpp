@@ -0,0 +1,77 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/ops/cost_model.h"
+#include <algorithm>
+#include "ual/com/log.h"
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+using common::SpeCost;
+
+static const SpeCost spe_cost;
+
+bool fitsSpm(const KernelCost &cost) { return cost.spm_bytes < SPE_SPM_BYTES; }
+
+double arithmeticIntensity(const KernelCost &cost) {
+    uint64_t bytes = cost.dma_bytes + cost.global_accesses * sizeof(uint16_t);
+    return bytes == 0 ? 0 : (double)cost.flops / bytes;
+}
+
+double estimateUs(const KernelCost &cost) {
+    const SpeCost &c = spe_cost;
+    double bandwidth = std::min(c.dma_bytes, c.global_bytes / SPE_NUM);
+    double dma = cost.dma_transfers * c.dma_latency + cost.dma_bytes / bandwidth +
+                 cost.spm_copies * c.noc_latency + (double)cost.spm_copy_bytes / c.noc_bytes;
+    double compute = 0;
+    switch (cost.unit) {
+        case ComputeUnit::SCALAR: compute = cost.flops / 2.0 * c.scalar_cycles; break;
+        case ComputeUnit::SIMD: compute = cost.flops / 32.0 * c.simd_cycles; break;
+        // a row through the unit is 32x32 multiply-adds
+        case ComputeUnit::MATMUL: compute = cost.flops / 2048.0 * c.matmul_row_cycles; break;
+    }
+    compute += cost.scalar_ops * c.scalar_cycles;
+    double cycles = cost.overlapped ? std::max(dma, compute) : dma + compute;
+    cycles += cost.global_accesses * c.global_access_cycles;
+    return cycles / (c.clock_ghz * 1e3);
+}
+
+void CostRanker::offer(int id, const KernelCost &cost) {
+    if (!fitsSpm(cost)) return;
+    double us = estimateUs(cost);
+    DLOG("%s candidate %d: spm %zu dma %llu intensity %.2f estimate %.2f us", op_, id,
+         cost.spm_bytes, (unsigned long long)cost.dma_bytes, arithmeticIntensity(cost), us);
+    if (best_ < 0 || us < best_us_) {
+        best_ = id;
+        best_us_ = us;
+    }
+}
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
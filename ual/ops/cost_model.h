@@ -0,0 +1,79 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_COST_MODEL_H_
+#define UAL_OPS_COST_MODEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ual/com/spe_cost.h"
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+enum class ComputeUnit { SCALAR, SIMD, MATMUL };
+
+// What one candidate kernel does on its busiest SPE for one launch, as the op's find code
+// derives it from the args and the candidate's tiling.
+typedef struct KernelCost {
+    size_t spm_bytes;          // peak SPM footprint
+    uint64_t dma_bytes;        // global memory traffic through the DMA engine
+    uint64_t dma_transfers;    // each one pays the DMA latency
+    uint64_t global_accesses;  // scalar loads and stores straight to global memory
+    uint64_t spm_copies;       // SPM to SPM memcpys, paying the on-chip latency
+    uint64_t spm_copy_bytes;
+    uint64_t flops;
+    uint64_t scalar_ops;  // scalar work beside the flops: transposes, lane reductions
+    ComputeUnit unit;
+    bool overlapped;  // DMA is double buffered under the compute
+} KernelCost;
+
+bool fitsSpm(const KernelCost &cost);
+// flops per byte moved from global memory
+double arithmeticIntensity(const KernelCost &cost);
+double estimateUs(const KernelCost &cost);
+
+// Keeps the cheapest of the candidates offered to it; those over the SPM budget are dropped.
+class CostRanker {
+ public:
+    explicit CostRanker(const char *op) : op_(op) {}
+
+    void offer(int id, const KernelCost &cost);
+    int best() const { return best_; }  // -1 when nothing fit
+    double bestUs() const { return best_us_; }
+
+ private:
+    const char *op_;
+    int best_ = -1;
+    double best_us_ = 0;
+};
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_COST_MODEL_H_
@@ -25,7 +25,12 @@
 // OF SUCH DAMAGE.
 
 #include "ual/ops/gemm/find_gemm.h"
+#include <math.h>
+#include <vector>
 #include "ual/com/convert.hpp"
+#include "ual/com/log.h"
+#include "ual/ops/cost_model.h"
+#include "ual/ops/tuning_db.h"
 
 using tecoal::ual::args::GEMMArgs;
 using tecoal::ual::args::GEMMPatchArgs;
@@ -34,148 +39,213 @@ namespace tecoal {
 namespace ual {
 namespace ops {
 
-#define MaxM 256     // 64*4
-#define MinM 32      // 8*4
-#define MaxK 2048    // 256*8
-#define MinK 128     // 16*8
-#define TA_MinM 64   // 16*4
-#define TB_MaxM 128  // 32*4
-
-#define MaxHM 512      // 128*4
-#define MinHM 64       // 16*4
-#define TAB_MinHM 256  // 64*4
-#define TA_MinHM 256   // 32*2*4
-#define MaxHK 256      // 256*8
-#define MinHK 32       // 32*8
-#define MaxHN 512      // 64*8
-#define MinHN 256      // 32*8
-
-#define MaxQM 512     // 128*4
-#define MinQM 64      // 16*4
-#define TA_MinQM 128  // 32*4
-#define TB_MinQM 128  // 32*4
-#define MaxQK 256     // 256*8
-#define MinQK 64      // 32*8
-#define MaxQN 512     // 64*8
-#define MinQN 256     // 32*8
-#define TA_MinQN 512  // 64*8
-#define TB_MinQN 512  // 64*8
-
-struct PaddingData {
+#define GEMM_ALGO_NUM 7  // entries of GEMMAlgos
+
+// The tiled kernels split a bM x bN tile of C over an 8 x 4 SPE grid, each SPE owning a
+// bM/8 x bN/4 piece and stepping through K in bK chunks.
+#define GEMM_GRID_M 8
+#define GEMM_GRID_N 4
+#define GEMM_BM_STEP 64  // keeps bM/8 a multiple of 8
+#define GEMM_BM_MAX 512
+#define GEMM_BK_STEP 32  // the matmul unit and the SIMD dot products take K in 32s
+#define GEMM_BK_MAX 256
+#define GEMM_MATMUL_BM 256  // 32 input rows per SPE for the matmul unit
+#define GEMM_MATMUL_BN 256  // two 32-column weight loads per SPE
+
+typedef struct GEMMTile {
     int bM;
     int bN;
     int bK;
-    int Mend;
-    int Nend;
-    int Kend;
-    bool compa;
-    bool compb;
-    bool compc;
-};
-
-static inline void getGEMMBlockHgemmN512(const int M, const int N, const int K, const int maxM,
-                                         const int minM, const int maxN, const int minN,
-                                         const int maxK, const int minK, int *bM, int *bN,
-                                         int *bK) {
-    int im, ik, in;
-    for (ik = maxK; ik > minK; ik -= minK) {
-        if (K % ik == 0) break;
-    }
-    *bK = ik;
+} GEMMTile;
+
+static inline bool isTransposed(UALOperation op) { return op != UALOperation::UAL_OP_N; }
+
+static inline bool isDense(const GEMMArgs *g) {
+    return g->lda == (isTransposed(g->transa) ? g->m : g->k) &&
+           g->ldb == (isTransposed(g->transb) ? g->k : g->n) && g->ldc == g->n;
+}
+
+static inline bool isHalfGemm(const GEMMArgs *g) {
+    return g->Atype == UALDataType::UAL_DTYPE_HALF && g->Btype == UALDataType::UAL_DTYPE_HALF &&
+           (g->Ctype == UALDataType::UAL_DTYPE_HALF || g->Ctype == UALDataType::UAL_DTYPE_FLOAT);
+}
+
+// float or bfloat16 A and B, float C
+static inline bool isWideGemm(const GEMMArgs *g) {
+    return (g->Atype == UALDataType::UAL_DTYPE_FLOAT ||
+            g->Atype == UALDataType::UAL_DTYPE_BFLOAT16) &&
+           g->Btype == g->Atype && g->Ctype == UALDataType::UAL_DTYPE_FLOAT;
+}
 
-    for (in = maxN; in > minN; in -= minN) {
-        if (N % in == 0) break;
+// Shape rules of each kernel; the SPM budget is checked by the cost model.
+static bool checkGEMMTile(int algo, const GEMMArgs *g, const GEMMTile &t) {
+    if (algo == 0) return true;  // one SPE reading global memory directly, any shape
+    if (!isHalfGemm(g)) return false;
+    if (!isDense(g)) return false;
+    if (t.bM <= 0 || t.bN <= 0 || t.bK <= 0) return false;
+    if (g->m % t.bM != 0 || g->n % t.bN != 0 || g->k % t.bK != 0) return false;
+    if (t.bM % GEMM_BM_STEP != 0 || t.bN % (GEMM_GRID_N * 16) != 0) return false;
+    if (algo >= 2 && t.bK % GEMM_BK_STEP != 0) return false;
+    if (algo >= 4 && (t.bM % GEMM_MATMUL_BM != 0 || t.bN != GEMM_MATMUL_BN)) return false;
+    // the matmul unit kernels load A rows and B rows as they are, without a transposed path
+    if (algo >= 4 && (isTransposed(g->transa) || isTransposed(g->transb))) return false;
+    return true;
+}
+
+// Per-SPE work of running algo with tile t, from the buffers and loops of gemm_ft16.scpp.
+static KernelCost getGEMMCost(int algo, const GEMMArgs *g, const GEMMTile &t) {
+    const uint64_t M = g->m, N = g->n, K = g->k, batch = g->batch > 0 ? g->batch : 1;
+    const uint64_t c_size = convertDataTypeSize(g->Ctype);
+    KernelCost cost = {};
+    if (algo == 0) {
+        // a batch is dealt out whole matrices per SPE, the busiest SPE sets the time
+        const uint64_t spe_num = GEMM_GRID_M * GEMM_GRID_N;
+        const uint64_t per_spe = batch == 1 ? 1 : (batch + spe_num - 1) / spe_num;
+        cost.global_accesses = per_spe * (2 * M * N * K + M * N);
+        cost.flops = per_spe * 2 * M * N * K;
+        cost.unit = ComputeUnit::SCALAR;
+        return cost;
     }
-    *bN = in;
 
-    for (im = maxM; im > minM; im -= minM) {
-        if (M % im == 0) break;
+    const uint64_t LM = t.bM / GEMM_GRID_M, LN = t.bN / GEMM_GRID_N, LK = t.bK;
+    const uint64_t tiles = batch * (M / t.bM) * (N / t.bN), steps = K / t.bK;
+    const uint64_t len_a = LM * LK * sizeof(uint16_t);
+    const uint64_t len_b = LK * LN * sizeof(uint16_t);
+    const uint64_t len_c = LM * LN * c_size;
+    const uint64_t acc = LM * LN * sizeof(float);
+
+    cost.flops = tiles * 2 * LM * LN * K;
+    cost.dma_bytes = tiles * (steps * (len_a + len_b) + len_c);
+    cost.dma_transfers = tiles * (2 * steps + 1);
+    switch (algo) {
+        case 1:
+            cost.spm_bytes = acc;
+            cost.global_accesses = tiles * (2 * LM * LN * K + LM * LN);
+            cost.dma_bytes = 0;
+            cost.dma_transfers = 0;
+            cost.unit = ComputeUnit::SCALAR;
+            break;
+        case 2:
+            cost.spm_bytes = len_a + len_b + len_c + acc;
+            cost.unit = ComputeUnit::SCALAR;
+            break;
+        case 3:
+            cost.spm_bytes = len_a + 2 * len_b + len_c + 2 * LK * sizeof(float) + acc;
+            // the dot products want K contiguous: B normal and A transposed are transposed in
+            // SPM element by element
+            if (isTransposed(g->transa)) {
+                cost.spm_bytes += len_a;
+                cost.scalar_ops += tiles * steps * LM * LK;
+            }
+            if (!isTransposed(g->transb)) cost.scalar_ops += tiles * steps * LK * LN;
+            cost.unit = ComputeUnit::SIMD;
+            break;
+        default:
+            cost.spm_bytes = 2 * len_a + 3 * len_b + len_c + len_c / sizeof(uint16_t) * 8;
+            cost.unit = ComputeUnit::MATMUL;
+            // A is broadcast along the 4 SPEs of a grid column, B along the 8 of a row
+            if (algo >= 5) cost.dma_bytes = tiles * (steps * (len_a / 4 + len_b / 8) + len_c);
+            cost.overlapped = algo == 6;
+            break;
     }
-    *bM = im;
-    if (*bN == 512 && *bM > 256) *bM = 256;  // 64*4
+    return cost;
 }
 
-static inline PaddingData paddingStrategy(const GEMMPatchArgs *arg) {
-    const GEMMArgs *gemmArgs = arg->gemm_args;
-    int bM, bN, bK;
-    int M = gemmArgs->m;
-    int N = gemmArgs->n;
-    int K = gemmArgs->k;
-    int lda = gemmArgs->lda;
-    int ldb = gemmArgs->ldb;
-    int ldc = gemmArgs->ldc;
-
-    getGEMMBlockHgemmN512(M, N, K, MaxHM, MinHM, MaxHN, MinHN, MaxHK, MinHK, &bM, &bN, &bK);
-
-    if (bM < 256) bM = 256;
-    int Mend = ((M + bM - 1) / bM) * bM;
-    int Nend = ((N + bN - 1) / bN) * bN;
-    int Kend = ((K + bK - 1) / bK) * bK;
-
-    int flag_M = (Mend > M);
-    int flag_N = (Nend > N) || (ldb > N) || (ldc > N);
-    int flag_K = (Kend > K) || (lda > K);
-
-    bool compa = flag_M || flag_K;
-    bool compb = flag_K || flag_N;
-    bool compc = flag_M || flag_N;
-
-    return {bM, bN, bK, Mend, Nend, Kend, compa, compb, compc};
+static void offerGEMMTiles(int algo, const GEMMArgs *g, CostRanker *ranker,
+                           std::vector<GEMMTile> *tiles) {
+    const int bn_list[] = {64, 128, 256, 512};
+    if (algo == 0) {
+        GEMMTile t = {g->m, g->n, g->k};
+        if (checkGEMMTile(algo, g, t)) {
+            ranker->offer(tiles->size(), getGEMMCost(algo, g, t));
+            tiles->push_back(t);
+        }
+        return;
+    }
+    for (int bM = GEMM_BM_STEP; bM <= GEMM_BM_MAX; bM += GEMM_BM_STEP) {
+        for (int bN : bn_list) {
+            for (int bK = GEMM_BK_STEP; bK <= GEMM_BK_MAX; bK += GEMM_BK_STEP) {
+                GEMMTile t = {bM, bN, bK};
+                if (!checkGEMMTile(algo, g, t)) continue;
+                ranker->offer(tiles->size(), getGEMMCost(algo, g, t));
+                tiles->push_back(t);
+            }
+        }
+    }
 }
 
 size_t findGEMMWorksapceSize(const GEMMPatchArgs *arg) { return 0; }
 
-// Define a function to find the best GEMM branch based on given arguments.
+uint64_t getGEMMTuningKey(const GEMMPatchArgs *arg) {
+    const GEMMArgs *gemmArgs = arg->gemm_args;
+    TuningKey key("gemm");
+    key.add(arg->transa);
+    key.add(arg->transb);
+    key.add(gemmArgs->Atype);
+    key.add(gemmArgs->Btype);
+    key.add(gemmArgs->Ctype);
+    key.add(gemmArgs->m);
+    key.add(gemmArgs->n);
+    key.add(gemmArgs->k);
+    key.add(gemmArgs->lda);
+    key.add(gemmArgs->ldb);
+    key.add(gemmArgs->ldc);
+    // batched problems keep apart from single ones; records of single ones keep their keys
+    if (gemmArgs->batch > 1) key.add(gemmArgs->batch);
+    return key.value();
+}
+
+// Ranks every legal (algo, tile) pair of the kernels with the static cost model. An explicit
+// algo only ranks its own tiles; a tuned record wins whenever it is still legal.
 int findGEMMBranch(const GEMMPatchArgs *arg) {
-    // Determine padding requirements for the operation.
-    PaddingData pad = paddingStrategy(arg);
+    GEMMArgs *gemmArgs = arg->gemm_args;
 
-    // Convert the algorithm type from the arguments to an index for internal use.
-    int algo = common::convertAlgoToIndex(arg->algo);
+    // The kernels compute C = op(A) * op(B) on half A and B with half or float C, algo 0 also on
+    // float or bfloat16 A and B with float C; alpha and beta are not applied.
+    if (!isHalfGemm(gemmArgs) && !isWideGemm(gemmArgs)) return -1;
+    if (fabs(gemmArgs->alpha - 1) > 1e-6 || fabs(gemmArgs->beta) > 1e-6) return -1;
 
-    // Extract transpose operations for matrices A and B from the arguments.
-    UALOperation transa = arg->transa;
-    UALOperation transb = arg->transb;
+    int first = 0, last = GEMM_ALGO_NUM - 1;
+    if (arg->algo != UALAlgoType::UAL_ALGO_BEST) {
+        first = last = common::convertAlgoToIndex(arg->algo);
+        if (first < 0 || first >= GEMM_ALGO_NUM) return -1;
+    }
 
-    // Pointer to the GEMM operation arguments.
-    const GEMMArgs *gemmArgs = arg->gemm_args;
+    TuningRecord record;
+    if (TuningDatabase::instance().lookup(getGEMMTuningKey(arg), &record) &&
+        record.algo >= first && record.algo <= last) {
+        GEMMTile t = {record.bM, record.bN, record.bK};
+        if (checkGEMMTile(record.algo, gemmArgs, t) &&
+            fitsSpm(getGEMMCost(record.algo, gemmArgs, t))) {
+            gemmArgs->bM = t.bM;
+            gemmArgs->bN = t.bN;
+            gemmArgs->bK = t.bK;
+            return record.algo;
+        }
+    }
 
-    // Data types for matrices A, B, and C.
-    UALDataType Atype = gemmArgs->Atype;
-    UALDataType Btype = gemmArgs->Btype;
-    UALDataType Ctype = gemmArgs->Ctype;
-
-    // Scaling factors for the matrix multiplication and addition.
-    float alpha = gemmArgs->alpha;
-    float beta = gemmArgs->beta;
-
-    // Dimensions of the matrices involved in the GEMM operation.
-    int M = gemmArgs->m;
-    int N = gemmArgs->n;
-    int K = gemmArgs->k;
-
-    // Check if matrices A and B are of half-precision type and operations on A and B are not
-    // transposed.
-    if (Atype == UALDataType::UAL_DTYPE_HALF && Btype == UALDataType::UAL_DTYPE_HALF &&
-        transa == UALOperation::UAL_OP_N && transb == UALOperation::UAL_OP_N) {
-        // Further conditions for optimization: dimensions are multiples of 256 and scaling factors
-        // are close to default values (1 for alpha, 0 for beta).
-        if (M % 256 == 0 && N % 256 == 0 && K % 256 == 0 && fabs(alpha - 1) <= 1e-6 &&
-            fabs(beta) <= 1e-6) {
-            // Ensure no padding compensation is needed for matrices A, B, and C to use this
-            // optimization.
-            if (!pad.compa && !pad.compb && !pad.compc) {
-                // Update block dimensions based on padding strategy.
-                arg->gemm_args->bM = pad.bM;
-                arg->gemm_args->bN = pad.bN;
-                arg->gemm_args->bK = pad.bK;
-                // Return the algorithm index if all conditions are met for this optimized branch.
-                return algo;
-            }
+    int best_algo = -1;
+    GEMMTile best_tile = {0, 0, 0};
+    double best_us = 0;
+    for (int algo = first; algo <= last; ++algo) {
+        CostRanker ranker("gemm");
+        std::vector<GEMMTile> tiles;
+        offerGEMMTiles(algo, gemmArgs, &ranker, &tiles);
+        if (ranker.best() < 0) continue;
+        if (best_algo < 0 || ranker.bestUs() < best_us) {
+            best_algo = algo;
+            best_tile = tiles[ranker.best()];
+            best_us = ranker.bestUs();
         }
     }
-    // Return -1 if no suitable optimized branch was found for the GEMM operation.
-    return -1;
+    if (best_algo < 0) return -1;
+
+    DLOG("gemm m=%d n=%d k=%d picks algo %d tile %dx%dx%d, %.2f us estimated", gemmArgs->m,
+         gemmArgs->n, gemmArgs->k, best_algo, best_tile.bM, best_tile.bN, best_tile.bK, best_us);
+    gemmArgs->bM = best_tile.bM;
+    gemmArgs->bN = best_tile.bN;
+    gemmArgs->bK = best_tile.bK;
+    return best_algo;
 }
 
 }  // namespace ops
@@ -27,6 +27,7 @@
 #ifndef UAL_OPS_GEMM_FIND_GEMM_H_
 #define UAL_OPS_GEMM_FIND_GEMM_H_
 
+#include <stdint.h>
 #include "ual/args/gemm_args.h"
 
 using tecoal::ual::args::GEMMPatchArgs;
@@ -36,6 +37,7 @@ namespace ual {
 namespace ops {
 
 size_t findGEMMWorksapceSize(const GEMMPatchArgs *arg);
+uint64_t getGEMMTuningKey(const GEMMPatchArgs *arg);
 int findGEMMBranch(const GEMMPatchArgs *arg);
 
 }  // namespace ops
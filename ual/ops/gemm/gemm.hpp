@@ -29,8 +29,10 @@
 
 #include "ual/kernel/gemm/gemm.h"
 #include "ual/com/log.h"
+#include "ual/com/convert.hpp"
 #include "ual/args/gemm_args.h"
 #include "ual/com/def.h"
+#include "ual/host/gemm.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/gemm/find_gemm.h"
 
@@ -38,6 +40,7 @@ using tecoal::ual::args::GEMMArgs;
 using tecoal::ual::args::GEMMPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +51,14 @@ struct GEMMType {
     using PatchType = GEMMPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, A),      offsetof(ArgsType, B),
+                                         offsetof(ArgsType, C),      offsetof(ArgsType, Aarray),
+                                         offsetof(ArgsType, Barray), offsetof(ArgsType, Carray)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 // Array of pointers to different implementations of the GEMM operation,
@@ -93,15 +104,62 @@ struct GEMMOp : public BaseOp<GEMMOp, GEMMType> {
 
     static const char *name() { return "gemm"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "m=%d n=%d k=%d batch=%d", arg->m, arg->n, arg->k, arg->batch);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t m = arg->m, n = arg->n, k = arg->k, batch = arg->batch;
+        uint64_t c_size = convertDataTypeSize(arg->Ctype);
+        cost->bytes_read = batch * (m * k * convertDataTypeSize(arg->Atype) +
+                                    k * n * convertDataTypeSize(arg->Btype) +
+                                    (arg->beta != 0 ? m * n * c_size : 0));
+        cost->bytes_written = batch * m * n * c_size;
+        cost->flops = 2 * batch * m * n * k;
+    }
+
     Status findImpl(const PatchType *args) {
         int index = findGEMMBranch(args);
         if (index == -1) {
             ERROR("gemm branch is not exit!");
             return Status::NOT_IMPLEMENTED;
         }
-        setInstance(GEMMAlgos[index], GEMMDiscription[index]);
+        setInstance(GEMMAlgos[index], GEMMDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    // the host kernels fold transa/transb into their packing, any combination runs
+    Status findHostImpl(const PatchType *args) {
+        const GEMMArgs *gemm_args = args->gemm_args;
+        if (gemm_args->Atype == UALDataType::UAL_DTYPE_HALF &&
+            gemm_args->Btype == UALDataType::UAL_DTYPE_HALF &&
+            (gemm_args->Ctype == UALDataType::UAL_DTYPE_HALF ||
+             gemm_args->Ctype == UALDataType::UAL_DTYPE_FLOAT)) {
+            setInstance(tecoHostGemmFT16, "tecoHostGemmFT16");
+            return Status::SUCCESS;
+        }
+        if (gemm_args->Atype == UALDataType::UAL_DTYPE_BFLOAT16 &&
+            gemm_args->Btype == UALDataType::UAL_DTYPE_BFLOAT16 &&
+            (gemm_args->Ctype == UALDataType::UAL_DTYPE_BFLOAT16 ||
+             gemm_args->Ctype == UALDataType::UAL_DTYPE_FLOAT)) {
+            setInstance(tecoHostGemmBF16, "tecoHostGemmBF16");
+            return Status::SUCCESS;
+        }
+        if (gemm_args->Atype == UALDataType::UAL_DTYPE_FLOAT &&
+            gemm_args->Btype == UALDataType::UAL_DTYPE_FLOAT &&
+            gemm_args->Ctype == UALDataType::UAL_DTYPE_FLOAT) {
+            setInstance(tecoHostGemmFT32, "tecoHostGemmFT32");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
+
+    // findGEMMBranch writes the block sizes into the kernel args
+    void restoreImpl(const ArgsType *cached, ArgsType *arg) {
+        arg->bM = cached->bM;
+        arg->bN = cached->bN;
+        arg->bK = cached->bK;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -0,0 +1,52 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/ops/gemm_grouped/find_gemm_grouped.h"
+#include "ual/com/convert.hpp"
+
+using tecoal::ual::args::GEMMGroupedArgs;
+using tecoal::ual::args::GEMMGroupedPatchArgs;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+// One kernel covers every group; half A and B, C half or float
+GEMMGroupedBranch findGEMMGroupedBranch(const GEMMGroupedPatchArgs *arg) {
+    const GEMMGroupedArgs *g = arg->args;
+    if (arg->algo != UALAlgoType::UAL_ALGO_0 && arg->algo != UALAlgoType::UAL_ALGO_BEST) {
+        return GEMMGroupedBranch::GEMM_GROUPED_END;
+    }
+    if (g->Atype == UALDataType::UAL_DTYPE_HALF && g->Btype == UALDataType::UAL_DTYPE_HALF &&
+        (g->Ctype == UALDataType::UAL_DTYPE_HALF || g->Ctype == UALDataType::UAL_DTYPE_FLOAT)) {
+        return GEMMGroupedBranch::GEMM_GROUPED_FT16;
+    }
+    return GEMMGroupedBranch::GEMM_GROUPED_END;
+}
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
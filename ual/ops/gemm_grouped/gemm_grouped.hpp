@@ -0,0 +1,145 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_GEMM_GROUPED_GEMM_GROUPED_HPP_
+#define UAL_OPS_GEMM_GROUPED_GEMM_GROUPED_HPP_
+
+#include "ual/kernel/gemm_grouped/gemm_grouped.h"
+#include "ual/com/log.h"
+#include "ual/com/convert.hpp"
+#include "ual/args/gemm_grouped_args.h"
+#include "ual/com/def.h"
+#include "ual/host/gemm.h"
+#include "ual/ops/base_op.hpp"
+#include "ual/ops/gemm_grouped/find_gemm_grouped.h"
+#include <algorithm>
+
+using tecoal::ual::args::GEMMGroupedArgs;
+using tecoal::ual::args::GEMMGroupedPatchArgs;
+using namespace tecoal::ual::common;
+using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+struct GEMMGroupedType {
+    using ArgsType = GEMMGroupedArgs;        // using implement kernel args
+    using PatchType = GEMMGroupedPatchArgs;  // using patch args
+    using RetType = void;
+    using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, A), offsetof(ArgsType, B),
+                                         offsetof(ArgsType, C)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
+};
+
+// indexed by GEMMGroupedBranch
+static GEMMGroupedType::PImplType GEMMGroupedAlgos[] = {
+    tecoKernelGemmGroupedFT16,
+    // more branches
+};
+
+static const char *GEMMGroupedDiscription[] = {
+    "tecoKernelGemmGroupedFT16",
+    // more branches
+};
+
+static GEMMGroupedType::PImplType GEMMGroupedHostAlgos[] = {
+    tecoHostGemmGroupedFT16,
+};
+
+static const char *GEMMGroupedHostDiscription[] = {
+    "tecoHostGemmGroupedFT16",
+};
+
+struct GEMMGroupedOp : public BaseOp<GEMMGroupedOp, GEMMGroupedType> {
+ public:
+    using ArgsType = typename GEMMGroupedType::ArgsType;    // using implement kernel args
+    using PatchType = typename GEMMGroupedType::PatchType;  // using dispatch args
+    using RetType = typename GEMMGroupedType::RetType;
+    using PImplType = typename GEMMGroupedType::PImplType;
+
+    static const char *name() { return "gemm_grouped"; }
+
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        long long m = 0;
+        int n = 0, k = 0;
+        for (int g = 0; g < arg->group_count; g++) {
+            m += arg->shapes[g].m;
+            n = std::max(n, arg->shapes[g].n);
+            k = std::max(k, arg->shapes[g].k);
+        }
+        snprintf(buf, size, "groups=%d sum_m=%lld max_n=%d max_k=%d", arg->group_count, m, n, k);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        const uint64_t a_size = convertDataTypeSize(arg->Atype);
+        const uint64_t b_size = convertDataTypeSize(arg->Btype);
+        const uint64_t c_size = convertDataTypeSize(arg->Ctype);
+        *cost = {0, 0, 0};
+        for (int g = 0; g < arg->group_count; g++) {
+            const uint64_t m = arg->shapes[g].m, n = arg->shapes[g].n, k = arg->shapes[g].k;
+            cost->bytes_read += m * k * a_size + k * n * b_size;
+            if (arg->beta != 0) cost->bytes_read += m * n * c_size;
+            cost->bytes_written += m * n * c_size;
+            cost->flops += 2 * m * n * k;
+        }
+    }
+
+    // A, B and C are the caller's pointer arrays advanced to the launch's first group
+    static size_t pointerOffsetImpl(const ArgsType *arg) {
+        return (size_t)arg->group_base * sizeof(void *);
+    }
+
+    Status findImpl(const PatchType *args) {
+        GEMMGroupedBranch branch = findGEMMGroupedBranch(args);
+        if (branch == GEMMGroupedBranch::GEMM_GROUPED_END) {
+            ERROR("gemm_grouped branch is not exit!");
+            return Status::NOT_IMPLEMENTED;
+        }
+        int index = static_cast<int>(branch);
+        setInstance(GEMMGroupedAlgos[index], GEMMGroupedDiscription[index], index);
+        return Status::SUCCESS;
+    }
+
+    Status findHostImpl(const PatchType *args) {
+        GEMMGroupedBranch branch = findGEMMGroupedBranch(args);
+        if (branch == GEMMGroupedBranch::GEMM_GROUPED_END) return Status::NOT_SUPPORTED;
+        int index = static_cast<int>(branch);
+        setInstance(GEMMGroupedHostAlgos[index], GEMMGroupedHostDiscription[index]);
+        return Status::SUCCESS;
+    }
+};
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_GEMM_GROUPED_GEMM_GROUPED_HPP_
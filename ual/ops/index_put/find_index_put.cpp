@@ -36,13 +36,12 @@ namespace ops {
 
 // Define a function to determine the best algorithm branch based on given arguments.
 IndexPutBranch findIndexPutBranch(const IndexPutPatchArgs *arg) {
+    // broadcast indices and values are read through index_plan and value_plan
     if (!arg->arg->is_bool_index) {
-        if (!arg->arg->broadcast) {
-            if (arg->data_type == UALDataType::UAL_DTYPE_HALF &&
-                arg->index_data_type == UALDataType::UAL_DTYPE_INT64) {
-                if (arg->algo == UALAlgoType::UAL_ALGO_0) {
-                    return IndexPutBranch::INDEX_PUT_INT64;
-                }
+        if (arg->data_type == UALDataType::UAL_DTYPE_HALF &&
+            arg->index_data_type == UALDataType::UAL_DTYPE_INT64) {
+            if (common::isDefaultAlgo(arg->algo)) {
+                return IndexPutBranch::INDEX_PUT_INT64;
             }
         }
     }
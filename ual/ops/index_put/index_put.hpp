@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/index_put_args.h"
 #include "ual/com/def.h"
+#include "ual/host/index_put.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/index_put/find_index_put.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::IndexPutArgs;
 using tecoal::ual::args::IndexPutPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,14 @@ struct IndexPutType {
     using PatchType = IndexPutPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, indices), offsetof(ArgsType, input), offsetof(ArgsType, value),
+            offsetof(ArgsType, output)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static IndexPutType::PImplType IndexPutAlgos[] = {
@@ -69,6 +79,19 @@ struct IndexPutOp : public BaseOp<IndexPutOp, IndexPutType> {
 
     static const char *name() { return "index_put"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        formatShapeDims(buf, size, arg->dim_output, arg->dim_ln);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // values are read and scattered into output; the index tensors are not counted
+        uint64_t n = 1;
+        for (int i = 0; i < arg->dim_ln_value; i++) n *= arg->dim_value[i];
+        cost->bytes_read = n * arg->sz_type * (arg->accumulate ? 2 : 1);
+        cost->bytes_written = n * arg->sz_type;
+        cost->flops = arg->accumulate ? n : 0;
+    }
+
     Status findImpl(const PatchType *args) {
         IndexPutBranch branch = findIndexPutBranch(args);
         if (branch == IndexPutBranch::INDEX_PUT_END) {
@@ -76,9 +99,18 @@ struct IndexPutOp : public BaseOp<IndexPutOp, IndexPutType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(IndexPutAlgos[index], IndexPutDiscription[index]);
+        setInstance(IndexPutAlgos[index], IndexPutDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (!args->arg->is_bool_index && args->data_type == UALDataType::UAL_DTYPE_HALF &&
+            args->index_data_type == UALDataType::UAL_DTYPE_INT64) {
+            setInstance(tecoHostIndexPutInt64Indices, "tecoHostIndexPutInt64Indices");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -37,7 +37,7 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 LogicalNotTensorBranch findLogicalNotTensorBranch(const LogicalNotTensorPatchArgs *arg) {
     if (arg->data_type == UALDataType::UAL_DTYPE_BOOL) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return LogicalNotTensorBranch::LOGICAL_NOT_TENSOR_BOOL;
         }
     }
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/logical_not_tensor_args.h"
 #include "ual/com/def.h"
+#include "ual/host/logical_not_tensor.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/logical_not_tensor/find_logical_not_tensor.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::LogicalNotTensorArgs;
 using tecoal::ual::args::LogicalNotTensorPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,12 @@ struct LogicalNotTensorType {
     using PatchType = LogicalNotTensorPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, A), offsetof(ArgsType, C)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static LogicalNotTensorType::PImplType LogicalNotTensorAlgos[] = {
@@ -69,6 +77,15 @@ struct LogicalNotTensorOp : public BaseOp<LogicalNotTensorOp, LogicalNotTensorTy
 
     static const char *name() { return "logical_not_tensor"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "rows=%d n=%d", arg->row_num, arg->A_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t n = (uint64_t)arg->row_num * arg->A_num;
+        *cost = {n, n, n};
+    }
+
     Status findImpl(const PatchType *args) {
         LogicalNotTensorBranch branch = findLogicalNotTensorBranch(args);
         if (branch == LogicalNotTensorBranch::LOGICAL_NOT_TENSOR_END) {
@@ -76,9 +93,17 @@ struct LogicalNotTensorOp : public BaseOp<LogicalNotTensorOp, LogicalNotTensorTy
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(LogicalNotTensorAlgos[index], LogicalNotTensorDiscription[index]);
+        setInstance(LogicalNotTensorAlgos[index], LogicalNotTensorDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_BOOL) {
+            setInstance(tecoHostLogicalNotTensorBool, "tecoHostLogicalNotTensorBool");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -36,8 +36,10 @@ namespace ops {
 
 MaskedFillBranch findMaskedFillBranch(const MaskedFillPatchArgs *arg) {
     if (arg->data_type == (UALDataType::UAL_DTYPE_FLOAT)) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
-            return MaskedFillBranch::MASKED_FILL_FLOAT;
+        if (common::isDefaultAlgo(arg->algo)) {
+            // row_num is 0 when the operands do not reduce to unit-stride rows
+            if (arg->args->row_num > 0) return MaskedFillBranch::MASKED_FILL_FLOAT;
+            return MaskedFillBranch::MASKED_FILL_FLOAT_BROADCAST;
         }
     }
 
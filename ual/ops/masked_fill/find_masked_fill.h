@@ -37,6 +37,7 @@ namespace ops {
 
 typedef enum class MaskedFillBranch {
     MASKED_FILL_FLOAT = 0,
+    MASKED_FILL_FLOAT_BROADCAST = 1,
     // insert enum
     MASKED_FILL_END
 } MaskedFillBranch;
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/masked_fill_args.h"
 #include "ual/com/def.h"
+#include "ual/host/masked_fill.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/masked_fill/find_masked_fill.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::MaskedFillArgs;
 using tecoal::ual::args::MaskedFillPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,15 +50,24 @@ struct MaskedFillType {
     using PatchType = MaskedFillPatchArgs;  // using dispatch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, input), offsetof(ArgsType, mask), offsetof(ArgsType, output)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static MaskedFillType::PImplType MaskedFillAlgos[] = {
     tecoKernelMaskedFillFT32,
+    tecoKernelMaskedFillBroadcastFT32,
     // more branches
 };
 
 static const char *MaskedFillDiscription[] = {
     "tecoKernelMaskedFillFT32",
+    "tecoKernelMaskedFillBroadcastFT32",
     // more branches
 };
 
@@ -69,6 +80,20 @@ struct MaskedFillOp : public BaseOp<MaskedFillOp, MaskedFillType> {
 
     static const char *name() { return "masked fill"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        formatShapeDims(buf, size, arg->dimOutput, arg->dimLen);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // float or bfloat16 data, bool mask
+        uint64_t out = 1, mask = 1;
+        for (int i = 0; i < arg->dimLen; i++) {
+            out *= arg->dimOutput[i];
+            mask *= arg->dimMask[i];
+        }
+        *cost = {out * arg->dtype_size + mask, out * arg->dtype_size, 0};
+    }
+
     Status findImpl(const PatchType *args) {
         MaskedFillBranch branch = findMaskedFillBranch(args);
         if (branch == MaskedFillBranch::MASKED_FILL_END) {
@@ -76,9 +101,21 @@ struct MaskedFillOp : public BaseOp<MaskedFillOp, MaskedFillType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(MaskedFillAlgos[index], MaskedFillDiscription[index]);
+        setInstance(MaskedFillAlgos[index], MaskedFillDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_FLOAT) {
+            setInstance(tecoHostMaskedFillFT32, "tecoHostMaskedFillFT32");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16) {
+            setInstance(tecoHostMaskedFillBF16, "tecoHostMaskedFillBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -36,12 +36,13 @@ namespace ops {
 
 // Define a function to determine the best algorithm branch based on given arguments.
 MaskedSelectBranch findMaskedSelectBranch(const MaskedSelectPatchArgs *arg) {
-    if (arg->broadcast_flag == 0) {
-        if (arg->x_type == UALDataType::UAL_DTYPE_FLOAT ||
-            arg->x_type == UALDataType::UAL_DTYPE_INT32) {
-            if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+    if (arg->x_type == UALDataType::UAL_DTYPE_FLOAT ||
+        arg->x_type == UALDataType::UAL_DTYPE_INT32) {
+        if (common::isDefaultAlgo(arg->algo)) {
+            if (arg->broadcast_flag == 0) {
                 return MaskedSelectBranch::MASKED_SELECT_FLOAT;
             }
+            return MaskedSelectBranch::MASKED_SELECT_FLOAT_BROADCAST;
         }
     }
     // If none of the above conditions are met, indicating no specialized branch was found.
@@ -37,6 +37,7 @@ namespace ops {
 
 typedef enum class MaskedSelectBranch {
     MASKED_SELECT_FLOAT = 0,
+    MASKED_SELECT_FLOAT_BROADCAST = 1,
     // insert enum
     MASKED_SELECT_END
 } MaskedSelectBranch;
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/masked_select_args.h"
 #include "ual/com/def.h"
+#include "ual/host/masked_select.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/masked_select/find_masked_select.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::MaskedSelectArgs;
 using tecoal::ual::args::MaskedSelectPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,15 +50,25 @@ struct MaskedSelectType {
     using PatchType = MaskedSelectPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, input), offsetof(ArgsType, mask), offsetof(ArgsType, output),
+            offsetof(ArgsType, selectcount)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static MaskedSelectType::PImplType MaskedSelectAlgos[] = {
     tecoKernelMaskedSelectNobroadcast<int32_t, uint8_t>,
+    tecoKernelMaskedSelectBroadcast<int32_t, uint8_t>,
     // more branches
 };
 
 static const char *MaskedSelectDiscription[] = {
     "tecoKernelMaskedSelectNobroadcast<int32_t, uint8_t>",
+    "tecoKernelMaskedSelectBroadcast<int32_t, uint8_t>",
     // more branches
 };
 
@@ -69,6 +81,15 @@ struct MaskedSelectOp : public BaseOp<MaskedSelectOp, MaskedSelectType> {
 
     static const char *name() { return "masked_select"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "input=%d mask=%d", arg->input_len, arg->mask_len);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // float data, bool mask; the output size is data dependent and not counted
+        *cost = {(uint64_t)arg->input_len * sizeof(float) + arg->mask_len, 0, 0};
+    }
+
     Status findImpl(const PatchType *args) {
         MaskedSelectBranch branch = findMaskedSelectBranch(args);
         if (branch == MaskedSelectBranch::MASKED_SELECT_END) {
@@ -76,9 +97,18 @@ struct MaskedSelectOp : public BaseOp<MaskedSelectOp, MaskedSelectType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(MaskedSelectAlgos[index], MaskedSelectDiscription[index]);
+        setInstance(MaskedSelectAlgos[index], MaskedSelectDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->x_type == UALDataType::UAL_DTYPE_FLOAT ||
+            args->x_type == UALDataType::UAL_DTYPE_INT32) {
+            setInstance(tecoHostMaskedSelectB32, "tecoHostMaskedSelectB32");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
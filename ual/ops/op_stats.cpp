@@ -0,0 +1,145 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/ops/op_stats.h"
+#include <cstdlib>
+#include <cstring>
+#include "ual/com/log.h"
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+std::atomic<bool> OpStats::enabled_{false};
+
+void OpStats::loadEnv() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        const char *env = getenv("TECOAL_OP_STATS");
+        if (env != nullptr && strcmp(env, "0") != 0) setEnabled(true);
+    });
+}
+
+OpStats::~OpStats() {
+    settle(true);
+    for (sdaaEvent_t event : free_events_) sdaaEventDestroy(event);
+}
+
+OpStatsEntry *OpStats::count(const char *name, const char *discription, int algo,
+                             const OpCost &cost) {
+    auto it = index_.find(discription);
+    if (it == index_.end()) {
+        it = index_.emplace(discription, entries_.size()).first;
+        entries_.push_back({name, discription, algo, 0, 0, 0, 0, 0, 0});
+    }
+    OpStatsEntry *entry = &entries_[it->second];
+    entry->calls++;
+    entry->bytes_read += cost.bytes_read;
+    entry->bytes_written += cost.bytes_written;
+    entry->flops += cost.flops;
+    return entry;
+}
+
+void OpStats::addTime(OpStatsEntry *entry, uint64_t ns) {
+    entry->total_ns += ns;
+    if (ns > entry->max_ns) entry->max_ns = ns;
+}
+
+// Pending launches complete in stream order, so the first one not done ends the scan
+void OpStats::settle(bool wait) {
+    while (!pending_.empty()) {
+        Pending &p = pending_.front();
+        if (wait) {
+            sdaaEventSynchronize(p.end);
+        } else if (sdaaEventQuery(p.end) != sdaaSuccess) {
+            break;
+        }
+        float ms = 0;
+        if (p.generation == generation_ &&
+            sdaaEventElapsedTime(&ms, p.start, p.end) == sdaaSuccess) {
+            auto it = index_.find(p.discription);
+            if (it != index_.end()) addTime(&entries_[it->second], (uint64_t)(ms * 1e6));
+        }
+        free_events_.push_back(p.start);
+        free_events_.push_back(p.end);
+        pending_.pop_front();
+    }
+}
+
+void OpStats::record(const char *name, const char *discription, int algo, uint64_t ns,
+                     const OpCost &cost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    addTime(count(name, discription, algo, cost), ns);
+}
+
+void OpStats::takeEvents(sdaaEvent_t *start, sdaaEvent_t *end) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sdaaEvent_t *events[] = {start, end};
+    for (sdaaEvent_t *event : events) {
+        if (!free_events_.empty()) {
+            *event = free_events_.back();
+            free_events_.pop_back();
+        } else if (sdaaEventCreate(event) != sdaaSuccess) {
+            *event = nullptr;
+        }
+    }
+}
+
+void OpStats::releaseEvents(sdaaEvent_t start, sdaaEvent_t end) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (start != nullptr) free_events_.push_back(start);
+    if (end != nullptr) free_events_.push_back(end);
+}
+
+void OpStats::recordDevice(const char *name, const char *discription, int algo,
+                           sdaaEvent_t start, sdaaEvent_t end, const OpCost &cost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    count(name, discription, algo, cost);
+    pending_.push_back({discription, generation_, start, end});
+    // a loop that never reads its counters still keeps a bounded number of events alive
+    settle(false);
+    if (pending_.size() > OP_STATS_PENDING_MAX) {
+        DLOG("op stats wait for %zu device launches", pending_.size());
+        settle(true);
+    }
+}
+
+std::vector<OpStatsEntry> OpStats::collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    settle(true);
+    return entries_;
+}
+
+void OpStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    generation_++;
+}
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
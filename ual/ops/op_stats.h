@@ -0,0 +1,124 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_OP_STATS_H_
+#define UAL_OPS_OP_STATS_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ual/com/def.h"
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+#define OP_STATS_PENDING_MAX 1024  // device launches whose end event is not yet read
+
+// Traffic and work of one launch as derived from its args; 0 where an op does not model it.
+typedef struct OpCost {
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t flops;
+} OpCost;
+
+// Merged counters of one kernel variant.
+typedef struct OpStatsEntry {
+    const char *name;
+    const char *discription;
+    int algo;
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t flops;
+} OpStatsEntry;
+
+// Per-kernel counters of the launches made through one handle. Turning them on is process-wide
+// (tecoalSetOpStats or TECOAL_OP_STATS=1). A host kernel is timed as it returns. A device kernel
+// is bracketed by two events on its stream and counted at once; its time is added when the end
+// event has completed, which record calls check without waiting and collect() waits for. So the
+// counters never block a launch loop on the device.
+class OpStats {
+ public:
+    OpStats() = default;
+    ~OpStats();
+    OpStats(const OpStats &other) = delete;
+    OpStats &operator=(const OpStats &other) = delete;
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enable) { enabled_.store(enable, std::memory_order_relaxed); }
+    // Reads TECOAL_OP_STATS, once per process
+    static void loadEnv();
+
+    void record(const char *name, const char *discription, int algo, uint64_t ns,
+                const OpCost &cost);
+
+    // A pair of events to record around a device launch, handed back by recordDevice or
+    // releaseEvents.
+    void takeEvents(sdaaEvent_t *start, sdaaEvent_t *end);
+    void releaseEvents(sdaaEvent_t start, sdaaEvent_t end);
+    void recordDevice(const char *name, const char *discription, int algo, sdaaEvent_t start,
+                      sdaaEvent_t end, const OpCost &cost);
+
+    // Waits for the device launches counted so far
+    std::vector<OpStatsEntry> collect();
+    void reset();
+
+ private:
+    struct Pending {
+        const char *discription;
+        uint64_t generation;
+        sdaaEvent_t start;
+        sdaaEvent_t end;
+    };
+
+    // Callers hold mutex_
+    OpStatsEntry *count(const char *name, const char *discription, int algo, const OpCost &cost);
+    void addTime(OpStatsEntry *entry, uint64_t ns);
+    void settle(bool wait);
+
+    static std::atomic<bool> enabled_;
+    std::mutex mutex_;
+    std::vector<OpStatsEntry> entries_;
+    // Description strings are static, so their address identifies the kernel variant
+    std::unordered_map<const char *, size_t> index_;
+    std::deque<Pending> pending_;
+    std::vector<sdaaEvent_t> free_events_;
+    uint64_t generation_ = 0;  // bumped by reset(), drops the pending launches before it
+};
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_OP_STATS_H_
@@ -0,0 +1,122 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/ops/profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "ual/com/log.h"
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+std::atomic<bool> Profiler::enabled_{false};
+
+Profiler &Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() {
+    exit_path_ = getenv("TECOAL_PROFILE");
+    if (exit_path_ != nullptr) setEnabled(true);
+}
+
+Profiler::~Profiler() {
+    if (exit_path_ != nullptr) dump(exit_path_);
+    for (TraceBuffer *buffer : buffers_) delete buffer;
+}
+
+void formatShapeDims(char *buf, size_t size, const int *dims, int num) {
+    size_t len = snprintf(buf, size, "[");
+    for (int i = 0; i < num && len < size; i++) {
+        len += snprintf(buf + len, size - len, i == 0 ? "%d" : ",%d", dims[i]);
+    }
+    if (len < size) snprintf(buf + len, size - len, "]");
+}
+
+uint64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+TraceBuffer *Profiler::threadBuffer() {
+    static thread_local TraceBuffer *buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer = new TraceBuffer();
+        buffer->tid = (uint32_t)buffers_.size();
+        buffers_.push_back(buffer);
+    }
+    return buffer;
+}
+
+void Profiler::record(const TraceRecord &record) {
+    TraceBuffer *buffer = threadBuffer();
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    TraceRecord &slot = buffer->records[head % TRACE_BUFFER_SIZE];
+    slot = record;
+    slot.tid = buffer->tid;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+Status Profiler::dump(const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (fp == nullptr) {
+        ERROR("can not open trace file %s", path);
+        return Status::BAD_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const char *sep = "";
+    fprintf(fp, "{\"traceEvents\":[");
+    for (TraceBuffer *buffer : buffers_) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > TRACE_BUFFER_SIZE ? head - TRACE_BUFFER_SIZE : 0;
+        for (uint64_t i = begin; i < head; i++) {
+            const TraceRecord &r = buffer->records[i % TRACE_BUFFER_SIZE];
+            fprintf(fp,
+                    "%s\n{\"name\":\"%s\",\"cat\":\"tecoal\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,"
+                    "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"kernel\":\"%s\",\"algo\":%d,"
+                    "\"shape\":\"%s\"}}",
+                    sep, r.name, r.tid, r.start_ns / 1e3, (r.end_ns - r.start_ns) / 1e3,
+                    r.discription, r.algo, r.shape);
+            sep = ",";
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    if (fclose(fp) != 0) {
+        ERROR("can not write trace file %s", path);
+        return Status::BAD_PARAMETER;
+    }
+    return Status::SUCCESS;
+}
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
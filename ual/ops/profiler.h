@@ -0,0 +1,98 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_PROFILER_H_
+#define UAL_OPS_PROFILER_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "ual/com/def.h"
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+#define TRACE_SHAPE_LEN 64
+#define TRACE_BUFFER_SIZE 16384  // records kept per thread, older ones are overwritten
+
+typedef struct TraceRecord {
+    const char *name;
+    const char *discription;
+    int algo;
+    uint32_t tid;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    char shape[TRACE_SHAPE_LEN];
+} TraceRecord;
+
+// Writes dims as "[d0,d1,...]", truncated to size
+void formatShapeDims(char *buf, size_t size, const int *dims, int num);
+
+// Ring of one thread. Only the owner writes; it publishes a record by bumping head.
+struct TraceBuffer {
+    uint32_t tid;
+    std::atomic<uint64_t> head{0};
+    TraceRecord records[TRACE_BUFFER_SIZE];
+};
+
+// Opt-in tracing of every kernel launched through BaseOp::run. When disabled the only cost is
+// one relaxed load in run(); when enabled run() waits for the kernel so the record carries its
+// real duration. Enable with tecoalSetProfiling or TECOAL_PROFILE=<trace.json>, the latter
+// also dumps the trace at exit.
+class Profiler {
+ public:
+    static Profiler &instance();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enable) { enabled_.store(enable, std::memory_order_relaxed); }
+    static uint64_t now();
+
+    void record(const TraceRecord &record);
+
+    // Chrome trace JSON, loadable by chrome://tracing and Perfetto. Records written while the
+    // dump runs may be torn, so dump from a quiet point.
+    Status dump(const char *path);
+
+ private:
+    Profiler();
+    ~Profiler();
+    TraceBuffer *threadBuffer();
+
+    static std::atomic<bool> enabled_;
+    std::mutex mutex_;  // guards buffers_, taken once per thread
+    std::vector<TraceBuffer *> buffers_;
+    const char *exit_path_ = nullptr;
+};
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_PROFILER_H_
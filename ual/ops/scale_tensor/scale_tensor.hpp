@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/scale_tensor_args.h"
 #include "ual/com/def.h"
+#include "ual/host/scale_tensor.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/scale_tensor/find_scale_tensor.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::ScaleTensorArgs;
 using tecoal::ual::args::ScaleTensorPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,12 @@ struct ScaleTensorType {
     using PatchType = ScaleTensorPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, y)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ScaleTensorType::PImplType ScaleTensorAlgos[] = {
@@ -69,6 +77,15 @@ struct ScaleTensorOp : public BaseOp<ScaleTensorOp, ScaleTensorType> {
 
     static const char *name() { return "scale_tensor"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "rows=%d n=%d", arg->row_num, arg->data_num);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t n = (uint64_t)arg->row_num * arg->data_num;
+        *cost = {n * arg->dtype_size, n * arg->dtype_size, n};
+    }
+
     Status findImpl(const PatchType *args) {
         ScaleTensorBranch branch = findScaleTensorBranch(args);
         if (branch == ScaleTensorBranch::SCALE_TENSOR_END) {
@@ -76,9 +93,21 @@ struct ScaleTensorOp : public BaseOp<ScaleTensorOp, ScaleTensorType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ScaleTensorAlgos[index], ScaleTensorDiscription[index]);
+        setInstance(ScaleTensorAlgos[index], ScaleTensorDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_FLOAT) {
+            setInstance(tecoHostScaleTensorFT32, "tecoHostScaleTensorFT32");
+            return Status::SUCCESS;
+        }
+        if (args->data_type == UALDataType::UAL_DTYPE_BFLOAT16) {
+            setInstance(tecoHostScaleTensorBF16, "tecoHostScaleTensorBF16");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -37,23 +37,23 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 ScatterNdAddBranch findScatterNdAddBranch(const ScatterNdAddPatchArgs *arg) {
     if (arg->x_data_type == UALDataType::UAL_DTYPE_FLOAT) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterNdAddBranch::SCATTER_ND_ADD_INDEX_INT32_FLOAT;
         }
     } else if (arg->x_data_type == UALDataType::UAL_DTYPE_HALF) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterNdAddBranch::SCATTER_ND_ADD_INDEX_INT32_HALF;
         }
     } else if (arg->x_data_type == UALDataType::UAL_DTYPE_INT32) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterNdAddBranch::SCATTER_ND_ADD_INDEX_INT32_INT32;
         }
     } else if (arg->x_data_type == UALDataType::UAL_DTYPE_DOUBLE) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterNdAddBranch::SCATTER_ND_ADD_INDEX_INT32_DOUBLE;
         }
     } else if (arg->x_data_type == UALDataType::UAL_DTYPE_INT64) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterNdAddBranch::SCATTER_ND_ADD_INDEX_INT32_INT64;
         }
     }
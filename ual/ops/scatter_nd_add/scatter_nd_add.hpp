@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/scatter_nd_add_args.h"
 #include "ual/com/def.h"
+#include "ual/host/scatter_nd_add.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/scatter_nd_add/find_scatter_nd_add.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::ScatterNdAddArgs;
 using tecoal::ual::args::ScatterNdAddPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,14 @@ struct ScatterNdAddType {
     using PatchType = ScatterNdAddPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, x), offsetof(ArgsType, index), offsetof(ArgsType, updates),
+            offsetof(ArgsType, out)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ScatterNdAddType::PImplType ScatterNdAddAlgos[] = {
@@ -73,6 +83,11 @@ struct ScatterNdAddOp : public BaseOp<ScatterNdAddOp, ScatterNdAddType> {
 
     static const char *name() { return "scatter_nd_add"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "x=%dx%d index=%dx%d", arg->dim_x[0], arg->dim_x[1], arg->dim_index[0],
+                 arg->dim_index[1]);
+    }
+
     Status findImpl(const PatchType *args) {
         ScatterNdAddBranch branch = findScatterNdAddBranch(args);
         if (branch == ScatterNdAddBranch::SCATTER_ND_ADD_END) {
@@ -80,9 +95,34 @@ struct ScatterNdAddOp : public BaseOp<ScatterNdAddOp, ScatterNdAddType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ScatterNdAddAlgos[index], ScatterNdAddDiscription[index]);
+        setInstance(ScatterNdAddAlgos[index], ScatterNdAddDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        switch (args->x_data_type) {
+            case UALDataType::UAL_DTYPE_FLOAT:
+                setInstance(tecoHostScatterNdAddIndex32<float>,
+                            "tecoHostScatterNdAddIndex32<float>");
+                return Status::SUCCESS;
+            case UALDataType::UAL_DTYPE_HALF:
+                setInstance(tecoHostScatterNdAddIndex32<half_float::half>,
+                            "tecoHostScatterNdAddIndex32<half>");
+                return Status::SUCCESS;
+            case UALDataType::UAL_DTYPE_INT32:
+                setInstance(tecoHostScatterNdAddIndex32<int>, "tecoHostScatterNdAddIndex32<int>");
+                return Status::SUCCESS;
+            case UALDataType::UAL_DTYPE_DOUBLE:
+                setInstance(tecoHostScatterNdAddIndex32<double>,
+                            "tecoHostScatterNdAddIndex32<double>");
+                return Status::SUCCESS;
+            case UALDataType::UAL_DTYPE_INT64:
+                setInstance(tecoHostScatterNdAddIndex32<int64_t>,
+                            "tecoHostScatterNdAddIndex32<int64_t>");
+                return Status::SUCCESS;
+            default: return Status::NOT_SUPPORTED;
+        }
+    }
 };
 }  // namespace ops
 }  // namespace ual
@@ -37,7 +37,7 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 ScatterOutBranch findScatterOutBranch(const ScatterOutPatchArgs *arg) {
     if (arg->data_type == (UALDataType::UAL_DTYPE_FLOAT)) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return ScatterOutBranch::SCATTER_OUT_FLOAT;
         }
     }
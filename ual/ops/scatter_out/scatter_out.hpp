@@ -29,8 +29,10 @@
 
 #include "ual/kernel/scatter_out/scatter_out.h"
 #include "ual/com/log.h"
+#include "ual/com/convert.hpp"
 #include "ual/args/scatter_out_args.h"
 #include "ual/com/def.h"
+#include "ual/host/scatter_out.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/scatter_out/find_scatter_out.h"
 
@@ -38,6 +40,7 @@ using tecoal::ual::args::ScatterOutArgs;
 using tecoal::ual::args::ScatterOutPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +51,13 @@ struct ScatterOutType {
     using PatchType = ScatterOutPatchArgs;  // using patch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, input), offsetof(ArgsType, index), offsetof(ArgsType, output)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static ScatterOutType::PImplType ScatterOutAlgos[] = {
@@ -69,6 +79,19 @@ struct ScatterOutOp : public BaseOp<ScatterOutOp, ScatterOutType> {
 
     static const char *name() { return "scatter_out"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        formatShapeDims(buf, size, arg->dim_output, arg->dim_ln);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        uint64_t n = 1;
+        for (int i = 0; i < arg->dim_ln; i++) n *= arg->dim_index[i];
+        uint64_t size = convertDataTypeSize((UALDataType)arg->data_type);
+        cost->bytes_read = n * sizeof(int) + (arg->is_scalar ? 0 : n * size);
+        cost->bytes_written = n * size;
+        cost->flops = 0;
+    }
+
     Status findImpl(const PatchType *args) {
         ScatterOutBranch branch = findScatterOutBranch(args);
         if (branch == ScatterOutBranch::SCATTER_OUT_END) {
@@ -76,9 +99,17 @@ struct ScatterOutOp : public BaseOp<ScatterOutOp, ScatterOutType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(ScatterOutAlgos[index], ScatterOutDiscription[index]);
+        setInstance(ScatterOutAlgos[index], ScatterOutDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_FLOAT) {
+            setInstance(tecoHostScatterOutFT32, "tecoHostScatterOutFT32");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
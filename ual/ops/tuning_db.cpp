@@ -0,0 +1,193 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#include "ual/ops/tuning_db.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "ual/com/log.h"
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+static bool recordLess(const TuningRecord &a, uint64_t key) { return a.key < key; }
+
+TuningDatabase &TuningDatabase::instance() {
+    static TuningDatabase db;
+    return db;
+}
+
+TuningDatabase::~TuningDatabase() { release(table_.load(std::memory_order_acquire)); }
+
+TuningDatabase::ReadScope::ReadScope(const TuningDatabase &db) {
+    // Recheck the epoch after counting in, so a reader never lands in a slot that publish()
+    // has already stopped waiting on
+    for (;;) {
+        uint64_t epoch = db.epoch_.load();
+        slot_ = &db.readers_[epoch & 1];
+        slot_->fetch_add(1);
+        if (db.epoch_.load() == epoch) break;
+        slot_->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void TuningDatabase::release(const Table *table) {
+    if (table == nullptr) return;
+    if (table->map != nullptr) munmap(table->map, table->map_size);
+    delete table;
+}
+
+bool TuningDatabase::lookup(uint64_t key, TuningRecord *record) const {
+    ReadScope scope(*this);
+    const Table *table = table_.load();
+    if (table == nullptr) return false;
+    const TuningRecord *end = table->records + table->count;
+    const TuningRecord *it = std::lower_bound(table->records, end, key, recordLess);
+    if (it == end || it->key != key) return false;
+    *record = *it;
+    return true;
+}
+
+// Callers hold mutex_
+void TuningDatabase::publish(Table *table) {
+    const Table *old = table_.exchange(table);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+
+    // Readers that may hold old all counted in before the exchange, so in the current epoch's
+    // slot; later readers count in the next epoch's and only ever see the new table
+    uint64_t epoch = epoch_.fetch_add(1);
+    while (readers_[epoch & 1].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    release(old);
+}
+
+void TuningDatabase::update(const TuningRecord &record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Table *old = table_.load(std::memory_order_relaxed);
+
+    Table *table = new Table();
+    if (old != nullptr) table->owned.assign(old->records, old->records + old->count);
+    auto it = std::lower_bound(table->owned.begin(), table->owned.end(), record.key, recordLess);
+    if (it != table->owned.end() && it->key == record.key) {
+        *it = record;
+    } else {
+        table->owned.insert(it, record);
+    }
+    table->records = table->owned.data();
+    table->count = table->owned.size();
+    publish(table);
+}
+
+Status TuningDatabase::load(const char *path) {
+    if (path == nullptr) return Status::BAD_PARAMETER;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ERROR("can not open tuning database %s", path);
+        return Status::BAD_PARAMETER;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TuningDBHeader)) {
+        close(fd);
+        ERROR("tuning database %s is truncated", path);
+        return Status::BAD_PARAMETER;
+    }
+    size_t map_size = (size_t)st.st_size;
+    void *map = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        ERROR("can not map tuning database %s", path);
+        return Status::BAD_PARAMETER;
+    }
+
+    // Reject anything written by another layout rather than guessing at it
+    const TuningDBHeader *header = reinterpret_cast<const TuningDBHeader *>(map);
+    const TuningRecord *records = reinterpret_cast<const TuningRecord *>(header + 1);
+    bool valid = memcmp(header->magic, TUNING_DB_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == TUNING_DB_VERSION &&
+                 header->record_size == sizeof(TuningRecord) &&
+                 header->count == (map_size - sizeof(TuningDBHeader)) / sizeof(TuningRecord) &&
+                 (map_size - sizeof(TuningDBHeader)) % sizeof(TuningRecord) == 0;
+    for (uint64_t i = 1; valid && i < header->count; i++) {
+        valid = records[i - 1].key < records[i].key;
+    }
+    if (!valid) {
+        munmap(map, map_size);
+        ERROR("tuning database %s has a bad header or unsorted records", path);
+        return Status::BAD_PARAMETER;
+    }
+
+    Table *table = new Table();
+    table->records = records;
+    table->count = header->count;
+    table->map = map;
+    table->map_size = map_size;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    publish(table);
+    return Status::SUCCESS;
+}
+
+Status TuningDatabase::save(const char *path) const {
+    if (path == nullptr) return Status::BAD_PARAMETER;
+    ReadScope scope(*this);
+    const Table *table = table_.load();
+
+    TuningDBHeader header;
+    memcpy(header.magic, TUNING_DB_MAGIC, sizeof(header.magic));
+    header.version = TUNING_DB_VERSION;
+    header.record_size = sizeof(TuningRecord);
+    header.count = table == nullptr ? 0 : table->count;
+
+    // Write beside the target and rename, so a process mapping the old file never sees a
+    // half-written one
+    std::string tmp_path = std::string(path) + ".tmp";
+    FILE *fp = fopen(tmp_path.c_str(), "wb");
+    if (fp == nullptr) {
+        ERROR("can not create tuning database %s", tmp_path.c_str());
+        return Status::BAD_PARAMETER;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    if (ok && header.count > 0) {
+        ok = fwrite(table->records, sizeof(TuningRecord), header.count, fp) == header.count;
+    }
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmp_path.c_str(), path) != 0) {
+        unlink(tmp_path.c_str());
+        ERROR("can not write tuning database %s", path);
+        return Status::BAD_PARAMETER;
+    }
+    return Status::SUCCESS;
+}
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
@@ -0,0 +1,138 @@
+// BSD 3- Clause License Copyright (c) 2024, Tecorigin Co., Ltd. All rights
+// reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+// Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY
+// WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+// OF SUCH DAMAGE.
+
+#ifndef UAL_OPS_TUNING_DB_H_
+#define UAL_OPS_TUNING_DB_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "ual/com/def.h"
+
+using namespace tecoal::ual::common;
+
+namespace tecoal {
+namespace ual {
+namespace ops {
+
+#define TUNING_DB_MAGIC "TECOALDB"
+#define TUNING_DB_VERSION 1
+
+// File layout: one TuningDBHeader followed by `count` TuningRecords sorted by key. The file is
+// mapped read-only as is, so both structs are fixed size and 8-byte aligned.
+typedef struct TuningDBHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+} TuningDBHeader;
+
+// What find() should pick for one problem. Tile fields are 0 for ops without tiles.
+typedef struct TuningRecord {
+    uint64_t key;
+    int32_t algo;
+    int32_t bM;
+    int32_t bN;
+    int32_t bK;
+} TuningRecord;
+
+// Shape signature of a problem. Unlike the handle's dispatch key it hashes the op name itself
+// rather than its address, so the value is stable across processes and builds.
+struct TuningKey {
+ public:
+    explicit TuningKey(const char *op_name) {
+        for (const char *p = op_name; *p != '\0'; p++) mix((uint8_t)*p);
+    }
+
+    void add(int64_t value) {
+        for (int i = 0; i < 8; i++) mix((uint8_t)(value >> (i * 8)));
+    }
+
+    uint64_t value() const { return hash_; }
+
+ private:
+    void mix(uint8_t byte) { hash_ = (hash_ ^ byte) * 0x100000001b3ULL; }
+
+    uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+// Process-wide table of tuned choices, consulted by the find*Branch functions. Readers only
+// load an immutable table through an atomic pointer, so lookups never lock. Updates copy the
+// table and publish the copy; the superseded table, and the file it maps, is released once
+// every reader that could still be walking it has left (see ReadScope).
+class TuningDatabase {
+ public:
+    static TuningDatabase &instance();
+
+    bool lookup(uint64_t key, TuningRecord *record) const;
+    void update(const TuningRecord &record);
+
+    // load() maps the file and replaces the whole table; save() writes a snapshot.
+    Status load(const char *path);
+    Status save(const char *path) const;
+
+    // Bumped on every change, so memoized find() results can tell they went stale.
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+ private:
+    struct Table {
+        const TuningRecord *records = nullptr;
+        uint64_t count = 0;
+        std::vector<TuningRecord> owned;
+        void *map = nullptr;
+        size_t map_size = 0;
+    };
+
+    // Marks a reader of the current table. A reader counts itself in the slot of the epoch it
+    // entered; publish() advances the epoch and waits for the old slot to drain, after which
+    // no reader can hold the superseded table.
+    class ReadScope {
+     public:
+        explicit ReadScope(const TuningDatabase &db);
+        ~ReadScope() { slot_->fetch_sub(1, std::memory_order_release); }
+
+     private:
+        std::atomic<int64_t> *slot_;
+    };
+
+    TuningDatabase() = default;
+    ~TuningDatabase();
+    void publish(Table *table);
+    static void release(const Table *table);
+
+    std::atomic<const Table *> table_{nullptr};
+    std::atomic<uint64_t> generation_{0};
+    std::mutex mutex_;
+    std::atomic<uint64_t> epoch_{0};
+    mutable std::atomic<int64_t> readers_[2] = {{0}, {0}};
+};
+
+}  // namespace ops
+}  // namespace ual
+}  // namespace tecoal
+
+#endif  // UAL_OPS_TUNING_DB_H_
@@ -38,7 +38,7 @@ UnaryOpsBranch findUnaryOpsBranch(const UnaryOpsPatchArgs *arg) {
     if (arg->x_data_type == UALDataType::UAL_DTYPE_FLOAT &&
         arg->y_data_type == UALDataType::UAL_DTYPE_FLOAT) {
         if (arg->mode == 13 || arg->mode == 11) {
-            if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+            if (common::isDefaultAlgo(arg->algo)) {
                 return UnaryOpsBranch::UNARY_OPS_FLOAT;
             }
         }
@@ -46,7 +46,7 @@ UnaryOpsBranch findUnaryOpsBranch(const UnaryOpsPatchArgs *arg) {
     else if (arg->x_data_type == UALDataType::UAL_DTYPE_INT32 &&
         arg->y_data_type == UALDataType::UAL_DTYPE_INT32) {
         if (arg->mode == 13 || arg->mode == 11) {
-            if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+            if (common::isDefaultAlgo(arg->algo)) {
                 return UnaryOpsBranch::UNARY_OPS_INT32;
             }
         }
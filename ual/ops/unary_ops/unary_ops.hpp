@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/unary_ops_args.h"
 #include "ual/com/def.h"
+#include "ual/host/unary_ops.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/unary_ops/find_unary_ops.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::UnaryOpsArgs;
 using tecoal::ual::args::UnaryOpsPatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,12 @@ struct UnaryOpsType {
     using PatchType = UnaryOpsPatchArgs;  // using dispatch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {offsetof(ArgsType, x), offsetof(ArgsType, y)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static UnaryOpsType::PImplType UnaryOpsAlgos[] = {
@@ -71,6 +79,16 @@ struct UnaryOpsOp : public BaseOp<UnaryOpsOp, UnaryOpsType> {
 
     static const char *name() { return "UnaryOps"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "n=%d", arg->n);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // float32 and int32 kernels alike
+        uint64_t n = arg->n;
+        *cost = {n * 4, n * 4, n};
+    }
+
     Status findImpl(const PatchType *args) {
         UnaryOpsBranch branch = findUnaryOpsBranch(args);
         if (branch == UnaryOpsBranch::UNARY_OPS_END) {
@@ -78,9 +96,27 @@ struct UnaryOpsOp : public BaseOp<UnaryOpsOp, UnaryOpsType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(UnaryOpsAlgos[index], UnaryOpsDiscription[index]);
+        setInstance(UnaryOpsAlgos[index], UnaryOpsDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->mode != UALUnaryOpsMode::UAL_BATCH_ADD_A &&
+            args->mode != UALUnaryOpsMode::UAL_BATCH_MUL_A) {
+            return Status::NOT_SUPPORTED;
+        }
+        if (args->x_data_type == UALDataType::UAL_DTYPE_FLOAT &&
+            args->y_data_type == UALDataType::UAL_DTYPE_FLOAT) {
+            setInstance(tecoHostUnaryOpsWithAlphaFT32, "tecoHostUnaryOpsWithAlphaFT32");
+            return Status::SUCCESS;
+        }
+        if (args->x_data_type == UALDataType::UAL_DTYPE_INT32 &&
+            args->y_data_type == UALDataType::UAL_DTYPE_INT32) {
+            setInstance(tecoHostUnaryOpsWithAlphaINT32, "tecoHostUnaryOpsWithAlphaINT32");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual
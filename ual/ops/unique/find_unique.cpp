@@ -37,7 +37,7 @@ namespace ops {
 // Define a function to determine the best algorithm branch based on given arguments.
 UniqueBranch findUniqueBranch(const UniquePatchArgs *arg) {
     if (arg->data_type == (UALDataType::UAL_DTYPE_INT64)) {
-        if (arg->algo == UALAlgoType::UAL_ALGO_0) {
+        if (common::isDefaultAlgo(arg->algo)) {
             return UniqueBranch::UNIQUE_INT64;
         }
     }
@@ -31,6 +31,7 @@
 #include "ual/com/log.h"
 #include "ual/args/unique_args.h"
 #include "ual/com/def.h"
+#include "ual/host/unique.h"
 #include "ual/ops/base_op.hpp"
 #include "ual/ops/unique/find_unique.h"
 
@@ -38,6 +39,7 @@ using tecoal::ual::args::UniqueArgs;
 using tecoal::ual::args::UniquePatchArgs;
 using namespace tecoal::ual::common;
 using namespace tecoal::ual::kernel;
+using namespace tecoal::ual::host;
 
 namespace tecoal {
 namespace ual {
@@ -48,6 +50,14 @@ struct UniqueType {
     using PatchType = UniquePatchArgs;  // using dispatch args
     using RetType = void;
     using PImplType = void (*)(ArgsType);
+
+    static const size_t *pointers(int *count) {
+        static const size_t offsets[] = {
+            offsetof(ArgsType, x), offsetof(ArgsType, y), offsetof(ArgsType, inverse),
+            offsetof(ArgsType, counts), offsetof(ArgsType, out_size)};
+        *count = sizeof(offsets) / sizeof(offsets[0]);
+        return offsets;
+    }
 };
 
 static UniqueType::PImplType UniqueAlgos[] = {
@@ -69,6 +79,15 @@ struct UniqueOp : public BaseOp<UniqueOp, UniqueType> {
 
     static const char *name() { return "Unique"; }
 
+    static void shapeImpl(const ArgsType *arg, char *buf, size_t size) {
+        snprintf(buf, size, "n=%d", arg->data_len);
+    }
+
+    static void costImpl(const ArgsType *arg, OpCost *cost) {
+        // the output size is data dependent and not counted
+        *cost = {(uint64_t)arg->data_len * sizeof(int64_t), 0, 0};
+    }
+
     Status findImpl(const PatchType *args) {
         UniqueBranch branch = findUniqueBranch(args);
         if (branch == UniqueBranch::UNIQUE_END) {
@@ -76,9 +95,17 @@ struct UniqueOp : public BaseOp<UniqueOp, UniqueType> {
             return Status::NOT_IMPLEMENTED;
         }
         int index = static_cast<int>(branch);
-        setInstance(UniqueAlgos[index], UniqueDiscription[index]);
+        setInstance(UniqueAlgos[index], UniqueDiscription[index], index);
         return Status::SUCCESS;
     }
+
+    Status findHostImpl(const PatchType *args) {
+        if (args->data_type == UALDataType::UAL_DTYPE_INT64) {
+            setInstance(tecoHostUniqueSortedInt64, "tecoHostUniqueSortedInt64");
+            return Status::SUCCESS;
+        }
+        return Status::NOT_SUPPORTED;
+    }
 };
 }  // namespace ops
 }  // namespace ual